@@ -0,0 +1,394 @@
+/*
+ * File: bench/db_stress.c
+ * Path: SchoolRecordSystem/bench/db_stress.c
+ * Description: Concurrency stress test: reader threads and a writer on one database
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Usage: db_stress [--readers N] [--reporters N] [--students N] [--seconds S] [--seed N]
+ *
+ * Reader threads run lookups, statistics, name searches and rank queries
+ * under the read lock and check that every answer is consistent with the
+ * database they saw. Reporter threads open snapshots and read them twice,
+ * slowly, without holding the lock: both passes must match the database
+ * at the moment the snapshot was opened. One writer thread adds, modifies
+ * and removes students under the write lock the whole time. Prints a JSON
+ * summary; exits nonzero if any check failed or the writer was starved.
+ */
+
+#include "student.h"
+#include "calculations.h"
+#include "logger.h"
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STRESS_MAX_READERS 64
+#define STRESS_MAX_REPORTERS 8
+#define STRESS_SEARCH_RESULTS 32
+#define DEFAULT_SEED 20250720ULL
+
+typedef struct {
+    int readers;
+    int reporters;
+    int students;
+    double seconds;
+    unsigned long long seed;
+} StressOptions;
+
+typedef struct {
+    StudentDatabase *db;
+    const StressOptions *options;
+    uint64_t random_state;
+    long operations;
+    long violations;
+    long records;                        // Snapshot records read (reporters)
+} StressThread;
+
+static atomic_bool stop_requested;
+
+/* ============================================================================
+ * HELPERS
+ * ============================================================================ */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// splitmix64, as in srs_bench
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int random_below(uint64_t *state, int bound) {
+    return (int)(next_random(state) % (uint64_t)bound);
+}
+
+// Letters-only name derived from the roll number
+static void stress_name(int roll_number, char *buffer, size_t size) {
+    char suffix[5];
+    for (int i = 0; i < 4; i++) {
+        suffix[i] = (char)('a' + (roll_number >> (5 * i)) % 26);
+    }
+    suffix[4] = '\0';
+    snprintf(buffer, size, "Stress Student %s", suffix);
+}
+
+static void report_violation(StressThread *thread, const char *what) {
+    if (thread->violations++ < 5) {
+        fprintf(stderr, "violation: %s\n", what);
+    }
+}
+
+/* ============================================================================
+ * THREADS
+ * ============================================================================ */
+
+/**
+ * One read-side check; the database must not change between the
+ * reads it compares
+ */
+static void check_once(StressThread *thread) {
+    StudentDatabase *db = thread->db;
+    int roll_range = thread->options->students * 2;
+    int roll_number = 1 + random_below(&thread->random_state, roll_range);
+
+    // Fuzzy search scores every candidate, so it runs far less often
+    int check = random_below(&thread->random_state, 4);
+    if (random_below(&thread->random_state, 64) == 0) check = 4;
+
+    switch (check) {
+        case 0: {
+            Student *student = find_student(db, roll_number);
+            if (student && (student->roll_number != roll_number || !student->is_active)) {
+                report_violation(thread, "find_student returned the wrong record");
+            }
+            break;
+        }
+
+        case 1: {
+            StatisticsSummary summary = compute_statistics_summary(db);
+            if (summary.count != db->count ||
+                summary.passed_students + summary.failed_students != summary.count ||
+                rank_tree_size(&db->marks_tree) != db->count) {
+                report_violation(thread, "statistics disagree with the record count");
+            }
+            break;
+        }
+
+        case 2: {
+            Student *matches[STRESS_SEARCH_RESULTS];
+            int found = search_students_by_name(db, "stress", NAME_SEARCH_PREFIX,
+                                                matches, STRESS_SEARCH_RESULTS);
+            for (int i = 0; i < found; i++) {
+                if (!matches[i] || strncmp(matches[i]->name, "Stress", 6) != 0 ||
+                    find_student(db, matches[i]->roll_number) != matches[i]) {
+                    report_violation(thread, "name search returned a stale record");
+                    break;
+                }
+            }
+            break;
+        }
+
+        case 4: {
+            FuzzyNameMatch matches[STRESS_SEARCH_RESULTS];
+            int found = fuzzy_search_students_by_name(db, "strss studnt", -1,
+                                                      matches, STRESS_SEARCH_RESULTS);
+            for (int i = 0; i < found; i++) {
+                Student *student = matches[i].student;
+                if (!student || find_student(db, student->roll_number) != student) {
+                    report_violation(thread, "fuzzy search returned a stale record");
+                    break;
+                }
+            }
+            break;
+        }
+
+        default: {
+            int rank = get_student_rank_by_marks(db, roll_number);
+            bool present = find_student(db, roll_number) != NULL;
+            if (present != (rank > 0) || rank > db->count) {
+                report_violation(thread, "rank disagrees with the records");
+            }
+            break;
+        }
+    }
+}
+
+static void* reader_main(void *argument) {
+    StressThread *thread = argument;
+
+    while (!atomic_load_explicit(&stop_requested, memory_order_relaxed)) {
+        read_lock_database(thread->db);
+        check_once(thread);
+        read_unlock_database(thread->db);
+        thread->operations++;
+    }
+    return NULL;
+}
+
+// What one pass over a snapshot saw
+typedef struct {
+    const StressThread *thread;
+    unsigned char *seen;                 // One flag per possible roll number
+    int count;
+    double sum_marks;
+    uint64_t checksum;
+    bool duplicate;
+    bool inactive;
+} SnapshotPass;
+
+static bool check_snapshot_record(const Student *student, int position, void *context) {
+    SnapshotPass *pass = context;
+    int roll_range = pass->thread->options->students * 2;
+
+    if (!student->is_active) pass->inactive = true;
+    if (student->roll_number < 1 || student->roll_number > roll_range ||
+        pass->seen[student->roll_number]) {
+        pass->duplicate = true;
+    } else {
+        pass->seen[student->roll_number] = 1;
+    }
+
+    pass->count++;
+    pass->sum_marks += student->marks;
+    pass->checksum = pass->checksum * 31 + (uint64_t)student->roll_number * 1000003u +
+                     (uint64_t)(student->marks * 100.0f) + (uint64_t)position;
+
+    // Stretch the pass so the writer changes plenty of chunks meanwhile
+    if (position % SNAPSHOT_CHUNK_RECORDS == 0) {
+        sched_yield();
+    }
+    return true;
+}
+
+static void read_snapshot_pass(StressThread *thread, const Snapshot *snapshot, SnapshotPass *pass) {
+    int roll_range = thread->options->students * 2;
+    memset(pass, 0, sizeof(*pass));
+    pass->thread = thread;
+    pass->seen = calloc((size_t)roll_range + 1, 1);
+    visit_student_snapshot(thread->db, snapshot, check_snapshot_record, pass);
+    free(pass->seen);
+    thread->records += pass->count;
+}
+
+/**
+ * Open a snapshot, note what the database held at that moment, then read
+ * the snapshot twice without the lock while the writer keeps going
+ */
+static void* reporter_main(void *argument) {
+    StressThread *thread = argument;
+    StudentDatabase *db = thread->db;
+
+    while (!atomic_load_explicit(&stop_requested, memory_order_relaxed)) {
+        // The store-level open lets the expected totals be read under the same lock
+        read_lock_database(db);
+        Snapshot *snapshot = snapshot_store_open(&db->snapshots, db->count);
+        int expected_count = db->count;
+        double expected_sum = db->aggregates.sum_marks;
+        read_unlock_database(db);
+
+        SnapshotPass first;
+        SnapshotPass second;
+        read_snapshot_pass(thread, snapshot, &first);
+        read_snapshot_pass(thread, snapshot, &second);
+        close_student_snapshot(db, snapshot);
+
+        if (first.count != expected_count || fabs(first.sum_marks - expected_sum) > 0.01) {
+            report_violation(thread, "snapshot differs from the database it was opened on");
+        } else if (first.duplicate || first.inactive) {
+            report_violation(thread, "snapshot holds a torn or duplicated record");
+        } else if (second.count != first.count || second.checksum != first.checksum) {
+            report_violation(thread, "snapshot changed between two reads");
+        }
+        thread->operations++;
+    }
+    return NULL;
+}
+
+static void* writer_main(void *argument) {
+    StressThread *thread = argument;
+    StudentDatabase *db = thread->db;
+    int roll_range = thread->options->students * 2;
+    char name[MAX_NAME_LENGTH];
+
+    while (!atomic_load_explicit(&stop_requested, memory_order_relaxed)) {
+        int roll_number = 1 + random_below(&thread->random_state, roll_range);
+        float marks = (float)random_below(&thread->random_state, 10001) / 100.0f;
+        stress_name(roll_number, name, sizeof(name));
+
+        write_lock_database(db);
+        if (!find_student(db, roll_number)) {
+            add_student(db, name, roll_number, marks);
+        } else if (random_below(&thread->random_state, 2) == 0) {
+            modify_student(db, roll_number, name, marks);
+        } else {
+            remove_student(db, roll_number);
+        }
+        write_unlock_database(db);
+        thread->operations++;
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================ */
+
+static bool parse_options(int argc, char *argv[], StressOptions *options) {
+    options->readers = 4;
+    options->reporters = 1;
+    options->students = 10000;
+    options->seconds = 3.0;
+    options->seed = DEFAULT_SEED;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) return false;
+        if (strcmp(argv[i], "--readers") == 0) {
+            options->readers = atoi(value);
+        } else if (strcmp(argv[i], "--reporters") == 0) {
+            options->reporters = atoi(value);
+        } else if (strcmp(argv[i], "--students") == 0) {
+            options->students = atoi(value);
+        } else if (strcmp(argv[i], "--seconds") == 0) {
+            options->seconds = atof(value);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            options->seed = strtoull(value, NULL, 10);
+        } else {
+            return false;
+        }
+        i++;
+    }
+
+    // Roll numbers go up to twice the population, which must stay valid
+    return options->readers >= 1 && options->readers <= STRESS_MAX_READERS &&
+           options->reporters >= 0 && options->reporters <= STRESS_MAX_REPORTERS &&
+           options->students >= 1 && options->students <= 999999 / 2 &&
+           options->seconds > 0.0;
+}
+
+int main(int argc, char *argv[]) {
+    StressOptions options;
+    if (!parse_options(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s [--readers 1-%d] [--reporters 0-%d] [--students N] "
+                "[--seconds S] [--seed N]\n", argv[0], STRESS_MAX_READERS, STRESS_MAX_REPORTERS);
+        return EXIT_FAILURE;
+    }
+    log_set_level(LOG_LEVEL_ERROR);
+
+    StudentDatabase *db = create_database();
+    if (!db) {
+        fprintf(stderr, "Failed to create database\n");
+        return EXIT_FAILURE;
+    }
+
+    // Start half full so adds, modifies and removes are all common
+    uint64_t setup_state = options.seed;
+    char name[MAX_NAME_LENGTH];
+    begin_student_batch(db);
+    for (int roll_number = 1; roll_number <= options.students * 2; roll_number += 2) {
+        stress_name(roll_number, name, sizeof(name));
+        add_student(db, name, roll_number, (float)random_below(&setup_state, 10001) / 100.0f);
+    }
+    end_student_batch(db);
+
+    // Thread 0 writes, then come the readers, then the reporters
+    StressThread threads[STRESS_MAX_READERS + STRESS_MAX_REPORTERS + 1];
+    pthread_t handles[STRESS_MAX_READERS + STRESS_MAX_REPORTERS + 1];
+    int thread_count = options.readers + options.reporters + 1;
+    for (int i = 0; i < thread_count; i++) {
+        threads[i] = (StressThread){db, &options, options.seed + (uint64_t)(i + 1) * 7919, 0, 0, 0};
+        void *(*entry)(void*) = i == 0 ? writer_main :
+                                i <= options.readers ? reader_main : reporter_main;
+        pthread_create(&handles[i], NULL, entry, &threads[i]);
+    }
+
+    double started = now_seconds();
+    struct timespec pause = {0, 10 * 1000000L};
+    while (now_seconds() - started < options.seconds) {
+        nanosleep(&pause, NULL);
+    }
+    atomic_store(&stop_requested, true);
+
+    long reads = 0;
+    long snapshots = 0;
+    long snapshot_records = 0;
+    long violations = 0;
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(handles[i], NULL);
+        violations += threads[i].violations;
+        if (i > options.readers) {
+            snapshots += threads[i].operations;
+            snapshot_records += threads[i].records;
+        } else if (i > 0) {
+            reads += threads[i].operations;
+        }
+    }
+    double elapsed = now_seconds() - started;
+    long writes = threads[0].operations;
+
+    printf("{\n  \"benchmark\": \"db_stress\",\n  \"readers\": %d,\n  \"reporters\": %d,\n"
+           "  \"students\": %d,\n  \"seconds\": %.3f,\n  \"reads\": %ld,\n  \"writes\": %ld,\n"
+           "  \"reads_per_second\": %.0f,\n  \"writes_per_second\": %.0f,\n"
+           "  \"snapshots\": %ld,\n  \"snapshot_records\": %ld,\n"
+           "  \"final_count\": %d,\n  \"violations\": %ld\n}\n",
+           options.readers, options.reporters, options.students, elapsed, reads, writes,
+           (double)reads / elapsed, (double)writes / elapsed, snapshots, snapshot_records,
+           db->count, violations);
+
+    destroy_database(db);
+    return violations == 0 && writes > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
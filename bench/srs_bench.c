@@ -0,0 +1,706 @@
+/*
+ * File: bench/srs_bench.c
+ * Path: SchoolRecordSystem/bench/srs_bench.c
+ * Description: End-to-end benchmark of the record operations over synthetic data (JSON output)
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Usage: srs_bench [--scales 1000,100000,1000000] [--courses N|MIN-MAX]
+ *                  [--names unique|zipf|common] [--seed N] [--repeat N]
+ *                  [--dir DIR] [--output FILE]
+ *
+ * For every scale a deterministic data set is generated from the seed,
+ * then add, course add, find, every statistics function, every
+ * SortCriteria (both sort_students and the order-based sort), save,
+ * export, load and remove are timed. Results go to stdout (or --output)
+ * as one JSON document; progress goes to stderr.
+ */
+
+#include "student.h"
+#include "calculations.h"
+#include "file_operations.h"
+#include "logger.h"
+#include "report.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_VERSION "2.0.0"
+#define BENCH_MAX_SCALES 8
+#define DEFAULT_SEED 20250720ULL
+#define DEFAULT_REPEAT 3
+
+// Roll numbers are valid up to 999999, which caps the largest scale
+#define BENCH_MAX_STUDENTS 999999
+
+// sort_students orders names with a bubble sort; skip it above this size
+#define BENCH_QUADRATIC_LIMIT 20000
+
+// Lookups per find measurement and students removed per remove measurement
+#define BENCH_MAX_LOOKUPS 1000000
+#define BENCH_REMOVALS 100
+
+// Name distributions
+typedef enum {
+    NAMES_UNIQUE,                        // Random syllables, nearly all distinct
+    NAMES_ZIPF,                          // Surnames from a Zipf-weighted pool
+    NAMES_COMMON                         // A few hundred names, heavy duplication
+} NameDistribution;
+
+typedef struct {
+    int scales[BENCH_MAX_SCALES];
+    int scale_count;
+    int min_courses;
+    int max_courses;
+    NameDistribution names;
+    unsigned long long seed;
+    int repeat;
+    const char *dir;
+    const char *output;
+} BenchOptions;
+
+// One generated data set
+typedef struct {
+    int count;
+    char (*names)[MAX_NAME_LENGTH];
+    int *rolls;
+    float *marks;
+} BenchData;
+
+typedef struct {
+    FILE *out;
+    bool first_operation;                // No comma needed before the next record
+} BenchReport;
+
+typedef char NamePart[MAX_NAME_LENGTH / 2];
+
+static const char *syllables[] = {
+    "ba", "ko", "ri", "na", "de", "lu", "mi", "sa", "to", "ve",
+    "chi", "zu", "fe", "go", "ha", "je", "ka", "lo", "ma", "ne",
+    "ol", "pa", "qui", "ro", "su", "ti", "u", "vo", "wa", "ye",
+    "an", "el", "in", "or", "em", "ad", "ib", "us", "ez", "ya"
+};
+#define SYLLABLE_COUNT ((int)(sizeof(syllables) / sizeof(syllables[0])))
+
+static const char *course_pool[] = {
+    "Mathematics", "Physics", "Chemistry", "Biology", "English",
+    "History", "Geography", "Economics", "Computer Science", "Literature",
+    "Further Mathematics", "Civic Education"
+};
+#define COURSE_POOL_SIZE ((int)(sizeof(course_pool) / sizeof(course_pool[0])))
+
+static const char *sort_names[] = {
+    "marks_asc", "marks_desc", "name_asc", "name_desc", "roll_asc", "roll_desc"
+};
+
+static const char *distribution_names[] = {"unique", "zipf", "common"};
+
+/* ============================================================================
+ * DETERMINISTIC GENERATOR
+ * ============================================================================ */
+
+// splitmix64: small, fast and identical on every platform
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int random_below(uint64_t *state, int bound) {
+    return (int)(next_random(state) % (uint64_t)bound);
+}
+
+static double random_unit(uint64_t *state) {
+    return (double)(next_random(state) >> 11) / 9007199254740992.0;
+}
+
+// Capitalised word of 'parts' random syllables
+static void random_word(uint64_t *state, int parts, char *buffer, size_t size) {
+    buffer[0] = '\0';
+    for (int i = 0; i < parts; i++) {
+        strncat(buffer, syllables[random_below(state, SYLLABLE_COUNT)], size - strlen(buffer) - 1);
+    }
+    if (buffer[0] >= 'a' && buffer[0] <= 'z') {
+        buffer[0] = (char)(buffer[0] - 'a' + 'A');
+    }
+}
+
+/**
+ * Pool of words drawn once from the generator
+ * @return Array of 'count' words (caller frees)
+ */
+static NamePart* make_word_pool(uint64_t *state, int count) {
+    NamePart *pool = malloc((size_t)count * sizeof(NamePart));
+    if (!pool) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        random_word(state, 2 + random_below(state, 2), pool[i], sizeof(pool[i]));
+    }
+    return pool;
+}
+
+/**
+ * Zipf(s = 1) cumulative weights over 'count' ranks
+ * @return Array of 'count' cumulative probabilities (caller frees)
+ */
+static double* make_zipf_table(int count) {
+    double *cumulative = malloc((size_t)count * sizeof(double));
+    if (!cumulative) return NULL;
+
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        total += 1.0 / (i + 1);
+        cumulative[i] = total;
+    }
+    for (int i = 0; i < count; i++) {
+        cumulative[i] /= total;
+    }
+    return cumulative;
+}
+
+static int sample_zipf(uint64_t *state, const double *cumulative, int count) {
+    double u = random_unit(state);
+    int low = 0, high = count - 1;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (cumulative[mid] < u) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void free_data(BenchData *data) {
+    free(data->names);
+    free(data->rolls);
+    free(data->marks);
+    memset(data, 0, sizeof(*data));
+}
+
+/**
+ * Generate 'count' students: distinct roll numbers in random order,
+ * marks on the 0.01 grid and names from the chosen distribution
+ * @return true on success
+ */
+static bool generate_data(BenchData *data, int count, NameDistribution distribution, uint64_t seed) {
+    uint64_t state = seed;
+    data->count = count;
+    data->names = malloc((size_t)count * sizeof(*data->names));
+    data->rolls = malloc((size_t)count * sizeof(int));
+    data->marks = malloc((size_t)count * sizeof(float));
+
+    int pool_size = distribution == NAMES_COMMON ? 20 : 1000;
+    NamePart *first_names = make_word_pool(&state, pool_size);
+    NamePart *last_names = make_word_pool(&state, pool_size);
+    double *zipf = distribution == NAMES_ZIPF ? make_zipf_table(pool_size) : NULL;
+
+    bool ok = data->names && data->rolls && data->marks && first_names && last_names &&
+              (distribution != NAMES_ZIPF || zipf);
+    if (ok) {
+        // Spread the roll numbers over the valid range, then shuffle them
+        int stride = BENCH_MAX_STUDENTS / count;
+        for (int i = 0; i < count; i++) {
+            data->rolls[i] = 1 + i * stride;
+        }
+        for (int i = count - 1; i > 0; i--) {
+            int j = random_below(&state, i + 1);
+            int swap = data->rolls[i];
+            data->rolls[i] = data->rolls[j];
+            data->rolls[j] = swap;
+        }
+
+        for (int i = 0; i < count; i++) {
+            data->marks[i] = (float)random_below(&state, 10001) / 100.0f;
+
+            NamePart first, last;
+            switch (distribution) {
+                case NAMES_UNIQUE:
+                    random_word(&state, 2 + random_below(&state, 2), first, sizeof(first));
+                    random_word(&state, 2 + random_below(&state, 3), last, sizeof(last));
+                    break;
+                case NAMES_ZIPF:
+                    strcpy(first, first_names[random_below(&state, pool_size)]);
+                    strcpy(last, last_names[sample_zipf(&state, zipf, pool_size)]);
+                    break;
+                case NAMES_COMMON:
+                default:
+                    strcpy(first, first_names[random_below(&state, pool_size)]);
+                    strcpy(last, last_names[random_below(&state, pool_size)]);
+                    break;
+            }
+            snprintf(data->names[i], MAX_NAME_LENGTH, "%s %s", first, last);
+        }
+    }
+
+    free(first_names);
+    free(last_names);
+    free(zipf);
+    if (!ok) {
+        free_data(data);
+    }
+    return ok;
+}
+
+/**
+ * Random permutation in apply_sort_order() form, to restore an unsorted
+ * order before each sort measurement
+ */
+static void shuffle_database(StudentDatabase *db, int *order, uint64_t *state) {
+    for (int i = 0; i < db->count; i++) {
+        order[i] = i;
+    }
+    for (int i = db->count - 1; i > 0; i--) {
+        int j = random_below(state, i + 1);
+        int swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+    apply_sort_order(db, order, db->count);
+}
+
+/* ============================================================================
+ * TIMING AND REPORTING
+ * ============================================================================ */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Emit one operation record
+ * @param samples Seconds per run (sorted in place)
+ * @param operations Work items per run, for the per-operation figure
+ */
+static void report_operation(BenchReport *report, const char *name, double *samples, int runs,
+                             long operations) {
+    qsort(samples, (size_t)runs, sizeof(double), compare_doubles);
+    double median = samples[runs / 2];
+
+    fprintf(report->out, "%s\n        {\"name\": \"%s\", \"runs\": %d, \"operations\": %ld, "
+            "\"min_seconds\": %.9f, \"median_seconds\": %.9f, \"max_seconds\": %.9f, "
+            "\"ns_per_operation\": %.3f}",
+            report->first_operation ? "" : ",", name, runs, operations,
+            samples[0], median, samples[runs - 1],
+            operations > 0 ? median * 1e9 / (double)operations : 0.0);
+    report->first_operation = false;
+
+    fprintf(stderr, "  %-28s %12.6f s  (%ld ops)\n", name, median, operations);
+}
+
+static void report_skipped(BenchReport *report, const char *name, const char *reason) {
+    fprintf(report->out, "%s\n        {\"name\": \"%s\", \"skipped\": \"%s\"}",
+            report->first_operation ? "" : ",", name, reason);
+    report->first_operation = false;
+
+    fprintf(stderr, "  %-28s skipped (%s)\n", name, reason);
+}
+
+/* ============================================================================
+ * MEASUREMENTS
+ * ============================================================================ */
+
+// Sink so the compiler cannot drop results
+static volatile double g_sink;
+
+typedef enum {
+    STAT_SUMMARY,
+    STAT_FULL_SCAN,
+    STAT_STATISTICS,
+    STAT_AVERAGE,
+    STAT_MEDIAN,
+    STAT_STANDARD_DEVIATION,
+    STAT_QUANTILES,
+    STAT_GRADE_DISTRIBUTION,
+    STAT_AVERAGE_GPA,
+    STAT_HIGHEST,
+    STAT_LOWEST,
+    STAT_PASS_PERCENTAGE,
+    STAT_COUNT
+} StatisticsFunction;
+
+static const char *statistics_names[STAT_COUNT] = {
+    "compute_statistics_summary", "scan_statistics_summary", "calculate_statistics",
+    "calculate_average_marks", "calculate_median_marks", "calculate_standard_deviation",
+    "calculate_quantile_summary", "get_grade_distribution", "calculate_average_gpa",
+    "find_highest_scorer", "find_lowest_scorer", "calculate_pass_percentage"
+};
+
+static void run_statistics_function(StudentDatabase *db, StatisticsFunction function) {
+    switch (function) {
+        case STAT_SUMMARY: g_sink += compute_statistics_summary(db).sum_marks; break;
+        case STAT_FULL_SCAN: g_sink += scan_statistics_summary(db).sum_marks; break;
+        case STAT_STATISTICS: g_sink += calculate_statistics(db).average_marks; break;
+        case STAT_AVERAGE: g_sink += calculate_average_marks(db); break;
+        case STAT_MEDIAN: g_sink += calculate_median_marks(db); break;
+        case STAT_STANDARD_DEVIATION: g_sink += calculate_standard_deviation(db); break;
+        case STAT_QUANTILES: g_sink += calculate_quantile_summary(db).p50; break;
+        case STAT_GRADE_DISTRIBUTION: {
+            int distribution[6];
+            get_grade_distribution(db, distribution);
+            g_sink += distribution[0];
+            break;
+        }
+        case STAT_AVERAGE_GPA: g_sink += calculate_average_gpa(db); break;
+        case STAT_HIGHEST: g_sink += find_highest_scorer(db) != NULL; break;
+        case STAT_LOWEST: g_sink += find_lowest_scorer(db) != NULL; break;
+        case STAT_PASS_PERCENTAGE: g_sink += calculate_pass_percentage(db); break;
+        default: break;
+    }
+}
+
+static bool sum_course_counts(const char *course_name, const MarksBreakdown *stats, void *context) {
+    (void)course_name;
+    (void)context;
+    g_sink += stats->count;
+    return true;
+}
+
+/**
+ * Run every measurement at one scale
+ * @return false if the data set or database could not be built
+ */
+static bool bench_scale(BenchReport *report, const BenchOptions *options, int requested) {
+    int count = requested > BENCH_MAX_STUDENTS ? BENCH_MAX_STUDENTS : requested;
+    int repeat = options->repeat;
+    BenchData data;
+    uint64_t state = options->seed ^ (uint64_t)count;
+
+    fprintf(stderr, "Scale %d (%s names, %d-%d courses)\n", count,
+            distribution_names[options->names], options->min_courses, options->max_courses);
+    if (!generate_data(&data, count, options->names, options->seed + (uint64_t)count)) {
+        fprintf(stderr, "Failed to generate %d students\n", count);
+        return false;
+    }
+
+    double *samples = malloc((size_t)repeat * sizeof(double));
+    int *order = malloc((size_t)count * sizeof(int));
+    StudentDatabase *db = create_database();
+    if (!samples || !order || !db) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(samples);
+        free(order);
+        destroy_database(db);
+        free_data(&data);
+        return false;
+    }
+
+    fprintf(report->out, "%s\n    {\"requested\": %d, \"students\": %d, \"operations\": [",
+            report->first_operation ? "" : ",", requested, count);
+    report->first_operation = true;
+
+    // Add: builds the database, so it runs once
+    double start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        add_student(db, data.names[i], data.rolls[i], data.marks[i]);
+    }
+    double single = now_seconds() - start;
+    report_operation(report, "add_student", &single, 1, count);
+
+    long courses_added = 0;
+    start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        int courses = options->min_courses +
+                      random_below(&state, options->max_courses - options->min_courses + 1);
+        int first = random_below(&state, COURSE_POOL_SIZE);
+        for (int c = 0; c < courses; c++) {
+            float score = (float)random_below(&state, 10001) / 100.0f;
+            if (add_course_to_student(db, data.rolls[i], course_pool[(first + c) % COURSE_POOL_SIZE],
+                                      score) == STUDENT_SUCCESS) {
+                courses_added++;
+            }
+        }
+    }
+    single = now_seconds() - start;
+    report_operation(report, "add_course_to_student", &single, 1, courses_added);
+
+    // Find: random existing roll numbers
+    int lookups = count < BENCH_MAX_LOOKUPS ? count : BENCH_MAX_LOOKUPS;
+    int *probe = malloc((size_t)lookups * sizeof(int));
+    if (probe) {
+        for (int i = 0; i < lookups; i++) {
+            probe[i] = data.rolls[random_below(&state, count)];
+        }
+        for (int r = 0; r < repeat; r++) {
+            long found = 0;
+            start = now_seconds();
+            for (int i = 0; i < lookups; i++) {
+                found += find_student(db, probe[i]) != NULL;
+            }
+            samples[r] = now_seconds() - start;
+            g_sink += found;
+        }
+        report_operation(report, "find_student", samples, repeat, lookups);
+        free(probe);
+    }
+
+    for (int function = 0; function < STAT_COUNT; function++) {
+        for (int r = 0; r < repeat; r++) {
+            start = now_seconds();
+            run_statistics_function(db, (StatisticsFunction)function);
+            samples[r] = now_seconds() - start;
+        }
+        report_operation(report, statistics_names[function], samples, repeat, 1);
+    }
+
+    // Course statistics: the one-pass regroup every change triggers, then lookups it serves
+    for (int r = 0; r < repeat; r++) {
+        db->course_stats.stale = true;
+        start = now_seconds();
+        visit_course_statistics(db, sum_course_counts, NULL);
+        samples[r] = now_seconds() - start;
+    }
+    report_operation(report, "course_statistics/group", samples, repeat, count);
+
+    for (int r = 0; r < repeat; r++) {
+        start = now_seconds();
+        for (int c = 0; c < COURSE_POOL_SIZE; c++) {
+            g_sink += calculate_course_average(db, course_pool[c]);
+            g_sink += count_students_in_course(db, course_pool[c]);
+            g_sink += find_top_performer_in_course(db, course_pool[c]) != NULL;
+        }
+        samples[r] = now_seconds() - start;
+    }
+    report_operation(report, "course_statistics/lookup", samples, repeat, 3 * COURSE_POOL_SIZE);
+
+    // Sorts: each run starts from a fresh random order
+    char name[64];
+    for (int criteria = SORT_BY_MARKS_ASC; criteria <= SORT_BY_ROLL_NUMBER_DESC; criteria++) {
+        snprintf(name, sizeof(name), "sort_students/%s", sort_names[criteria]);
+        bool quadratic = criteria == SORT_BY_NAME_ASC || criteria == SORT_BY_NAME_DESC;
+        if (quadratic && count > BENCH_QUADRATIC_LIMIT) {
+            report_skipped(report, name, "bubble sort above 20000 students");
+        } else {
+            for (int r = 0; r < repeat; r++) {
+                shuffle_database(db, order, &state);
+                start = now_seconds();
+                sort_students(db, (SortCriteria)criteria);
+                samples[r] = now_seconds() - start;
+            }
+            report_operation(report, name, samples, repeat, count);
+        }
+
+        snprintf(name, sizeof(name), "sort_order/%s", sort_names[criteria]);
+        for (int r = 0; r < repeat; r++) {
+            shuffle_database(db, order, &state);
+            start = now_seconds();
+            compute_sort_order(db, (SortCriteria)criteria, order, NULL, NULL);
+            apply_sort_order(db, order, count);
+            samples[r] = now_seconds() - start;
+        }
+        report_operation(report, name, samples, repeat, count);
+    }
+
+    // File round trip
+    char save_path[512], export_path[512];
+    snprintf(save_path, sizeof(save_path), "%s/srs_bench_%d.txt", options->dir, count);
+    snprintf(export_path, sizeof(export_path), "%s/srs_bench_%d.csv", options->dir, count);
+
+    for (int r = 0; r < repeat; r++) {
+        start = now_seconds();
+        save_to_file(db, save_path);
+        samples[r] = now_seconds() - start;
+    }
+    report_operation(report, "save_to_file", samples, repeat, count);
+
+    for (int r = 0; r < repeat; r++) {
+        start = now_seconds();
+        export_to_csv(db, export_path);
+        samples[r] = now_seconds() - start;
+    }
+    report_operation(report, "export_to_csv", samples, repeat, count);
+
+    // Reports: the parallel scan plus each formatter, with every section
+    static const char *report_formats[] = {"text", "csv", "json"};
+    char report_path[512];
+    for (int format = REPORT_FORMAT_TEXT; format <= REPORT_FORMAT_JSON; format++) {
+        snprintf(report_path, sizeof(report_path), "%s/srs_bench_%d_report.%s",
+                 options->dir, count, report_formats[format]);
+        ReportOptions report_options = {(ReportFormat)format, REPORT_SECTION_ALL, 0};
+        for (int r = 0; r < repeat; r++) {
+            start = now_seconds();
+            write_report_file(db, &report_options, report_path);
+            samples[r] = now_seconds() - start;
+        }
+        snprintf(name, sizeof(name), "write_report/%s", report_formats[format]);
+        report_operation(report, name, samples, repeat, count);
+        unlink(report_path);
+    }
+
+    // Load into a fresh database; the first one is freed to bound memory
+    destroy_database(db);
+    db = create_database();
+    for (int r = 0; db && r < repeat; r++) {
+        start = now_seconds();
+        load_from_file(db, save_path);
+        samples[r] = now_seconds() - start;
+    }
+    if (db) {
+        report_operation(report, "load_from_file", samples, repeat, db->count);
+    }
+
+    // Remove: distinct random students from the loaded database
+    int removals = count < BENCH_REMOVALS ? count : BENCH_REMOVALS;
+    for (int i = 0; i < removals; i++) {
+        int j = i + random_below(&state, count - i);
+        int swap = data.rolls[i];
+        data.rolls[i] = data.rolls[j];
+        data.rolls[j] = swap;
+    }
+    if (db) {
+        start = now_seconds();
+        for (int i = 0; i < removals; i++) {
+            remove_student(db, data.rolls[i]);
+        }
+        single = now_seconds() - start;
+        report_operation(report, "remove_student", &single, 1, removals);
+    }
+
+    fprintf(report->out, "\n    ]}");
+    report->first_operation = false;
+
+    unlink(save_path);
+    unlink(export_path);
+    destroy_database(db);
+    free(order);
+    free(samples);
+    free_data(&data);
+    return true;
+}
+
+/* ============================================================================
+ * COMMAND LINE
+ * ============================================================================ */
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [--scales LIST] [--courses N|MIN-MAX] [--names unique|zipf|common]\n"
+            "          [--seed N] [--repeat N] [--dir DIR] [--output FILE]\n"
+            "Defaults: --scales 1000,100000,1000000 --courses 0-5 --names zipf --repeat %d\n",
+            program, DEFAULT_REPEAT);
+}
+
+static bool parse_scales(const char *text, BenchOptions *options) {
+    options->scale_count = 0;
+    const char *cursor = text;
+    while (*cursor && options->scale_count < BENCH_MAX_SCALES) {
+        char *end;
+        long value = strtol(cursor, &end, 10);
+        if (end == cursor || value <= 0 || value > 100000000) return false;
+        options->scales[options->scale_count++] = (int)value;
+        cursor = *end == ',' ? end + 1 : end;
+        if (*end != ',' && *end != '\0') return false;
+    }
+    return options->scale_count > 0;
+}
+
+static bool parse_options(int argc, char *argv[], BenchOptions *options) {
+    options->scales[0] = 1000;
+    options->scales[1] = 100000;
+    options->scales[2] = 1000000;
+    options->scale_count = 3;
+    options->min_courses = 0;
+    options->max_courses = 5;
+    options->names = NAMES_ZIPF;
+    options->seed = DEFAULT_SEED;
+    options->repeat = DEFAULT_REPEAT;
+    options->dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    options->output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--scales") == 0 && value) {
+            if (!parse_scales(value, options)) return false;
+        } else if (strcmp(argv[i], "--courses") == 0 && value) {
+            int low, high;
+            if (sscanf(value, "%d-%d", &low, &high) == 2) {
+                options->min_courses = low;
+                options->max_courses = high;
+            } else if (sscanf(value, "%d", &low) == 1) {
+                options->min_courses = options->max_courses = low;
+            } else {
+                return false;
+            }
+            if (options->min_courses < 0 || options->max_courses > MAX_COURSES ||
+                options->min_courses > options->max_courses) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--names") == 0 && value) {
+            int found = -1;
+            for (int d = NAMES_UNIQUE; d <= NAMES_COMMON; d++) {
+                if (strcmp(value, distribution_names[d]) == 0) found = d;
+            }
+            if (found < 0) return false;
+            options->names = (NameDistribution)found;
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            options->seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "--repeat") == 0 && value) {
+            options->repeat = atoi(value);
+            if (options->repeat <= 0) return false;
+        } else if (strcmp(argv[i], "--dir") == 0 && value) {
+            options->dir = value;
+        } else if (strcmp(argv[i], "--output") == 0 && value) {
+            options->output = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Keep per-record diagnostics out of the timings
+    log_set_level(LOG_LEVEL_WARN);
+
+    BenchReport report = {stdout, true};
+    if (options.output) {
+        report.out = fopen(options.output, "w");
+        if (!report.out) {
+            fprintf(stderr, "Cannot open %s for writing\n", options.output);
+            return EXIT_FAILURE;
+        }
+    }
+
+    time_t started = time(NULL);
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&started));
+
+    fprintf(report.out, "{\n  \"benchmark\": \"srs_bench\",\n  \"version\": \"%s\",\n"
+            "  \"timestamp\": \"%s\",\n  \"seed\": %llu,\n  \"repeat\": %d,\n"
+            "  \"name_distribution\": \"%s\",\n  \"courses\": {\"min\": %d, \"max\": %d},\n"
+            "  \"scales\": [",
+            BENCH_VERSION, timestamp, options.seed, options.repeat,
+            distribution_names[options.names], options.min_courses, options.max_courses);
+
+    bool ok = true;
+    for (int i = 0; i < options.scale_count && ok; i++) {
+        ok = bench_scale(&report, &options, options.scales[i]);
+    }
+
+    fprintf(report.out, "\n  ]\n}\n");
+    if (report.out != stdout) {
+        fclose(report.out);
+    }
+    fprintf(stderr, "checksum %.3f\n", (double)g_sink);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,374 @@
+/*
+ * File: bench/srs_loadgen.c
+ * Path: SchoolRecordSystem/bench/srs_loadgen.c
+ * Description: Load generator for the query daemon (JSON output)
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Usage: srs_loadgen [--socket PATH] [--clients N] [--requests N]
+ *                    [--pipeline N] [--rolls N] [--writes PERCENT]
+ *                    [--populate] [--seed N]
+ *
+ * Each client thread keeps up to --pipeline requests in flight on its
+ * own connection and times every request from send to its result line.
+ * Reads are find, rank, top, filter and stats on roll numbers 1..--rolls;
+ * writes are modify (so they change the served records). --populate
+ * first adds any missing students 1..--rolls. Results go to stdout as
+ * one JSON document.
+ */
+
+#include "server.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOADGEN_VERSION "2.0.0"
+#define LOADGEN_MAX_CLIENTS 256
+#define LOADGEN_MAX_PIPELINE 1024
+#define LOADGEN_REQUEST_LENGTH 128
+#define LOADGEN_BUFFER 65536
+#define LOADGEN_POPULATE_CHUNK 1000
+#define DEFAULT_SEED 20250720ULL
+
+typedef struct {
+    const char *socket_path;
+    int clients;
+    int requests;                        // Per client
+    int pipeline;
+    int rolls;
+    int write_percent;
+    bool populate;
+    unsigned long long seed;
+} LoadOptions;
+
+// Builds request 'index' into 'buffer' (newline included); returns its length
+typedef int (*RequestMaker)(void *context, int index, char *buffer, size_t size);
+
+typedef struct {
+    const LoadOptions *options;
+    int id;
+    uint64_t random_state;
+    double *latencies;                   // Seconds, one per request
+    int completed;
+    int failed;
+    bool connection_failed;
+} ClientState;
+
+/* ============================================================================
+ * HELPERS
+ * ============================================================================ */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// splitmix64, as in srs_bench
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int random_below(uint64_t *state, int bound) {
+    return (int)(next_random(state) % (uint64_t)bound);
+}
+
+static bool send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return true;
+}
+
+/**
+ * Send 'count' requests keeping at most 'depth' in flight, and wait for
+ * each result line (the lines carrying "ok"; streamed student lines are
+ * skipped)
+ * @param latencies Receives per-request latency in seconds (may be NULL)
+ * @param failed Receives the number of requests answered with ok:false
+ * @return false if the connection failed
+ */
+static bool run_pipelined(int fd, int count, int depth, RequestMaker make_request,
+                          void *context, double *latencies, int *failed) {
+    double *sent_at = malloc((size_t)depth * sizeof(double));
+    char *input = malloc(LOADGEN_BUFFER);
+    if (!sent_at || !input) {
+        free(sent_at);
+        free(input);
+        return false;
+    }
+
+    char batch[LOADGEN_REQUEST_LENGTH * 64];
+    size_t input_length = 0;
+    int sent = 0;
+    int received = 0;
+    bool ok = true;
+    *failed = 0;
+
+    while (received < count && ok) {
+        // Top up the pipeline
+        size_t batch_length = 0;
+        while (sent < count && sent - received < depth &&
+               batch_length + LOADGEN_REQUEST_LENGTH <= sizeof(batch)) {
+            batch_length += (size_t)make_request(context, sent, batch + batch_length,
+                                                 LOADGEN_REQUEST_LENGTH);
+            sent_at[sent % depth] = now_seconds();
+            sent++;
+        }
+        if (batch_length > 0 && !send_all(fd, batch, batch_length)) {
+            ok = false;
+            break;
+        }
+
+        ssize_t length = recv(fd, input + input_length, LOADGEN_BUFFER - input_length - 1, 0);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) {
+            ok = false;
+            break;
+        }
+        input_length += (size_t)length;
+        input[input_length] = '\0';
+
+        // Consume complete lines
+        char *line = input;
+        char *newline;
+        while ((newline = strchr(line, '\n')) != NULL) {
+            *newline = '\0';
+            if (strstr(line, ",\"ok\":")) {
+                if (latencies) {
+                    latencies[received] = now_seconds() - sent_at[received % depth];
+                }
+                if (strstr(line, ",\"ok\":false")) {
+                    (*failed)++;
+                }
+                received++;
+            }
+            line = newline + 1;
+        }
+        input_length = (size_t)(input + input_length - line);
+        memmove(input, line, input_length);
+    }
+
+    free(sent_at);
+    free(input);
+    return ok;
+}
+
+/* ============================================================================
+ * WORKLOAD
+ * ============================================================================ */
+
+static int make_populate_request(void *context, int index, char *buffer, size_t size) {
+    ClientState *state = context;
+    int roll_number = index + 1;
+    char suffix[8];
+
+    // Letters only: the record validator rejects digits in names
+    for (int i = 0; i < 4; i++) {
+        suffix[i] = (char)('a' + (roll_number >> (5 * i)) % 26);
+    }
+    suffix[4] = '\0';
+    return snprintf(buffer, size, "add %d %d Load Student %s\n", roll_number,
+                    random_below(&state->random_state, 101), suffix);
+}
+
+static int make_load_request(void *context, int index, char *buffer, size_t size) {
+    ClientState *state = context;
+    const LoadOptions *options = state->options;
+    int roll_number = 1 + random_below(&state->random_state, options->rolls);
+    (void)index;
+
+    if (random_below(&state->random_state, 100) < options->write_percent) {
+        return snprintf(buffer, size, "modify %d %d Load Student\n", roll_number,
+                        random_below(&state->random_state, 101));
+    }
+
+    int pick = random_below(&state->random_state, 100);
+    if (pick < 60) return snprintf(buffer, size, "find %d\n", roll_number);
+    if (pick < 80) return snprintf(buffer, size, "rank %d\n", roll_number);
+    if (pick < 90) return snprintf(buffer, size, "top 10\n");
+    if (pick < 95) return snprintf(buffer, size, "filter grade=A limit=10\n");
+    return snprintf(buffer, size, "stats\n");
+}
+
+static void* client_main(void *argument) {
+    ClientState *state = argument;
+    const LoadOptions *options = state->options;
+
+    int fd = server_connect(options->socket_path);
+    if (fd < 0) {
+        state->connection_failed = true;
+        return NULL;
+    }
+
+    if (!run_pipelined(fd, options->requests, options->pipeline, make_load_request,
+                       state, state->latencies, &state->failed)) {
+        state->connection_failed = true;
+    } else {
+        state->completed = options->requests;
+    }
+
+    close(fd);
+    return NULL;
+}
+
+static bool populate(const LoadOptions *options) {
+    int fd = server_connect(options->socket_path);
+    if (fd < 0) return false;
+
+    ClientState state = {options, 0, options->seed, NULL, 0, 0, false};
+    int skipped = 0;
+    bool ok = run_pipelined(fd, options->rolls, LOADGEN_POPULATE_CHUNK,
+                            make_populate_request, &state, NULL, &skipped);
+    close(fd);
+
+    fprintf(stderr, "populate: %d added, %d already present\n", options->rolls - skipped, skipped);
+    return ok;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================ */
+
+static void print_usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [--socket PATH] [--clients N] [--requests N] [--pipeline N]\n"
+                    "       [--rolls N] [--writes PERCENT] [--populate] [--seed N]\n",
+            program_name);
+}
+
+static bool parse_int(const char *text, int min, int max, int *value) {
+    char *end;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < min || parsed > max) return false;
+    *value = (int)parsed;
+    return true;
+}
+
+static bool parse_options(int argc, char *argv[], LoadOptions *options) {
+    options->socket_path = SERVER_DEFAULT_SOCKET;
+    options->clients = 4;
+    options->requests = 20000;
+    options->pipeline = 16;
+    options->rolls = 1000;
+    options->write_percent = 0;
+    options->populate = false;
+    options->seed = DEFAULT_SEED;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool ok = true;
+        if (strcmp(argv[i], "--populate") == 0) {
+            options->populate = true;
+            continue;
+        } else if (!value) {
+            return false;
+        } else if (strcmp(argv[i], "--socket") == 0) {
+            options->socket_path = value;
+        } else if (strcmp(argv[i], "--clients") == 0) {
+            ok = parse_int(value, 1, LOADGEN_MAX_CLIENTS, &options->clients);
+        } else if (strcmp(argv[i], "--requests") == 0) {
+            ok = parse_int(value, 1, 100000000, &options->requests);
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            ok = parse_int(value, 1, LOADGEN_MAX_PIPELINE, &options->pipeline);
+        } else if (strcmp(argv[i], "--rolls") == 0) {
+            ok = parse_int(value, 1, 999999, &options->rolls);
+        } else if (strcmp(argv[i], "--writes") == 0) {
+            ok = parse_int(value, 0, 100, &options->write_percent);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            options->seed = strtoull(value, NULL, 10);
+        } else {
+            return false;
+        }
+        if (!ok) return false;
+        i++;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    LoadOptions options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (options.populate && !populate(&options)) {
+        fprintf(stderr, "Cannot populate the server at %s\n", options.socket_path);
+        return EXIT_FAILURE;
+    }
+
+    ClientState *states = calloc((size_t)options.clients, sizeof(ClientState));
+    pthread_t *threads = calloc((size_t)options.clients, sizeof(pthread_t));
+    double *latencies = malloc((size_t)options.clients * (size_t)options.requests * sizeof(double));
+    if (!states || !threads || !latencies) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+
+    double started = now_seconds();
+    for (int i = 0; i < options.clients; i++) {
+        states[i].options = &options;
+        states[i].id = i;
+        states[i].random_state = options.seed + (uint64_t)i * 0x9E3779B97F4A7C15ULL;
+        states[i].latencies = latencies + (size_t)i * (size_t)options.requests;
+        pthread_create(&threads[i], NULL, client_main, &states[i]);
+    }
+
+    long completed = 0;
+    long failed = 0;
+    int broken = 0;
+    for (int i = 0; i < options.clients; i++) {
+        pthread_join(threads[i], NULL);
+        if (states[i].connection_failed) {
+            broken++;
+            continue;
+        }
+        // Pack the finished clients' latencies together
+        memmove(latencies + completed, states[i].latencies, (size_t)states[i].completed * sizeof(double));
+        completed += states[i].completed;
+        failed += states[i].failed;
+    }
+    double elapsed = now_seconds() - started;
+
+    qsort(latencies, (size_t)completed, sizeof(double), compare_doubles);
+    double p50 = completed ? latencies[(completed - 1) * 50 / 100] : 0.0;
+    double p90 = completed ? latencies[(completed - 1) * 90 / 100] : 0.0;
+    double p99 = completed ? latencies[(completed - 1) * 99 / 100] : 0.0;
+    double max = completed ? latencies[completed - 1] : 0.0;
+
+    printf("{\n  \"benchmark\": \"srs_loadgen\",\n  \"version\": \"%s\",\n"
+           "  \"clients\": %d,\n  \"pipeline\": %d,\n  \"rolls\": %d,\n  \"write_percent\": %d,\n"
+           "  \"requests\": %ld,\n  \"failed_requests\": %ld,\n  \"failed_clients\": %d,\n"
+           "  \"seconds\": %.3f,\n  \"requests_per_second\": %.0f,\n"
+           "  \"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f}\n}\n",
+           LOADGEN_VERSION, options.clients, options.pipeline, options.rolls, options.write_percent,
+           completed, failed, broken, elapsed, elapsed > 0 ? (double)completed / elapsed : 0.0,
+           p50 * 1e6, p90 * 1e6, p99 * 1e6, max * 1e6);
+
+    free(states);
+    free(threads);
+    free(latencies);
+    return broken == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+/*
+ * File: include/batch.h
+ * Path: SchoolRecordSystem/include/batch.h
+ * Description: Non-interactive command mode with NDJSON results for scripted pipelines
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "student.h"
+#include <stdio.h>
+
+#define BATCH_MAX_LINE 1024
+#define BATCH_MAX_ARGS 16
+
+/*
+ * Commands, one per line ('#' starts a comment; quote arguments that
+ * contain spaces):
+ *
+ *   load FILE              replace the records with FILE
+ *   import FILE            add the records in FILE, skipping roll numbers already present
+ *   add ROLL MARKS NAME    modify ROLL MARKS NAME    remove ROLL
+ *   find ROLL              search TEXT [LIMIT]        list [LIMIT]
+ *   rank ROLL              top [N]
+ *   filter TERM...         terms (all must hold): passed, failed, grade=X,
+ *                          course=NAME, marks>=V, marks<V, gpa>=V, gpa<V, limit=N
+ *   sort marks_asc|marks_desc|name_asc|name_desc|roll_asc|roll_desc
+ *   stats                  clear
+ *   courses [NAME]         per-course count, mean, variance, extremes, pass rate,
+ *                          grades and top roll number (one course, or every course)
+ *   export FILE            save [FILE]
+ *   report FILE [FORMAT]   statistics report as text, csv or json (default: by extension)
+ *   grades FILE            grade distribution (format by extension)
+ *   quit
+ *
+ * Every command writes one JSON object line with "line", "command",
+ * "ok" and "elapsed_ms" plus its results; list, find, search, top and
+ * filter first stream one "student" line per record, and courses one
+ * "course" line per course. The database stays resident between
+ * commands.
+ */
+
+// Run one command line (tokenized in place); returns false if the command failed
+bool batch_execute_line(StudentDatabase *db, char *line, int line_number, FILE *output, bool *quit);
+
+// Report a line that exceeded BATCH_MAX_LINE
+void batch_report_overlong_line(int line_number, FILE *output);
+
+// Run the commands in 'input' against 'db'; returns the number of failed commands
+int run_batch(StudentDatabase *db, FILE *input, FILE *output);
+
+// Run a script file ("-" reads stdin) on a fresh database; returns a process exit status
+int run_batch_file(const char *script_path);
+
+#endif // BATCH_H
@@ -0,0 +1,54 @@
+/*
+ * File: include/bitmap_index.h
+ * Path: SchoolRecordSystem/include/bitmap_index.h
+ * Description: Compressed bitmap indexes over student attributes, keyed by roll number
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef BITMAP_INDEX_H
+#define BITMAP_INDEX_H
+
+#include "roaring_bitmap.h"
+
+// Bucket layout for the numeric attributes
+#define BITMAP_GRADE_COUNT 6             // A, B, C, D, E, F
+#define BITMAP_MARKS_BUCKETS 101         // floor(marks): 0 .. 100
+#define BITMAP_GPA_BUCKETS 41            // floor(gpa * 10): 0.0 .. 4.0
+#define BITMAP_GPA_BUCKET_SCALE 10.0f
+
+// Members of one course
+typedef struct {
+    char *course_name;
+    RoaringBitmap members;
+} CourseBitmap;
+
+// One bitmap per attribute value; every bitmap holds roll numbers
+typedef struct {
+    RoaringBitmap all;                   // Every student
+    RoaringBitmap passed;                // marks >= PASSING_MARKS
+    RoaringBitmap grades[BITMAP_GRADE_COUNT];
+    RoaringBitmap marks_buckets[BITMAP_MARKS_BUCKETS];
+    RoaringBitmap gpa_buckets[BITMAP_GPA_BUCKETS];
+    CourseBitmap *courses;
+    int course_count;
+    int course_capacity;
+} BitmapIndex;
+
+// Lifecycle
+void bitmap_index_init(BitmapIndex *index);
+void bitmap_index_free(BitmapIndex *index);
+void bitmap_index_clear(BitmapIndex *index);
+
+// Maintenance (called from the student mutation hooks)
+void bitmap_index_update(BitmapIndex *index, int roll_number, float marks, float gpa, bool add);
+void bitmap_index_set_enrolment(BitmapIndex *index, const char *course_name,
+                                int roll_number, bool enrolled);
+
+// Lookups
+int bitmap_marks_bucket(float marks);
+int bitmap_gpa_bucket(float gpa);
+const RoaringBitmap* bitmap_index_course(const BitmapIndex *index, const char *course_name);
+
+#endif // BITMAP_INDEX_H
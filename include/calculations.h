@@ -11,6 +11,7 @@
 #define CALCULATIONS_H
 
 #include "student.h"
+#include "student_query.h"
 #include <math.h>
 
 // Enumeration for sorting criteria
@@ -34,6 +35,34 @@ typedef struct {
     float pass_percentage;
 } Statistics;
 
+// Fused single-pass aggregate over all active students
+typedef struct {
+    int count;
+    double sum_marks;
+    float highest_marks;
+    float lowest_marks;
+    int highest_index;                    // Index into db->students, -1 if empty
+    int lowest_index;                     // Index into db->students, -1 if empty
+    int passed_students;
+    int failed_students;
+    double mean_marks;                    // sum_marks / count
+    double m2_marks;                      // Sum of squared deviations: sum of squares - sum * mean (>= 0)
+    int students_with_courses;
+    double sum_gpa;
+    int grade_counts[6];                  // A, B, C, D, E, F
+} StatisticsSummary;
+
+/* ============================================================================
+ * FUSED STATISTICS KERNEL
+ * ============================================================================ */
+
+// Running aggregates give everything in O(log n); the functions below are views over it
+StatisticsSummary compute_statistics_summary(StudentDatabase *db);
+StatisticsSummary scan_statistics_summary(StudentDatabase *db);
+Statistics statistics_from_summary(const StatisticsSummary *summary);
+float summary_standard_deviation(const StatisticsSummary *summary);
+float summary_average_gpa(const StatisticsSummary *summary);
+
 /* ============================================================================
  * BASIC STATISTICAL FUNCTIONS
  * ============================================================================ */
@@ -62,22 +91,40 @@ int partition_roll_numbers(Student *arr, int low, int high, bool ascending);
 void bubble_sort_names(Student *arr, int n, bool ascending);
 void swap_students(Student *a, Student *b);
 
+// Sorting in two steps: compute the order (read-only, any thread), then apply it
+bool compute_sort_order(const StudentDatabase *db, SortCriteria criteria, int *order,
+                        StudentProgressFunc progress, void *context);
+bool apply_sort_order(StudentDatabase *db, const int *order, int count);
+
 /* ============================================================================
  * ENHANCED STATISTICAL FUNCTIONS
  * ============================================================================ */
 
 // Advanced statistics
 float calculate_median_marks(StudentDatabase *db);
+float calculate_percentile_marks(StudentDatabase *db, float percentile);
 float calculate_standard_deviation(StudentDatabase *db);
 void get_grade_distribution(StudentDatabase *db, int distribution[6]);
+void build_marks_histogram(const float *marks, int count, int bins[MARKS_HISTOGRAM_BINS]);
 
 // Course-related statistics
 float calculate_average_gpa(StudentDatabase *db);
 
 /* ============================================================================
- * COURSE STATISTICS (FOR FUTURE EXPANSION)
+ * COURSE STATISTICS
  * ============================================================================ */
 
+typedef bool (*CourseVisitFunc)(const char *course_name, const MarksBreakdown *stats, void *context);
+
+/*
+ * Course lookups share one table of breakdowns grouped in a single pass
+ * over every student's courses; the pass reruns on the first lookup
+ * after a change. Positions in the breakdowns index db->students.
+ */
+void group_student_courses(CourseTable *table, const Student *student, int position);
+bool get_course_statistics(StudentDatabase *db, const char *course_name, MarksBreakdown *stats);
+int visit_course_statistics(StudentDatabase *db, CourseVisitFunc func, void *context);
+
 // Course performance analysis
 float calculate_course_average(StudentDatabase *db, const char *course_name);
 int count_students_in_course(StudentDatabase *db, const char *course_name);
@@ -146,6 +193,27 @@ double calculate_variance(float *values, int count, float mean);
 double calculate_correlation(float *x_values, float *y_values, int count);
 float calculate_percentile(float *sorted_values, int count, float percentile);
 
+/* ============================================================================
+ * SELECTION AND QUANTILES
+ * ============================================================================ */
+
+// Batched quantile summary of the marks distribution
+typedef struct {
+    float p10;
+    float p25;
+    float p50;
+    float p75;
+    float p90;
+} QuantileSummary;
+
+// Linear-time selection (partially reorders the input array)
+float select_kth_smallest(float *values, int count, int k);
+QuantileSummary calculate_quantile_summary(StudentDatabase *db);
+bool calculate_quantiles_by_counting(const float *values, int count, const float *percentiles,
+                                     float *results, int n);
+void calculate_quantiles_from_counts(const int *counts, int count, const float *percentiles,
+                                     float *results, int n);
+
 /* ============================================================================
  * SEARCH AND FILTER FUNCTIONS
  * ============================================================================ */
@@ -155,6 +223,9 @@ int find_students_by_grade_range(StudentDatabase *db, float min_marks, float max
 int find_students_by_status(StudentDatabase *db, const char *status, Student **results);
 int find_students_with_gpa_above(StudentDatabase *db, float min_gpa, Student **results);
 
+// Compound queries (AND/OR/NOT of predicates) over the bitmap index
+int find_students_by_query(StudentDatabase *db, const StudentQuery *query, Student **results);
+
 /* ============================================================================
  * COMPARATIVE ANALYSIS
  * ============================================================================ */
@@ -190,6 +261,12 @@ typedef enum {
 CalculationError validate_calculation_input(StudentDatabase *db);
 const char* get_calculation_error_message(CalculationError error);
 
+// Multi-quantile selection (declared here because they report CalculationError)
+CalculationError select_percentiles(float *values, int count, const float *percentiles,
+                                    float *results, int n);
+CalculationError calculate_marks_quantiles(StudentDatabase *db, const float *percentiles,
+                                           float *results, int n);
+
 /* ============================================================================
  * CONSTANTS AND THRESHOLDS
  * ============================================================================ */
@@ -199,17 +276,16 @@ const char* get_calculation_error_message(CalculationError error);
 #define MAX_REASONABLE_MARKS 100.0f
 #define MIN_REASONABLE_MARKS 0.0f
 #define DEFAULT_PERCENTILE_PRECISION 0.01f
+#define MARKS_FIXED_POINT_SCALE 100          // Marks are stored with two decimals
+#define MARKS_FIXED_POINT_BUCKETS 10001      // 0.00 .. 100.00 in hundredths
+#define MARKS_FIXED_POINT_TOLERANCE 0.01f    // Max drift from the two-decimal grid
+#define QUANTILE_COUNTING_THRESHOLD 4096     // Use the counting path from this size on
+#define SELECTION_SAMPLE_CUTOFF 600          // Floyd-Rivest sampling range size
 #define PERFORMANCE_EXCELLENT_THRESHOLD 90.0f
 #define PERFORMANCE_GOOD_THRESHOLD 75.0f
 #define PERFORMANCE_AVERAGE_THRESHOLD 60.0f
 
-// Grade boundaries
-#define GRADE_A_THRESHOLD 90.0f
-#define GRADE_B_THRESHOLD 80.0f
-#define GRADE_C_THRESHOLD 70.0f
-#define GRADE_D_THRESHOLD 60.0f
-#define GRADE_E_THRESHOLD 40.0f
-// Below 40.0f is Grade F
+// Grade boundaries: see grading.h
 
 /* ============================================================================
  * MACROS FOR COMMON CALCULATIONS
@@ -230,6 +306,9 @@ typedef bool (*StudentFilterFunc)(Student *student, void *criteria);
 typedef int (*StudentCompareFunc)(const Student *a, const Student *b);
 typedef void (*StatisticsCallback)(const Statistics *stats, void *user_data);
 
+// Generic filtering; student_matches_query criteria take the bitmap path
+int filter_students(StudentDatabase *db, StudentFilterFunc filter, void *criteria, Student **results);
+
 /* ============================================================================
  * BATCH OPERATIONS
  * ============================================================================ */
@@ -0,0 +1,28 @@
+/*
+ * File: include/console.h
+ * Path: SchoolRecordSystem/include/console.h
+ * Description: Text-mode front end shared by the GUI binary and the headless srs_console
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+/*
+ * The console front end depends only on srs_core, so it links into the
+ * headless srs_console without pulling in GTK.
+ */
+
+// SIGINT, SIGTERM and SIGQUIT make console_mode save and return
+void signal_handler(int signal_number);
+void setup_signal_handlers(void);
+
+// Interactive menu over the records in 'data_file'
+void console_mode(const char *data_file);
+
+// Save the console database if the process exits while it is open
+void cleanup_at_exit(void);
+
+#endif // CONSOLE_H
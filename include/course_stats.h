@@ -0,0 +1,74 @@
+/*
+ * File: include/course_stats.h
+ * Path: SchoolRecordSystem/include/course_stats.h
+ * Description: Per-course score breakdowns grouped in one pass, in a hash table keyed by course
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef COURSE_STATS_H
+#define COURSE_STATS_H
+
+#include "grading.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+#define COURSE_TABLE_INITIAL_CAPACITY 64
+
+// Count, spread, extremes, passes and grades of a set of marks or scores
+typedef struct {
+    int count;
+    int passed;
+    double sum;
+    double sum_squares;
+    float lowest;
+    float highest;
+    int lowest_position;                 // Student positions (ties go to the first)
+    int highest_position;
+    int grade_counts[GRADE_COUNT];       // A, B, C, D, E, F
+} MarksBreakdown;
+
+typedef struct {
+    char *course_name;                   // NULL in an empty slot
+    MarksBreakdown scores;
+} CourseBreakdown;
+
+// Open-addressing table of breakdowns keyed by course name (under half full)
+typedef struct {
+    CourseBreakdown *slots;
+    int capacity;                        // Power of two
+    int count;
+} CourseTable;
+
+// Course table a database keeps for lookups, rebuilt on first use after a change
+typedef struct {
+    CourseTable table;
+    bool stale;                          // Set by writers
+    pthread_mutex_t lock;                // Readers rebuilding the table
+} CourseStatsCache;
+
+// Breakdowns
+void breakdown_init(MarksBreakdown *breakdown);
+void breakdown_add(MarksBreakdown *breakdown, float value, int position);
+void breakdown_merge(MarksBreakdown *into, const MarksBreakdown *from);
+float breakdown_mean(const MarksBreakdown *breakdown);
+float breakdown_variance(const MarksBreakdown *breakdown);
+float breakdown_standard_deviation(const MarksBreakdown *breakdown);
+float breakdown_pass_rate(const MarksBreakdown *breakdown);
+
+// Course tables
+void course_table_init(CourseTable *table);
+void course_table_free(CourseTable *table);
+void course_table_add(CourseTable *table, const char *course_name, float score, int position);
+void course_table_merge(CourseTable *into, const CourseTable *from);
+const CourseBreakdown* course_table_find(const CourseTable *table, const char *course_name);
+
+// The courses in name order (caller frees the array; names stay owned by the table)
+CourseBreakdown* course_table_sorted(const CourseTable *table);
+
+// Cache lifecycle
+void course_stats_cache_init(CourseStatsCache *cache);
+void course_stats_cache_free(CourseStatsCache *cache);
+
+#endif // COURSE_STATS_H
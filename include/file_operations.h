@@ -6,6 +6,9 @@
 // Default file path
 #define DEFAULT_DATA_FILE "data/students.txt"
 
+// Lines or records handled between progress reports
+#define FILE_PROGRESS_STRIDE 4096
+
 // File operation function declarations
 bool save_to_file(StudentDatabase *db, const char *filename);
 bool load_from_file(StudentDatabase *db, const char *filename);
@@ -15,6 +18,14 @@ void create_data_directory(void);
 bool export_to_csv(StudentDatabase *db, const char *filename);
 char* get_default_filename(void);
 
+// Variants for background jobs: report progress and can be stopped early
+bool load_from_file_with_progress(StudentDatabase *db, const char *filename,
+                                  StudentProgressFunc progress, void *context);
+bool export_to_csv_with_progress(StudentDatabase *db, const char *filename,
+                                 StudentProgressFunc progress, void *context);
+bool export_snapshot_to_csv(StudentDatabase *db, const Snapshot *snapshot, const char *filename,
+                            StudentProgressFunc progress, void *context);
+
 // New improved functions
 char* get_data_directory_path(void);
 char* get_data_file_path(const char *filename);
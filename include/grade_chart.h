@@ -0,0 +1,27 @@
+/*
+ * File: include/grade_chart.h
+ * Path: SchoolRecordSystem/include/grade_chart.h
+ * Description: Cairo marks histogram and density chart over the running aggregates
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef GRADE_CHART_H
+#define GRADE_CHART_H
+
+#include <gtk/gtk.h>
+#include "student.h"
+
+/*
+ * The chart draws the database's incrementally maintained 0.5-mark
+ * histogram, so a frame costs O(bins) whatever the number of students.
+ * It re-reads the histogram only after grade_chart_queue_update(), and
+ * any number of updates between two frames cost a single redraw.
+ */
+GtkWidget* grade_chart_new(StudentDatabase *db);
+
+// The marks changed; redraw on the next frame
+void grade_chart_queue_update(GtkWidget *chart);
+
+#endif // GRADE_CHART_H
@@ -0,0 +1,62 @@
+/*
+ * File: include/grading.h
+ * Path: SchoolRecordSystem/include/grading.h
+ * Description: Grading scheme: letter grade boundaries and their fixed-point lookup table
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef GRADING_H
+#define GRADING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GRADE_COUNT 6                    // A, B, C, D, E, F
+#define GRADE_BOUNDARY_COUNT 5           // Lowest marks for A .. E; F is everything below
+
+// Default boundaries; E is always the pass mark (PASSING_MARKS)
+#define GRADE_A_THRESHOLD 90.0f
+#define GRADE_B_THRESHOLD 80.0f
+#define GRADE_C_THRESHOLD 70.0f
+#define GRADE_D_THRESHOLD 60.0f
+#define GRADE_E_THRESHOLD 40.0f
+// Below 40.0f is Grade F
+
+// Lookup table grid: hundredths of a mark over 0.00 .. 100.00
+#define GRADING_TABLE_SCALE 100
+#define GRADING_TABLE_SIZE 10001
+
+typedef struct {
+    /*
+     * Descending boundaries, each rounded to a hundredth and stored as the
+     * smallest float at or above it, so 'marks >= minimums[g]' (the SIMD
+     * path) and the table always agree
+     */
+    float minimums[GRADE_BOUNDARY_COUNT];
+    uint8_t table[GRADING_TABLE_SIZE];   // Grade index per hundredth of a mark
+} GradingScheme;
+
+/*
+ * The active scheme starts as the defaults. Replace it at startup, before
+ * any database exists or other threads run: running aggregates and
+ * indexes keep the grades they were built with.
+ */
+const GradingScheme* active_grading_scheme(void);
+bool set_grading_scheme(const float minimums[GRADE_BOUNDARY_COUNT]);
+bool grading_scheme_init(GradingScheme *scheme, const float minimums[GRADE_BOUNDARY_COUNT]);
+
+// "A,B,C,D,E" lowest marks, e.g. "90,80,70,60,40"
+bool grading_boundaries_from_string(const char *text, float minimums[GRADE_BOUNDARY_COUNT]);
+
+// Per value (reentrant): index 0 = A ... 5 = F
+int grade_index_for_marks(float marks);
+char grade_letter(int grade_index);
+const char* grade_letter_for_marks(float marks);
+float grade_minimum_marks(int grade_index);
+
+// Batch: out[i] = grade index of marks[i], through the vectorized kernels
+void classify_grades(const float *marks, uint8_t *out, int n);
+
+#endif // GRADING_H
@@ -16,6 +16,10 @@
 #include "file_operations.h"
 #include "calculations.h"
 #include "memory_manager.h"
+#include "live_search.h"
+#include "job_queue.h"
+#include "student_list_model.h"
+#include "grade_chart.h"
 
 // GUI structure to hold all widgets and data
 typedef struct {
@@ -28,7 +32,7 @@ typedef struct {
 
     // Student list view
     GtkWidget *tree_view;
-    GtkListStore *list_store;
+    StudentListModel *student_model;     // Virtual rows over the database
 
     // Add/Edit student form
     GtkWidget *name_entry;
@@ -68,7 +72,7 @@ typedef struct {
     GtkWidget *median_label;
     GtkWidget *std_dev_label;
 
-    // Grade distribution chart area
+    // Grade distribution chart (marks histogram and density)
     GtkWidget *grade_chart_area;
 
     // Student details dialog
@@ -79,6 +83,7 @@ typedef struct {
     // Status bar and progress
     GtkWidget *status_bar;
     GtkWidget *progress_bar;
+    GtkWidget *cancel_job_button;        // Shown while a background job runs
     guint status_context_id;
 
     // User info and welcome
@@ -92,6 +97,19 @@ typedef struct {
     Course *selected_course;
     bool is_editing_mode;
     bool auto_save_enabled;
+    bool showing_search_results;         // List view holds name search matches only
+    guint stats_update_source;           // Pending idle refresh of the statistics labels
+
+    // Live search (worker thread reads the name indexes under index_lock)
+    LiveSearch *live_search;
+    GMutex index_lock;
+
+    // Background jobs take the database read lock; the main thread
+    // writes under the write lock and refuses changes while a job that
+    // needs the records left alone is unfinished (exports read a
+    // snapshot instead and do not count)
+    JobQueue *jobs;
+    int exclusive_jobs;
 
     // Error handling
     GtkWidget *error_dialog;
@@ -122,6 +140,7 @@ void setup_welcome_display(AppData *app);
 
 // Enhanced event handlers - main window
 void on_window_destroy(GtkWidget *widget, gpointer data);
+gboolean on_quit_signal(gpointer data);
 gboolean on_window_delete_event(GtkWidget *widget, GdkEvent *event, gpointer data);
 
 // Student management event handlers
@@ -172,8 +191,10 @@ void on_help_activate(GtkMenuItem *menuitem, gpointer data);
 
 // Display and refresh functions
 void refresh_student_list(AppData *app);
+bool jump_to_student(AppData *app, int roll_number);
 void refresh_course_list(AppData *app, Student *student);
 void update_statistics_display(AppData *app);
+void show_statistics_summary(AppData *app, const StatisticsSummary *summary);
 void update_welcome_display(AppData *app);
 
 // Form management functions
@@ -209,6 +230,7 @@ void set_status_message(AppData *app, const char *message);
 void show_progress(AppData *app, const char *message);
 void hide_progress(AppData *app);
 void update_progress(AppData *app, double fraction);
+void on_cancel_job_clicked(GtkButton *button, gpointer data);
 
 // Auto-save and loop management
 void enable_auto_save(AppData *app);
@@ -262,6 +284,8 @@ enum {
 #define GPA_DECIMAL_PLACES 2
 #define MAX_STATUS_MESSAGE_LENGTH 256
 #define AUTO_SAVE_INTERVAL_SECONDS 30
+#define FUZZY_SEARCH_MAX_RESULTS 20
+#define NAME_SEARCH_MAX_RESULTS 200
 
 // Error message constants
 #define ERROR_TITLE_VALIDATION "Validation Error"
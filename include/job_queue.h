@@ -0,0 +1,69 @@
+/*
+ * File: include/job_queue.h
+ * Path: SchoolRecordSystem/include/job_queue.h
+ * Description: Background jobs with progress, cancellation and main-loop completion
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef JOB_QUEUE_H
+#define JOB_QUEUE_H
+
+#include <glib.h>
+#include <stdbool.h>
+
+#define JOB_NAME_LENGTH 64
+
+// How a job ended
+typedef enum {
+    JOB_SUCCEEDED,
+    JOB_FAILED,
+    JOB_CANCELLED
+} JobOutcome;
+
+typedef struct Job Job;
+typedef struct JobQueue JobQueue;
+
+// Runs on the worker thread; returns false on failure
+typedef bool (*JobRunFunc)(Job *job, void *data);
+
+// Runs on the main loop once the job has stopped, whatever the outcome
+typedef void (*JobDoneFunc)(Job *job, JobOutcome outcome, void *data);
+
+// Runs on the main loop when a job starts or advances (job = NULL once the queue is idle)
+typedef void (*JobStatusFunc)(const Job *job, void *user_data);
+
+/*
+ * Jobs run one at a time, in submission order, on a worker thread. The
+ * next job starts only after the previous one's done callback has run,
+ * so a done callback can commit results to shared data without racing
+ * the next job.
+ */
+JobQueue* job_queue_new(JobStatusFunc on_status, void *user_data);
+
+// Cancel everything and wait for the running job; done callbacks are not called
+void job_queue_free(JobQueue *queue);
+
+/**
+ * Queue a job. 'free_data' (may be NULL) releases 'data' after the done
+ * callback. The returned job is valid until its done callback returns.
+ */
+Job* job_queue_submit(JobQueue *queue, const char *name, JobRunFunc run, JobDoneFunc done,
+                      void *data, GDestroyNotify free_data);
+
+// Stop the running job at its next check and drop queued ones (JOB_CANCELLED)
+void job_queue_cancel_all(JobQueue *queue);
+
+// Whether a job is running, queued or waiting for its done callback
+bool job_queue_busy(const JobQueue *queue);
+
+// Job details (any thread)
+const char* job_name(const Job *job);
+double job_progress(const Job *job);
+
+// Worker side: record progress (0.0 - 1.0); returns false once the job is cancelled
+bool job_report_progress(Job *job, double fraction);
+bool job_is_cancelled(const Job *job);
+
+#endif // JOB_QUEUE_H
@@ -0,0 +1,65 @@
+/*
+ * File: include/live_search.h
+ * Path: SchoolRecordSystem/include/live_search.h
+ * Description: Debounced, cancellable background name search for the search box
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef LIVE_SEARCH_H
+#define LIVE_SEARCH_H
+
+#include <glib.h>
+#include <stdbool.h>
+#include "student.h"
+
+// Quiet time after the last keystroke before a query starts
+#define LIVE_SEARCH_DEBOUNCE_MS 150
+
+// Rows handed to the main loop per idle callback
+#define LIVE_SEARCH_PAGE_SIZE 500
+
+// Largest result set one query collects (larger sets are truncated)
+#define LIVE_SEARCH_MAX_RESULTS 20000
+
+// How a result set was produced
+typedef enum {
+    LIVE_SEARCH_MATCHES,                 // Names containing the query, prefix matches first
+    LIVE_SEARCH_CLOSEST                  // No name contains it; closest spellings instead
+} LiveSearchKind;
+
+// One page of a finished query, delivered on the main loop
+typedef struct {
+    const int *roll_numbers;
+    int count;
+    bool first_page;                     // Replace whatever the view showed before
+    bool last_page;
+    int total;                           // Size of the whole result set
+    bool truncated;                      // More names matched than were collected
+    LiveSearchKind kind;
+    const char *query;                   // Text the results belong to
+} LiveSearchPage;
+
+typedef void (*LiveSearchPageFunc)(const LiveSearchPage *page, void *user_data);
+
+typedef struct LiveSearch LiveSearch;
+
+/**
+ * Lifecycle. The worker reads the database's name indexes while holding
+ * 'index_lock'; every main-thread change to names must hold it as well.
+ */
+LiveSearch* live_search_new(StudentDatabase *db, GMutex *index_lock,
+                            LiveSearchPageFunc on_page, void *user_data);
+void live_search_free(LiveSearch *search);
+
+// Schedule a query for the text (restarts the debounce timer, cancels older queries)
+void live_search_update(LiveSearch *search, const char *text);
+
+// Drop any pending, running or streaming query
+void live_search_cancel(LiveSearch *search);
+
+// Forget cached results after the student names changed
+void live_search_invalidate(LiveSearch *search);
+
+#endif // LIVE_SEARCH_H
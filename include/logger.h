@@ -0,0 +1,103 @@
+/*
+ * File: include/logger.h
+ * Path: SchoolRecordSystem/include/logger.h
+ * Description: Leveled diagnostics through a lock-free ring buffer and a flushing thread
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// Message severity, lowest first
+typedef enum {
+    LOG_LEVEL_TRACE,
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_OFF
+} LogLevel;
+
+/*
+ * Calls below LOG_COMPILE_LEVEL are removed by the compiler. Release
+ * builds (NDEBUG) keep INFO and above; override with
+ * -DLOG_COMPILE_LEVEL=LOG_LEVEL_WARN and so on.
+ */
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+#endif
+
+#define LOG_DEFAULT_LEVEL LOG_LEVEL_INFO
+#define LOG_LEVEL_ENV "SRS_LOG_LEVEL"        // Run-time level from the environment
+
+#define LOG_RING_SLOTS 4096                  // Queued messages (power of two)
+#define LOG_MESSAGE_LENGTH 240               // Longer messages are truncated
+#define LOG_FLUSH_INTERVAL_MS 50             // Flusher wakes at least this often
+#define LOG_SITE_BURST 20                    // Messages per call site per second
+
+// Rate limit state, one per call site (zero-initialised)
+typedef struct {
+    atomic_llong window_start;               // Start of the current second (ms)
+    atomic_int count;                        // Messages in the current second
+    atomic_int suppressed;                   // Dropped since the last one written
+} LogSite;
+
+/*
+ * Start the flushing thread. Before log_init() and after log_shutdown()
+ * messages are written synchronously, so tools that never call it still
+ * see their diagnostics. The run-time level comes from $SRS_LOG_LEVEL
+ * when set.
+ */
+bool log_init(void);
+
+// Write everything still queued and stop the flushing thread
+void log_shutdown(void);
+
+// Run-time level (any thread)
+void log_set_level(LogLevel level);
+LogLevel log_get_level(void);
+bool log_level_from_string(const char *text, LogLevel *level);
+const char* log_level_name(LogLevel level);
+
+// Destination for log lines (default stderr); the caller keeps it open
+void log_set_output(FILE *stream);
+
+// Messages lost because the ring was full
+long log_dropped_count(void);
+
+// Use the LOG_* macros instead; they add the level checks and rate limit
+void log_write(LogLevel level, LogSite *site, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+extern atomic_int log_runtime_level;
+
+#define log_enabled(level) \
+    ((level) >= LOG_COMPILE_LEVEL && \
+     (int)(level) >= atomic_load_explicit(&log_runtime_level, memory_order_relaxed))
+
+#define LOG_AT(level, ...) \
+    do { \
+        if (log_enabled(level)) { \
+            static LogSite log_site_; \
+            log_write((level), &log_site_, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_AT(LOG_LEVEL_TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // LOGGER_H
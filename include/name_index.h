@@ -0,0 +1,74 @@
+/*
+ * File: include/name_index.h
+ * Path: SchoolRecordSystem/include/name_index.h
+ * Description: Prefix and substring search over normalized student names
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "roll_index.h"
+
+// Normalized keys are never longer than this (names are at most 99 bytes)
+#define NAME_INDEX_KEY_MAX 128
+
+// Match modes for name searches
+typedef enum {
+    NAME_SEARCH_PREFIX,                  // Normalized name starts with the query
+    NAME_SEARCH_SUBSTRING                // Query occurs anywhere; prefix matches first
+} NameSearchMode;
+
+// One indexed name; superseded entries stay in place until the next rebuild
+typedef struct {
+    int roll_number;
+    uint32_t offset;                     // Start of the normalized name in 'text'
+    uint16_t length;
+    bool live;
+} NameEntry;
+
+// Suffix array over all names plus a small unsorted tail of recent changes
+typedef struct {
+    char *text;                          // Normalized names, each '\0'-terminated
+    size_t text_length;
+    size_t text_capacity;
+    NameEntry *entries;                  // Ordered by offset
+    int entry_count;
+    int entry_capacity;
+    int live_count;
+    RollIndex entry_of_roll;             // Roll number -> live entry
+    uint32_t *suffixes;                  // Sorted suffix offsets of entries [0, indexed_count)
+    size_t suffix_count;
+    int *name_order;                     // Indexed entries sorted by name
+    int name_order_count;
+    int indexed_count;                   // Entries [0, indexed_count) are in the sorted arrays
+} NameIndex;
+
+// Callback for search results; return false to stop
+typedef bool (*NameVisitor)(int roll_number, void *context);
+
+// Lifecycle
+void name_index_init(NameIndex *index);
+void name_index_free(NameIndex *index);
+void name_index_clear(NameIndex *index);
+
+// Maintenance (O(1) amortized; sorting is deferred to the next search)
+bool name_index_add(NameIndex *index, int roll_number, const char *name);
+void name_index_remove(NameIndex *index, int roll_number);
+
+// Normalized name stored for a roll number, or NULL
+const char* name_index_key(const NameIndex *index, int roll_number);
+
+// Search; visits at most max_results roll numbers and returns how many were visited
+int name_index_search(NameIndex *index, const char *query, NameSearchMode mode,
+                      int max_results, NameVisitor visitor, void *context);
+
+// Case-fold and collapse whitespace; returns the normalized length
+size_t normalize_name_key(const char *name, char *out, size_t out_size);
+
+#endif // NAME_INDEX_H
@@ -0,0 +1,63 @@
+/*
+ * File: include/rank_tree.h
+ * Path: SchoolRecordSystem/include/rank_tree.h
+ * Description: Order-statistic tree (size-augmented AVL) over (value, roll number)
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef RANK_TREE_H
+#define RANK_TREE_H
+
+#include <stdbool.h>
+
+// Sentinel for "no node"
+#define RANK_TREE_NIL (-1)
+
+// Deepest possible AVL path for any int-sized tree (bounds traversal stacks)
+#define RANK_TREE_MAX_DEPTH 64
+
+// Tree node stored in a pool; links are pool indices so the pool can grow
+typedef struct {
+    float key;                           // Ordered value (marks, GPA, ...)
+    int id;                              // Roll number, breaks ties between equal keys
+    int left;
+    int right;
+    int height;
+    int size;                            // Number of nodes in this subtree
+} RankTreeNode;
+
+// Order-statistic tree ordered by (key, id) ascending
+typedef struct {
+    RankTreeNode *nodes;                 // Node pool
+    int capacity;                        // Allocated pool slots
+    int used;                            // Pool slots handed out so far
+    int free_list;                       // Recycled slots chained through 'left'
+    int root;
+} RankTree;
+
+// Lifecycle
+void rank_tree_init(RankTree *tree);
+void rank_tree_free(RankTree *tree);
+void rank_tree_clear(RankTree *tree);
+
+// Updates, O(log n)
+bool rank_tree_insert(RankTree *tree, float key, int id);
+bool rank_tree_remove(RankTree *tree, float key, int id);
+
+// Queries, O(log n)
+int rank_tree_size(const RankTree *tree);
+bool rank_tree_select(const RankTree *tree, int k, float *key, int *id);
+int rank_tree_count_less(const RankTree *tree, float key);
+int rank_tree_count_greater(const RankTree *tree, float key);
+
+// In-order traversal; the visitor returns false to stop early
+typedef bool (*RankTreeVisitor)(float key, int id, void *context);
+int rank_tree_visit_descending(const RankTree *tree, int limit,
+                               RankTreeVisitor visitor, void *context);
+int rank_tree_visit_range(const RankTree *tree, float min_key, float max_key,
+                          RankTreeVisitor visitor, void *context);
+int rank_tree_count_range(const RankTree *tree, float min_key, float max_key);
+
+#endif // RANK_TREE_H
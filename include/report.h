@@ -0,0 +1,75 @@
+/*
+ * File: include/report.h
+ * Path: SchoolRecordSystem/include/report.h
+ * Description: Statistics reports built by a parallel scan over a snapshot
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "student.h"
+#include <stdio.h>
+
+#define REPORT_MAX_THREADS 16
+#define REPORT_MIN_RECORDS_PER_THREAD 16384  // Smaller snapshots use fewer scan threads
+#define REPORT_WRITE_BUFFER (1 << 20)        // Output buffer for report files
+
+// Output formats
+typedef enum {
+    REPORT_FORMAT_TEXT,
+    REPORT_FORMAT_CSV,
+    REPORT_FORMAT_JSON
+} ReportFormat;
+
+// Report sections (combine with |)
+typedef enum {
+    REPORT_SECTION_SUMMARY = 1 << 0,     // Counts, mean, spread, quartiles, extremes, GPA
+    REPORT_SECTION_GRADES = 1 << 1,      // Students by overall grade
+    REPORT_SECTION_COURSES = 1 << 2,     // Scores by course
+    REPORT_SECTION_STUDENTS = 1 << 3,    // Every student (text and JSON only)
+    REPORT_SECTION_ALL = 0xF
+} ReportSection;
+
+typedef struct {
+    ReportFormat format;
+    int sections;                        // ReportSection flags
+    int threads;                         // Scan threads (0: one per online CPU)
+} ReportOptions;
+
+// Everything a report needs, gathered in one pass over a snapshot
+typedef struct {
+    MarksBreakdown overall;              // Overall marks of every student
+    MarksBreakdown grades[GRADE_COUNT];  // Overall marks, by overall grade
+    Student highest;                     // At overall.highest_position (valid when overall.count > 0)
+    Student lowest;                      // At overall.lowest_position
+    double sum_gpa;                      // Over students with at least one course
+    int students_with_courses;
+    int *marks_counts;                   // MARKS_FIXED_POINT_BUCKETS: students per hundredth of a mark
+    CourseTable courses;                 // Course scores, keyed by course
+} ReportTotals;
+
+/*
+ * The pipeline: open a snapshot, scan contiguous ranges of it on worker
+ * threads into per-thread totals, merge them in range order, then format
+ * the result. The student listing is streamed from the same snapshot,
+ * so every section describes the same moment. Call without holding the
+ * database lock.
+ */
+bool collect_report_totals(StudentDatabase *db, const Snapshot *snapshot, int threads,
+                           ReportTotals *totals);
+void free_report_totals(ReportTotals *totals);
+
+bool write_report(StudentDatabase *db, const ReportOptions *options, FILE *output);
+bool write_report_file(StudentDatabase *db, const ReportOptions *options, const char *filename);
+
+// Formats: ".csv" and ".json" files get those, anything else text
+ReportFormat report_format_for_file(const char *filename);
+bool report_format_from_string(const char *name, ReportFormat *format);
+
+// Quoted, escaped JSON string (the batch results use it too)
+void write_json_string(FILE *out, const char *text);
+
+#endif // REPORT_H
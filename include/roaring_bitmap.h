@@ -0,0 +1,63 @@
+/*
+ * File: include/roaring_bitmap.h
+ * Path: SchoolRecordSystem/include/roaring_bitmap.h
+ * Description: Compressed (roaring-style) bitmap over 32-bit values
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A container switches from a sorted array to a dense bitmap above this size
+#define ROARING_ARRAY_MAX 4096
+#define ROARING_CONTAINER_WORDS 1024     // 65536 bits
+
+// All values sharing the same high 16 bits
+typedef struct {
+    uint16_t key;                        // High 16 bits of the values
+    bool is_bitmap;                      // Dense words vs sorted array
+    int cardinality;
+    int capacity;                        // Allocated array slots (array containers)
+    uint16_t *array;                     // Sorted low 16 bits (array containers)
+    uint64_t *words;                     // 1024 words (bitmap containers)
+} RoaringContainer;
+
+// Containers sorted by key
+typedef struct {
+    RoaringContainer *containers;
+    int count;
+    int capacity;
+} RoaringBitmap;
+
+// Callback for member iteration; return false to stop
+typedef bool (*RoaringVisitor)(uint32_t value, void *context);
+
+// Lifecycle
+void roaring_init(RoaringBitmap *bitmap);
+void roaring_free(RoaringBitmap *bitmap);
+void roaring_clear(RoaringBitmap *bitmap);
+bool roaring_copy(RoaringBitmap *dest, const RoaringBitmap *src);
+
+// Single-value operations
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value);
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value);
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value);
+int roaring_cardinality(const RoaringBitmap *bitmap);
+
+// Set algebra; 'out' is overwritten and must not alias an input
+bool roaring_and(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+bool roaring_or(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+bool roaring_andnot(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+
+// dest |= src, updating dest's containers in place (cheap for repeated unions)
+bool roaring_or_inplace(RoaringBitmap *dest, const RoaringBitmap *src);
+
+// Iteration in ascending order
+int roaring_visit(const RoaringBitmap *bitmap, RoaringVisitor visitor, void *context);
+
+#endif // ROARING_BITMAP_H
@@ -0,0 +1,30 @@
+/*
+ * File: include/roll_index.h
+ * Path: SchoolRecordSystem/include/roll_index.h
+ * Description: Hash index from roll number to position in the students array
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef ROLL_INDEX_H
+#define ROLL_INDEX_H
+
+#include <stdbool.h>
+
+// Open-addressing table; roll numbers are always positive so 0 marks an empty slot
+typedef struct {
+    int *keys;                           // Roll numbers (0 = empty)
+    int *positions;                      // Index into StudentDatabase.students
+    int capacity;                        // Power of two
+    int count;
+} RollIndex;
+
+void roll_index_init(RollIndex *index);
+void roll_index_free(RollIndex *index);
+void roll_index_clear(RollIndex *index);
+bool roll_index_put(RollIndex *index, int roll_number, int position);
+bool roll_index_remove(RollIndex *index, int roll_number);
+int roll_index_get(const RollIndex *index, int roll_number);
+
+#endif // ROLL_INDEX_H
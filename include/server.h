@@ -0,0 +1,38 @@
+/*
+ * File: include/server.h
+ * Path: SchoolRecordSystem/include/server.h
+ * Description: Resident query daemon over a Unix domain socket
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdbool.h>
+
+#define SERVER_DEFAULT_SOCKET "data/srs.sock"
+#define SERVER_MAX_CLIENTS 1024
+#define SERVER_INPUT_BUFFER 65536
+
+// Stop reading a client's requests while this much of its output is unsent
+#define SERVER_MAX_PENDING_OUTPUT (8 * 1024 * 1024)
+
+/*
+ * Protocol: the batch command language (see batch.h). A client writes
+ * command lines and reads NDJSON result lines; requests may be
+ * pipelined and are answered in order. 'quit' or closing the write side
+ * ends the connection once its results are sent.
+ *
+ * One event-loop thread owns the database and runs every command, so
+ * requests from different clients are serialized and never interleave.
+ */
+
+// Load 'data_file' (if it exists) and serve until SIGINT/SIGTERM; returns a process exit status
+int run_server(const char *socket_path, const char *data_file);
+
+// Connect to a running server; returns a socket descriptor or -1
+int server_connect(const char *socket_path);
+
+#endif // SERVER_H
@@ -0,0 +1,56 @@
+/*
+ * File: include/simd_kernels.h
+ * Path: SchoolRecordSystem/include/simd_kernels.h
+ * Description: Vectorized aggregate kernels over the contiguous marks column
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maximum number of thresholds a single kernel call can evaluate
+#define MAX_KERNEL_THRESHOLDS 8
+
+// Instruction set used by the kernels (selected at runtime)
+typedef enum {
+    SIMD_LEVEL_SCALAR = 0,
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_AVX2
+} SimdLevel;
+
+// Result of the fused reduction over a marks column
+typedef struct {
+    int count;
+    double sum;
+    double sum_squares;
+    float min;
+    float max;
+    int min_index;                               // First index holding min, -1 if empty
+    int max_index;                               // First index holding max, -1 if empty
+    int threshold_counts[MAX_KERNEL_THRESHOLDS]; // Elements >= each threshold
+} MarksReduction;
+
+// Runtime dispatch
+SimdLevel simd_detect_level(void);
+SimdLevel simd_active_level(void);
+void simd_set_level(SimdLevel level);
+const char* simd_level_name(SimdLevel level);
+
+// Reductions
+double marks_sum(const float *marks, int n);
+int marks_count_at_least(const float *marks, int n, float threshold);
+void marks_threshold_counts(const float *marks, int n, const float *thresholds,
+                            int threshold_count, int *counts);
+void marks_reduce(const float *marks, int n, const float *thresholds,
+                  int threshold_count, MarksReduction *out);
+
+// Bucket classification: out[i] = number of (descending) thresholds not met
+void marks_classify(const float *marks, int n, const float *thresholds,
+                    int threshold_count, uint8_t *out);
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,66 @@
+/*
+ * File: include/snapshot.h
+ * Path: SchoolRecordSystem/include/snapshot.h
+ * Description: Copy-on-write chunk store behind point-in-time views of a record array
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Records per chunk: the unit a writer copies before changing the array
+#define SNAPSHOT_CHUNK_RECORDS 64
+
+// A saved copy of one chunk, shared by every snapshot that needs it
+typedef struct {
+    int references;
+    _Alignas(max_align_t) unsigned char records[];  // SNAPSHOT_CHUNK_RECORDS records
+} SnapshotChunk;
+
+// A point-in-time view: saved chunks where the array has changed since, the live array elsewhere
+typedef struct Snapshot {
+    struct Snapshot *older;
+    struct Snapshot *newer;
+    int count;                           // Records in the array when the snapshot was opened
+    SnapshotChunk **saved;               // Per chunk; NULL while the live chunk is unchanged
+    int saved_capacity;                  // Allocated on the first copy
+} Snapshot;
+
+// Open snapshots and the version each live chunk was last preserved at
+typedef struct {
+    Snapshot *oldest;
+    Snapshot *newest;
+    size_t record_size;
+    uint64_t version;                    // Bumped by every new snapshot
+    uint64_t *chunk_versions;            // Chunks at 'version' are already saved for every snapshot
+    int chunk_capacity;
+    int saved_chunks;                    // Chunk copies currently held
+    pthread_mutex_t lock;                // Snapshot list and chunk references
+} SnapshotStore;
+
+// Lifecycle
+void snapshot_store_init(SnapshotStore *store, size_t record_size);
+void snapshot_store_free(SnapshotStore *store);
+
+/*
+ * The array's owner opens a snapshot while no writer is active (O(1))
+ * and calls snapshot_store_preserve() before every change to records
+ * [first, first + count), while no reader is using the live array. A
+ * chunk is copied at most once per snapshot generation and only for
+ * snapshots that still read it live.
+ */
+Snapshot* snapshot_store_open(SnapshotStore *store, int record_count);
+void snapshot_store_close(SnapshotStore *store, Snapshot *snapshot);
+void snapshot_store_preserve(SnapshotStore *store, const void *records, int record_count,
+                             int first, int count);
+
+// Saved copy of a chunk, or NULL if the snapshot still reads it from the live array
+const void* snapshot_saved_chunk(const Snapshot *snapshot, int chunk);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,30 @@
+/*
+ * File: include/startup_options.h
+ * Path: SchoolRecordSystem/include/startup_options.h
+ * Description: Command-line options shared by the GUI and headless front ends
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef STARTUP_OPTIONS_H
+#define STARTUP_OPTIONS_H
+
+#include <stdbool.h>
+
+// Options every front end accepts; NULL keeps the default
+typedef struct {
+    const char *log_level;               // --log-level L
+    const char *grade_boundaries;        // --grades LIST
+} StartupOptions;
+
+/*
+ * Front ends hand each argument to parse_startup_option() before their
+ * own options, then call apply_startup_options() once, before any
+ * database exists.
+ */
+bool parse_startup_option(StartupOptions *options, int argc, char *argv[], int *index);
+bool apply_startup_options(const StartupOptions *options);
+void print_startup_options_help(void);
+
+#endif // STARTUP_OPTIONS_H
@@ -14,6 +14,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include "rank_tree.h"
+#include "roll_index.h"
+#include "bitmap_index.h"
+#include "name_index.h"
+#include "trigram_index.h"
+#include "snapshot.h"
+#include "course_stats.h"
+#include "grading.h"
 
 // Constants
 #define MAX_NAME_LENGTH 100
@@ -24,6 +33,10 @@
 #define MAX_COURSES 10
 #define PASSING_MARKS 40.0
 
+// Marks histogram: 0.5-mark bins over 0-100, with 100 in a bin of its own
+#define MARKS_HISTOGRAM_BIN_WIDTH 0.5f
+#define MARKS_HISTOGRAM_BINS 201
+
 // Course structure for individual course records
 typedef struct {
     char course_name[MAX_COURSE_NAME_LENGTH];
@@ -45,15 +58,78 @@ typedef struct {
     bool is_active;                      // To track if student record is active
 } Student;
 
-// Dynamic student database structure
+// Running aggregates, updated in O(1) on every mutation
+typedef struct {
+    int count;
+    double sum_marks;
+    double sum_squares;
+    int passed_students;
+    int grade_counts[6];                 // A, B, C, D, E, F
+    int marks_histogram[MARKS_HISTOGRAM_BINS];  // Students per 0.5-mark bin
+    double sum_gpa;                      // Over students with at least one course
+    int students_with_courses;
+} RunningAggregates;
+
+// Kinds of change reported to database observers
+typedef enum {
+    STUDENT_CHANGE_ADDED,                // Appended at 'position'
+    STUDENT_CHANGE_MODIFIED,             // Name, marks, courses or GPA changed in place
+    STUDENT_CHANGE_REMOVED,              // Was at 'position'; later students moved down one
+    STUDENT_CHANGE_RESET                 // Many records or their order changed; re-read everything
+} StudentChangeKind;
+
+// One change, delivered after the database is consistent again
+typedef struct {
+    StudentChangeKind kind;
+    int roll_number;                     // Unused for STUDENT_CHANGE_RESET
+    int position;                        // Index in students (-1 for STUDENT_CHANGE_RESET)
+} StudentChange;
+
+typedef void (*StudentObserverFunc)(const StudentChange *change, void *context);
+
+typedef struct {
+    StudentObserverFunc func;
+    void *context;
+} StudentObserver;
+
+#define MAX_STUDENT_OBSERVERS 8
+
+// Progress of a long operation (0.0 - 1.0); return false to stop it early
+typedef bool (*StudentProgressFunc)(double fraction, void *context);
+
+// Dynamic student database structure. A new field holding records or an
+// index over them must also be swapped in swap_database_records().
 typedef struct {
     Student *students;
+    float *marks_column;                 // Contiguous copy of students[i].marks (same capacity)
     int count;
     int capacity;
     char last_saved_file[256];           // Track last saved file path
     bool has_unsaved_changes;            // Track if changes need saving
+    RunningAggregates aggregates;        // Incrementally maintained statistics
+    RankTree marks_tree;                 // Order statistics over (marks, roll number)
+    RankTree gpa_tree;                   // Order statistics over (GPA, roll number)
+    RollIndex roll_index;                // Roll number -> position in students
+    BitmapIndex bitmap_index;            // Compressed attribute bitmaps by roll number
+    NameIndex name_index;                // Prefix/substring search over names
+    TrigramIndex trigram_index;          // Fuzzy (misspelled) name search
+    StudentObserver observers[MAX_STUDENT_OBSERVERS];
+    int observer_count;
+    int batch_depth;                     // > 0 while a bulk change is in progress
+    bool batch_changed;                  // A change was held back during the batch
+    pthread_rwlock_t lock;               // Shared by readers, exclusive to writers
+    pthread_mutex_t writer_turnstile;    // A waiting writer holds back new readers
+    pthread_mutex_t search_lock;         // Name searches finish deferred index work
+    SnapshotStore snapshots;             // Copy-on-write chunks behind open snapshots
+    CourseStatsCache course_stats;       // Per-course breakdowns behind the course lookups
 } StudentDatabase;
 
+// A fuzzy name search hit
+typedef struct {
+    Student *student;
+    int distance;                        // Edit distance to the name (or its closest words)
+} FuzzyNameMatch;
+
 // Error codes for better error handling
 typedef enum {
     STUDENT_SUCCESS = 0,
@@ -82,6 +158,61 @@ bool is_duplicate_roll_number(StudentDatabase *db, int roll_number);
 void update_student_status(Student *student);
 int get_student_count(StudentDatabase *db);
 void clear_database(StudentDatabase *db);
+void swap_database_records(StudentDatabase *db, StudentDatabase *other);
+
+/*
+ * Thread safety: a database may be shared between threads. Hold the
+ * read lock around any query, including every use of a returned
+ * Student pointer, and the write lock around any change. Functions do
+ * not lock internally, and the locks must not be nested. (Name searches
+ * are the exception: they finish deferred index sorting and share
+ * scratch space, so concurrent readers' searches take turns.)
+ */
+void read_lock_database(StudentDatabase *db);
+void read_unlock_database(StudentDatabase *db);
+void write_lock_database(StudentDatabase *db);
+void write_unlock_database(StudentDatabase *db);
+
+// Name search over normalized (case-folded, whitespace-collapsed) names
+int search_students_by_name(StudentDatabase *db, const char *query, NameSearchMode mode,
+                            Student **results, int max_results);
+int fuzzy_search_students_by_name(StudentDatabase *db, const char *query, int max_distance,
+                                  FuzzyNameMatch *results, int k);
+
+/*
+ * Snapshots: an immutable point-in-time view of the records for long
+ * reports, while edits go on. Opening one is O(1); afterwards the first
+ * change to each chunk of SNAPSHOT_CHUNK_RECORDS records copies it for
+ * the snapshots that still see it, so memory grows with the changes.
+ * These take the read lock themselves: call them without holding it.
+ */
+Snapshot* open_student_snapshot(StudentDatabase *db);
+void close_student_snapshot(StudentDatabase *db, Snapshot *snapshot);
+int read_student_snapshot(StudentDatabase *db, const Snapshot *snapshot, int first,
+                          Student *records, int max_records);
+
+// Called for each snapshot record in position order; return false to stop
+typedef bool (*StudentVisitFunc)(const Student *student, int position, void *context);
+bool visit_student_snapshot(StudentDatabase *db, const Snapshot *snapshot,
+                            StudentVisitFunc visit, void *context);
+
+// Change notification (observers run synchronously on the mutating thread)
+bool add_student_observer(StudentDatabase *db, StudentObserverFunc func, void *context);
+void remove_student_observer(StudentDatabase *db, StudentObserverFunc func, void *context);
+void begin_student_batch(StudentDatabase *db);
+void end_student_batch(StudentDatabase *db);
+
+// Marks column maintenance (kept in step with the students array)
+void sync_marks_column(StudentDatabase *db, const Student *student);
+void rebuild_marks_column(StudentDatabase *db);
+
+// Call before changing students[first .. first + count) in place
+void preserve_student_records(StudentDatabase *db, int first, int count);
+
+// Derived state maintenance
+void refresh_student_positions(StudentDatabase *db);
+void rebuild_running_aggregates(StudentDatabase *db);
+int marks_histogram_bin(float marks);
 
 // Enhanced course operations
 StudentError add_course_to_student(StudentDatabase *db, int roll_number,
@@ -95,7 +226,7 @@ void calculate_student_gpa(Student *student);
 void calculate_overall_marks(Student *student);
 
 // Grade calculation functions
-char* calculate_grade_letter(float score);
+const char* calculate_grade_letter(float score);
 bool is_course_passing(float score);
 void update_course_status(Course *course);
 
@@ -0,0 +1,49 @@
+/*
+ * File: include/student_list_model.h
+ * Path: SchoolRecordSystem/include/student_list_model.h
+ * Description: Virtual GtkTreeModel that reads student rows straight from the database
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef STUDENT_LIST_MODEL_H
+#define STUDENT_LIST_MODEL_H
+
+#include <gtk/gtk.h>
+#include "student.h"
+
+/*
+ * Rows are never copied: a row is either a position in the database
+ * (unsorted, every student) or a roll number resolved through the roll
+ * index (search results, or a column sort chosen in the view). Columns
+ * follow the COL_* enumeration in gui.h. Views only pay for the rows they
+ * draw; pair the model with gtk_tree_view_set_fixed_height_mode().
+ */
+#define STUDENT_TYPE_LIST_MODEL (student_list_model_get_type())
+G_DECLARE_FINAL_TYPE(StudentListModel, student_list_model, STUDENT, LIST_MODEL, GObject)
+
+StudentListModel* student_list_model_new(StudentDatabase *db);
+
+/*
+ * Replace every row at once. These emit no per-row signals, so detach the
+ * model from its views first (gtk_tree_view_set_model(view, NULL)).
+ */
+void student_list_model_show_all(StudentListModel *model);
+void student_list_model_show_students(StudentListModel *model, const int *roll_numbers, int count);
+
+// Add rows to a subset view (emits row-inserted)
+void student_list_model_append_students(StudentListModel *model, const int *roll_numbers, int count);
+
+// Patch the rows after a single database change (emit row-level signals)
+void student_list_model_student_added(StudentListModel *model, int roll_number);
+void student_list_model_student_changed(StudentListModel *model, int roll_number);
+void student_list_model_student_removed(StudentListModel *model, int roll_number, int database_position);
+
+// Row showing a roll number, or -1
+int student_list_model_row_of(StudentListModel *model, int roll_number);
+
+// Whether the rows are every student rather than a subset
+bool student_list_model_shows_all(const StudentListModel *model);
+
+#endif // STUDENT_LIST_MODEL_H
@@ -0,0 +1,59 @@
+/*
+ * File: include/student_query.h
+ * Path: SchoolRecordSystem/include/student_query.h
+ * Description: Compound student predicates evaluated over the bitmap index
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef STUDENT_QUERY_H
+#define STUDENT_QUERY_H
+
+#include "student.h"
+
+// Predicate and combinator kinds
+typedef enum {
+    QUERY_PASSED,
+    QUERY_FAILED,
+    QUERY_GRADE,                         // grade: 0 = A ... 5 = F
+    QUERY_ENROLLED,                      // course_name
+    QUERY_MARKS_BELOW,                   // marks < value
+    QUERY_MARKS_AT_LEAST,                // marks >= value
+    QUERY_GPA_BELOW,                     // gpa < value
+    QUERY_GPA_AT_LEAST,                  // gpa >= value
+    QUERY_AND,
+    QUERY_OR,
+    QUERY_NOT                            // Negates 'left'
+} QueryOp;
+
+// Expression node; nodes are owned by the caller (usually stack variables)
+typedef struct StudentQuery {
+    QueryOp op;
+    int grade;
+    float value;
+    const char *course_name;
+    const struct StudentQuery *left;
+    const struct StudentQuery *right;
+} StudentQuery;
+
+// Node builders
+StudentQuery query_passed(void);
+StudentQuery query_failed(void);
+StudentQuery query_grade(int grade_index);
+StudentQuery query_enrolled(const char *course_name);
+StudentQuery query_marks_below(float value);
+StudentQuery query_marks_at_least(float value);
+StudentQuery query_gpa_below(float value);
+StudentQuery query_gpa_at_least(float value);
+StudentQuery query_and(const StudentQuery *left, const StudentQuery *right);
+StudentQuery query_or(const StudentQuery *left, const StudentQuery *right);
+StudentQuery query_not(const StudentQuery *operand);
+
+// Evaluate to a bitmap of roll numbers using the database's bitmap index
+bool evaluate_student_query(StudentDatabase *db, const StudentQuery *query, RoaringBitmap *result);
+
+// StudentFilterFunc-compatible per-student check (criteria is a StudentQuery*)
+bool student_matches_query(Student *student, void *criteria);
+
+#endif // STUDENT_QUERY_H
@@ -0,0 +1,79 @@
+/*
+ * File: include/trigram_index.h
+ * Path: SchoolRecordSystem/include/trigram_index.h
+ * Description: Trigram index for fuzzy (edit-distance) student name matching
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "roll_index.h"
+
+// Largest edit distance a search may ask for
+#define TRIGRAM_MAX_DISTANCE 4
+
+// Ids of the names containing one trigram, in ascending order
+typedef struct {
+    int *ids;
+    int count;
+    int capacity;
+} TrigramPosting;
+
+// One indexed name; removed names stay in the postings until compaction
+typedef struct {
+    int roll_number;
+    uint32_t offset;                     // Start of the normalized name in 'text'
+    uint16_t length;
+    bool live;
+} TrigramEntry;
+
+// Inverted index from padded word trigrams to name ids
+typedef struct {
+    uint32_t *keys;                      // Packed trigram + 1 (0 = empty slot)
+    TrigramPosting *postings;
+    int table_capacity;                  // Power of two
+    int table_count;
+    char *text;                          // Normalized names, each '\0'-terminated
+    size_t text_length;
+    size_t text_capacity;
+    TrigramEntry *entries;
+    int entry_count;
+    int entry_capacity;
+    int live_count;
+    RollIndex entry_of_roll;             // Roll number -> live entry
+    uint16_t *shared_counts;             // Search scratch: shared trigrams per entry
+} TrigramIndex;
+
+// A fuzzy search hit
+typedef struct {
+    int roll_number;
+    int distance;                        // Edit distance to the name or its closest words
+} TrigramMatch;
+
+// Lifecycle
+void trigram_index_init(TrigramIndex *index);
+void trigram_index_free(TrigramIndex *index);
+void trigram_index_clear(TrigramIndex *index);
+
+// Maintenance
+bool trigram_index_add(TrigramIndex *index, int roll_number, const char *name);
+void trigram_index_remove(TrigramIndex *index, int roll_number);
+
+// Top-k closest names within max_distance (negative = chosen from the query length)
+int trigram_index_search(TrigramIndex *index, const char *query, int max_distance,
+                         TrigramMatch *results, int k);
+
+// Edit distance used when the caller does not choose one
+int trigram_default_distance(const char *query);
+
+// Optimal string alignment distance (Damerau-Levenshtein with adjacent
+// transpositions); returns bound + 1 as soon as the distance must exceed bound
+int bounded_edit_distance(const char *a, size_t a_length, const char *b, size_t b_length, int bound);
+
+#endif // TRIGRAM_INDEX_H
@@ -0,0 +1,811 @@
+/*
+ * File: src/batch.c
+ * Path: SchoolRecordSystem/src/batch.c
+ * Description: Non-interactive command mode with NDJSON results for scripted pipelines
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "batch.h"
+#include "calculations.h"
+#include "file_operations.h"
+#include "logger.h"
+#include "report.h"
+#include "student_query.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BATCH_DEFAULT_SEARCH_LIMIT 20
+#define BATCH_DEFAULT_TOP 10
+
+typedef struct {
+    StudentDatabase *db;
+    FILE *out;
+    int line;                            // Script line being run
+    const char *command;
+    double started;                      // Seconds, for elapsed_ms
+    bool quit;
+} BatchSession;
+
+typedef bool (*BatchHandler)(BatchSession *session, int argc, char **argv);
+
+typedef struct {
+    const char *name;
+    int min_args;                        // Including the command itself
+    int max_args;                        // -1: no limit (rest of line)
+    BatchHandler handler;
+    const char *usage;
+} BatchCommand;
+
+static const char *sort_criteria_names[] = {
+    "marks_asc", "marks_desc", "name_asc", "name_desc", "roll_asc", "roll_desc"
+};
+
+/* ============================================================================
+ * NDJSON OUTPUT
+ * ============================================================================ */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void result_begin(BatchSession *session, bool ok) {
+    fprintf(session->out, "{\"line\":%d,\"command\":", session->line);
+    write_json_string(session->out, session->command);
+    fprintf(session->out, ",\"ok\":%s", ok ? "true" : "false");
+}
+
+static void result_end(BatchSession *session) {
+    fprintf(session->out, ",\"elapsed_ms\":%.3f}\n", (now_seconds() - session->started) * 1000.0);
+    fflush(session->out);
+}
+
+static void field_int(BatchSession *session, const char *key, long value) {
+    fprintf(session->out, ",\"%s\":%ld", key, value);
+}
+
+static void field_number(BatchSession *session, const char *key, double value) {
+    if (value != value || value > 1e300 || value < -1e300) {
+        fprintf(session->out, ",\"%s\":null", key);
+    } else {
+        fprintf(session->out, ",\"%s\":%.4f", key, value);
+    }
+}
+
+static void field_string(BatchSession *session, const char *key, const char *value) {
+    fprintf(session->out, ",\"%s\":", key);
+    write_json_string(session->out, value);
+}
+
+/**
+ * Report a failed command
+ * @return false, so handlers can 'return fail(...)'
+ */
+static bool fail(BatchSession *session, const char *message) {
+    result_begin(session, false);
+    field_string(session, "error", message);
+    result_end(session);
+    return false;
+}
+
+// One streamed record line ahead of the command's result line
+static void write_student(BatchSession *session, const Student *student) {
+    FILE *out = session->out;
+    fprintf(out, "{\"line\":%d,\"command\":", session->line);
+    write_json_string(out, session->command);
+    fprintf(out, ",\"student\":{\"roll_number\":%d,\"name\":", student->roll_number);
+    write_json_string(out, student->name);
+    fprintf(out, ",\"marks\":%.2f,\"grade\":\"%c\",\"status\":",
+            student->marks, grade_letter(grade_index_for_marks(student->marks)));
+    write_json_string(out, student->status);
+    fprintf(out, ",\"courses\":%d,\"gpa\":%.2f}}\n", student->course_count, student->gpa);
+}
+
+/* ============================================================================
+ * ARGUMENT PARSING
+ * ============================================================================ */
+
+/**
+ * Split a line into arguments in place. Double quotes group words;
+ * \" and \\ escape inside quotes.
+ * @return Argument count, or -1 for an unterminated quote
+ */
+static int tokenize(char *line, char **argv, int max_args) {
+    int argc = 0;
+    char *read = line;
+
+    while (*read) {
+        while (*read == ' ' || *read == '\t') read++;
+        if (!*read || *read == '#') break;
+        if (argc == max_args) return max_args + 1;
+
+        char *write = read;
+        argv[argc++] = write;
+        if (*read == '"') {
+            read++;
+            while (*read && *read != '"') {
+                if (*read == '\\' && (read[1] == '"' || read[1] == '\\')) read++;
+                *write++ = *read++;
+            }
+            if (*read != '"') return -1;
+            read++;
+        } else {
+            while (*read && *read != ' ' && *read != '\t') {
+                *write++ = *read++;
+            }
+        }
+        if (*read == ' ' || *read == '\t') read++;
+        *write = '\0';
+    }
+    return argc;
+}
+
+static bool parse_roll(const char *text, int *roll_number) {
+    char *end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= 0 || value > 999999) return false;
+    *roll_number = (int)value;
+    return true;
+}
+
+static bool parse_marks(const char *text, float *marks) {
+    char *end;
+    float value = strtof(text, &end);
+    if (end == text || *end != '\0') return false;
+    *marks = value;
+    return true;
+}
+
+static bool parse_limit(const char *text, int *limit) {
+    char *end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= 0 || value > 1000000) return false;
+    *limit = (int)value;
+    return true;
+}
+
+// Join argv[first..argc) with single spaces, so names need no quotes
+static void join_arguments(int argc, char **argv, int first, char *buffer, size_t size) {
+    buffer[0] = '\0';
+    for (int i = first; i < argc; i++) {
+        if (i > first) strncat(buffer, " ", size - strlen(buffer) - 1);
+        strncat(buffer, argv[i], size - strlen(buffer) - 1);
+    }
+}
+
+/* ============================================================================
+ * COMMANDS
+ * ============================================================================ */
+
+static bool cmd_load(BatchSession *session, int argc, char **argv) {
+    // load_from_file() falls back to other files; a script must name the right one
+    if (!file_exists(argv[1])) {
+        return fail(session, "File not found");
+    }
+
+    // Read into a private database, so a failed load leaves the records alone
+    StudentDatabase *incoming = create_database();
+    if (!incoming) {
+        return fail(session, "Memory allocation failed");
+    }
+    if (!load_from_file(incoming, argv[1])) {
+        destroy_database(incoming);
+        return fail(session, "Failed to load file");
+    }
+    swap_database_records(session->db, incoming);
+    destroy_database(incoming);
+
+    result_begin(session, true);
+    field_string(session, "file", argv[1]);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_import(BatchSession *session, int argc, char **argv) {
+    if (!file_exists(argv[1])) {
+        return fail(session, "File not found");
+    }
+
+    StudentDatabase *incoming = create_database();
+    if (!incoming) {
+        return fail(session, "Memory allocation failed");
+    }
+    if (!load_from_file(incoming, argv[1])) {
+        destroy_database(incoming);
+        return fail(session, "Failed to load file");
+    }
+
+    int imported = 0;
+    int skipped = 0;
+    begin_student_batch(session->db);
+    for (int i = 0; i < incoming->count; i++) {
+        const Student *student = &incoming->students[i];
+        if (add_student(session->db, student->name, student->roll_number, student->marks) == STUDENT_SUCCESS) {
+            imported++;
+        } else {
+            skipped++;
+        }
+    }
+    end_student_batch(session->db);
+    destroy_database(incoming);
+
+    result_begin(session, true);
+    field_string(session, "file", argv[1]);
+    field_int(session, "imported", imported);
+    field_int(session, "skipped", skipped);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_add(BatchSession *session, int argc, char **argv) {
+    int roll_number;
+    float marks;
+    char name[MAX_NAME_LENGTH];
+
+    if (!parse_roll(argv[1], &roll_number)) return fail(session, "Invalid roll number");
+    if (!parse_marks(argv[2], &marks)) return fail(session, "Invalid marks");
+    join_arguments(argc, argv, 3, name, sizeof(name));
+
+    StudentError error = add_student(session->db, name, roll_number, marks);
+    if (error != STUDENT_SUCCESS) {
+        return fail(session, get_error_message(error));
+    }
+
+    result_begin(session, true);
+    field_int(session, "roll_number", roll_number);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_modify(BatchSession *session, int argc, char **argv) {
+    int roll_number;
+    float marks;
+    char name[MAX_NAME_LENGTH];
+
+    if (!parse_roll(argv[1], &roll_number)) return fail(session, "Invalid roll number");
+    if (!parse_marks(argv[2], &marks)) return fail(session, "Invalid marks");
+    join_arguments(argc, argv, 3, name, sizeof(name));
+
+    StudentError error = modify_student(session->db, roll_number, name, marks);
+    if (error != STUDENT_SUCCESS) {
+        return fail(session, get_error_message(error));
+    }
+
+    result_begin(session, true);
+    field_int(session, "roll_number", roll_number);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_remove(BatchSession *session, int argc, char **argv) {
+    int roll_number;
+    if (!parse_roll(argv[1], &roll_number)) return fail(session, "Invalid roll number");
+
+    StudentError error = remove_student(session->db, roll_number);
+    if (error != STUDENT_SUCCESS) {
+        return fail(session, get_error_message(error));
+    }
+
+    result_begin(session, true);
+    field_int(session, "roll_number", roll_number);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_find(BatchSession *session, int argc, char **argv) {
+    int roll_number;
+    if (!parse_roll(argv[1], &roll_number)) return fail(session, "Invalid roll number");
+
+    Student *student = find_student(session->db, roll_number);
+    if (student) {
+        write_student(session, student);
+    }
+
+    result_begin(session, true);
+    fprintf(session->out, ",\"found\":%s", student ? "true" : "false");
+    result_end(session);
+    return true;
+}
+
+static bool cmd_search(BatchSession *session, int argc, char **argv) {
+    int limit = BATCH_DEFAULT_SEARCH_LIMIT;
+    if (argc > 2 && !parse_limit(argv[2], &limit)) {
+        return fail(session, "Invalid limit");
+    }
+
+    Student **matches = malloc((size_t)limit * sizeof(Student*));
+    if (!matches) {
+        return fail(session, "Memory allocation failed");
+    }
+
+    int found = search_students_by_name(session->db, argv[1], NAME_SEARCH_SUBSTRING, matches, limit);
+    for (int i = 0; i < found; i++) {
+        write_student(session, matches[i]);
+    }
+    free(matches);
+
+    result_begin(session, true);
+    field_string(session, "query", argv[1]);
+    field_int(session, "count", found);
+    fprintf(session->out, ",\"truncated\":%s", found == limit ? "true" : "false");
+    result_end(session);
+    return true;
+}
+
+static bool cmd_list(BatchSession *session, int argc, char **argv) {
+    int limit = session->db->count;
+    if (argc > 1 && !parse_limit(argv[1], &limit)) {
+        return fail(session, "Invalid limit");
+    }
+
+    int listed = 0;
+    for (int i = 0; i < session->db->count && listed < limit; i++) {
+        write_student(session, &session->db->students[i]);
+        listed++;
+    }
+
+    result_begin(session, true);
+    field_int(session, "count", listed);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_sort(BatchSession *session, int argc, char **argv) {
+    int criteria = -1;
+    for (int i = SORT_BY_MARKS_ASC; i <= SORT_BY_ROLL_NUMBER_DESC; i++) {
+        if (strcmp(argv[1], sort_criteria_names[i]) == 0) criteria = i;
+    }
+    if (criteria < 0) {
+        return fail(session, "Unknown sort criteria (marks_asc, marks_desc, name_asc, name_desc, roll_asc, roll_desc)");
+    }
+
+    // Stable O(n log n) order, the same path the GUI uses
+    int count = session->db->count;
+    int *order = malloc((size_t)(count > 0 ? count : 1) * sizeof(int));
+    if (!order) {
+        return fail(session, "Memory allocation failed");
+    }
+    if (count > 1) {
+        compute_sort_order(session->db, (SortCriteria)criteria, order, NULL, NULL);
+        apply_sort_order(session->db, order, count);
+    }
+    free(order);
+
+    result_begin(session, true);
+    field_string(session, "criteria", sort_criteria_names[criteria]);
+    field_int(session, "students", count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_stats(BatchSession *session, int argc, char **argv) {
+    StatisticsSummary summary = compute_statistics_summary(session->db);
+    Statistics stats = statistics_from_summary(&summary);
+    const int *distribution = summary.grade_counts;
+
+    result_begin(session, true);
+    field_int(session, "students", stats.total_students);
+    field_number(session, "average", stats.average_marks);
+    field_number(session, "median", summary.count > 0 ? calculate_median_marks(session->db) : 0.0);
+    field_number(session, "std_dev", summary.count > 0 ? calculate_standard_deviation(session->db) : 0.0);
+    field_number(session, "highest", stats.highest_marks);
+    field_number(session, "lowest", stats.lowest_marks);
+    field_int(session, "passed", stats.passed_students);
+    field_int(session, "failed", stats.failed_students);
+    field_number(session, "pass_percentage", stats.pass_percentage);
+    fprintf(session->out, ",\"grades\":{\"A\":%d,\"B\":%d,\"C\":%d,\"D\":%d,\"E\":%d,\"F\":%d}",
+            distribution[0], distribution[1], distribution[2],
+            distribution[3], distribution[4], distribution[5]);
+    result_end(session);
+    return true;
+}
+
+static void write_course_fields(FILE *out, const MarksBreakdown *stats) {
+    fprintf(out, ",\"students\":%d,\"average\":%.4f,\"variance\":%.4f,\"lowest\":%.2f,\"highest\":%.2f"
+            ",\"pass_rate\":%.4f,\"grades\":{\"A\":%d,\"B\":%d,\"C\":%d,\"D\":%d,\"E\":%d,\"F\":%d}",
+            stats->count, breakdown_mean(stats), breakdown_variance(stats), stats->lowest, stats->highest,
+            breakdown_pass_rate(stats), stats->grade_counts[0], stats->grade_counts[1],
+            stats->grade_counts[2], stats->grade_counts[3], stats->grade_counts[4], stats->grade_counts[5]);
+}
+
+// One streamed course line ahead of the command's result line
+static bool write_course(const char *course_name, const MarksBreakdown *stats, void *context) {
+    BatchSession *session = (BatchSession*)context;
+    FILE *out = session->out;
+
+    fprintf(out, "{\"line\":%d,\"command\":", session->line);
+    write_json_string(out, session->command);
+    fprintf(out, ",\"course\":{\"name\":");
+    write_json_string(out, course_name);
+    write_course_fields(out, stats);
+    fprintf(out, ",\"top_roll_number\":%d}}\n",
+            session->db->students[stats->highest_position].roll_number);
+    return true;
+}
+
+static bool cmd_courses(BatchSession *session, int argc, char **argv) {
+    if (argc > 1) {
+        MarksBreakdown stats;
+        if (!get_course_statistics(session->db, argv[1], &stats)) {
+            return fail(session, "No student takes that course");
+        }
+        result_begin(session, true);
+        field_string(session, "course", argv[1]);
+        write_course_fields(session->out, &stats);
+        field_int(session, "top_roll_number", session->db->students[stats.highest_position].roll_number);
+        result_end(session);
+        return true;
+    }
+
+    int count = visit_course_statistics(session->db, write_course, session);
+    result_begin(session, true);
+    field_int(session, "count", count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_clear(BatchSession *session, int argc, char **argv) {
+    clear_database(session->db);
+    result_begin(session, true);
+    field_int(session, "students", 0);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_export(BatchSession *session, int argc, char **argv) {
+    if (!export_to_csv(session->db, argv[1])) {
+        return fail(session, "Export failed");
+    }
+
+    result_begin(session, true);
+    field_string(session, "file", argv[1]);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_report(BatchSession *session, int argc, char **argv) {
+    ReportOptions options = {report_format_for_file(argv[1]), REPORT_SECTION_ALL, 0};
+    if (argc > 2 && !report_format_from_string(argv[2], &options.format)) {
+        return fail(session, "Unknown report format (text, csv or json)");
+    }
+    if (!write_report_file(session->db, &options, argv[1])) {
+        return fail(session, "Report failed");
+    }
+
+    static const char *format_names[] = {"text", "csv", "json"};
+    result_begin(session, true);
+    field_string(session, "file", argv[1]);
+    field_string(session, "format", format_names[options.format]);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_grades(BatchSession *session, int argc, char **argv) {
+    if (!export_grade_distribution(session->db, argv[1])) {
+        return fail(session, "Grade distribution export failed");
+    }
+
+    result_begin(session, true);
+    field_string(session, "file", argv[1]);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_save(BatchSession *session, int argc, char **argv) {
+    const char *filename = argc > 1 ? argv[1] : get_default_filename();
+    if (!save_to_file(session->db, filename)) {
+        return fail(session, "Save failed");
+    }
+
+    result_begin(session, true);
+    field_string(session, "file", filename);
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_rank(BatchSession *session, int argc, char **argv) {
+    int roll_number;
+    if (!parse_roll(argv[1], &roll_number)) return fail(session, "Invalid roll number");
+
+    int marks_rank = get_student_rank_by_marks(session->db, roll_number);
+    if (marks_rank < 0) {
+        return fail(session, get_error_message(STUDENT_ERROR_STUDENT_NOT_FOUND));
+    }
+
+    result_begin(session, true);
+    field_int(session, "roll_number", roll_number);
+    field_int(session, "marks_rank", marks_rank);
+    field_int(session, "gpa_rank", get_student_rank_by_gpa(session->db, roll_number));
+    field_int(session, "students", session->db->count);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_top(BatchSession *session, int argc, char **argv) {
+    int limit = BATCH_DEFAULT_TOP;
+    if (argc > 1 && !parse_limit(argv[1], &limit)) {
+        return fail(session, "Invalid limit");
+    }
+    if (limit > session->db->count) {
+        limit = session->db->count;
+    }
+
+    Student **top = malloc((size_t)(limit > 0 ? limit : 1) * sizeof(Student*));
+    if (!top) {
+        return fail(session, "Memory allocation failed");
+    }
+
+    int listed = 0;
+    if (limit > 0) {
+        get_top_n_students(session->db, top, limit);
+        while (listed < limit && top[listed]) {
+            write_student(session, top[listed]);
+            listed++;
+        }
+    }
+    free(top);
+
+    result_begin(session, true);
+    field_int(session, "count", listed);
+    result_end(session);
+    return true;
+}
+
+typedef struct {
+    BatchSession *session;
+    int limit;
+    int written;
+} FilterWriter;
+
+static bool write_filtered_student(uint32_t roll_number, void *context) {
+    FilterWriter *writer = context;
+    if (writer->written >= writer->limit) return false;
+
+    Student *student = find_student(writer->session->db, (int)roll_number);
+    if (student) {
+        write_student(writer->session, student);
+        writer->written++;
+    }
+    return true;
+}
+
+/**
+ * Parse one filter term into a query node
+ * @return false if the term is not recognised
+ */
+static bool parse_filter_term(const char *term, StudentQuery *query) {
+    float value;
+
+    if (strcmp(term, "passed") == 0) {
+        *query = query_passed();
+    } else if (strcmp(term, "failed") == 0) {
+        *query = query_failed();
+    } else if (strncmp(term, "grade=", 6) == 0) {
+        char letter = term[6];
+        if (letter >= 'a' && letter <= 'f') letter = (char)(letter - 'a' + 'A');
+        if (letter < 'A' || letter > 'F' || term[7] != '\0') return false;
+        *query = query_grade(letter - 'A');
+    } else if (strncmp(term, "course=", 7) == 0 && term[7]) {
+        *query = query_enrolled(term + 7);
+    } else if (strncmp(term, "marks>=", 7) == 0 && parse_marks(term + 7, &value)) {
+        *query = query_marks_at_least(value);
+    } else if (strncmp(term, "marks<", 6) == 0 && parse_marks(term + 6, &value)) {
+        *query = query_marks_below(value);
+    } else if (strncmp(term, "gpa>=", 5) == 0 && parse_marks(term + 5, &value)) {
+        *query = query_gpa_at_least(value);
+    } else if (strncmp(term, "gpa<", 4) == 0 && parse_marks(term + 4, &value)) {
+        *query = query_gpa_below(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// All terms must hold; records stream in roll number order
+static bool cmd_filter(BatchSession *session, int argc, char **argv) {
+    StudentQuery terms[BATCH_MAX_ARGS];
+    StudentQuery conjunctions[BATCH_MAX_ARGS];
+    const StudentQuery *root = NULL;
+    int limit = session->db->count;
+    int term_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "limit=", 6) == 0) {
+            if (!parse_limit(argv[i] + 6, &limit)) return fail(session, "Invalid limit");
+            continue;
+        }
+        if (!parse_filter_term(argv[i], &terms[term_count])) {
+            return fail(session, "Unknown filter term (passed, failed, grade=X, course=NAME, "
+                                 "marks>=V, marks<V, gpa>=V, gpa<V, limit=N)");
+        }
+        if (!root) {
+            root = &terms[term_count];
+        } else {
+            conjunctions[term_count] = query_and(root, &terms[term_count]);
+            root = &conjunctions[term_count];
+        }
+        term_count++;
+    }
+    if (!root) {
+        return fail(session, "Usage: filter TERM...");
+    }
+
+    RoaringBitmap matches;
+    roaring_init(&matches);
+    if (!evaluate_student_query(session->db, root, &matches)) {
+        roaring_free(&matches);
+        return fail(session, "Query evaluation failed");
+    }
+
+    FilterWriter writer = {session, limit, 0};
+    roaring_visit(&matches, write_filtered_student, &writer);
+    int total = roaring_cardinality(&matches);
+    roaring_free(&matches);
+
+    result_begin(session, true);
+    field_int(session, "count", writer.written);
+    field_int(session, "matches", total);
+    result_end(session);
+    return true;
+}
+
+static bool cmd_quit(BatchSession *session, int argc, char **argv) {
+    session->quit = true;
+    result_begin(session, true);
+    result_end(session);
+    return true;
+}
+
+static const BatchCommand commands[] = {
+    {"load",   2, 2,  cmd_load,   "load FILE"},
+    {"import", 2, 2,  cmd_import, "import FILE"},
+    {"add",    4, -1, cmd_add,    "add ROLL MARKS NAME"},
+    {"modify", 4, -1, cmd_modify, "modify ROLL MARKS NAME"},
+    {"remove", 2, 2,  cmd_remove, "remove ROLL"},
+    {"find",   2, 2,  cmd_find,   "find ROLL"},
+    {"search", 2, 3,  cmd_search, "search TEXT [LIMIT]"},
+    {"list",   1, 2,  cmd_list,   "list [LIMIT]"},
+    {"filter", 2, -1, cmd_filter, "filter TERM..."},
+    {"rank",   2, 2,  cmd_rank,   "rank ROLL"},
+    {"top",    1, 2,  cmd_top,    "top [N]"},
+    {"sort",   2, 2,  cmd_sort,   "sort CRITERIA"},
+    {"stats",  1, 1,  cmd_stats,  "stats"},
+    {"courses", 1, 2, cmd_courses, "courses [NAME]"},
+    {"clear",  1, 1,  cmd_clear,  "clear"},
+    {"export", 2, 2,  cmd_export, "export FILE"},
+    {"report", 2, 3,  cmd_report, "report FILE [text|csv|json]"},
+    {"grades", 2, 2,  cmd_grades, "grades FILE"},
+    {"save",   1, 2,  cmd_save,   "save [FILE]"},
+    {"quit",   1, 1,  cmd_quit,   "quit"},
+    {"exit",   1, 1,  cmd_quit,   "exit"}
+};
+
+#define COMMAND_COUNT ((int)(sizeof(commands) / sizeof(commands[0])))
+
+/* ============================================================================
+ * PUBLIC INTERFACE
+ * ============================================================================ */
+
+/**
+ * Run one command line. Blank and comment lines produce no output.
+ * @param db Database the command runs against
+ * @param line Command text without its newline (tokenized in place)
+ * @param line_number Reported as "line" in the results
+ * @param output Receives the result lines
+ * @param quit Set to true by 'quit'
+ * @return false if the command failed
+ */
+bool batch_execute_line(StudentDatabase *db, char *line, int line_number, FILE *output, bool *quit) {
+    BatchSession session = {db, output, line_number, "", now_seconds(), false};
+    char *argv[BATCH_MAX_ARGS];
+
+    int argc = tokenize(line, argv, BATCH_MAX_ARGS);
+    if (argc == 0) return true;
+    if (argc < 0) return fail(&session, "Unterminated quote");
+    session.command = argv[0];
+    if (argc > BATCH_MAX_ARGS) return fail(&session, "Too many arguments");
+
+    const BatchCommand *command = NULL;
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) {
+            command = &commands[i];
+            break;
+        }
+    }
+    if (!command) return fail(&session, "Unknown command");
+
+    if (argc < command->min_args || (command->max_args >= 0 && argc > command->max_args)) {
+        char usage[128];
+        snprintf(usage, sizeof(usage), "Usage: %s", command->usage);
+        return fail(&session, usage);
+    }
+
+    bool ok = command->handler(&session, argc, argv);
+    if (session.quit && quit) *quit = true;
+    return ok;
+}
+
+/**
+ * Report a line longer than BATCH_MAX_LINE (its text was discarded)
+ */
+void batch_report_overlong_line(int line_number, FILE *output) {
+    BatchSession session = {NULL, output, line_number, "", now_seconds(), false};
+    fail(&session, "Line too long");
+}
+
+/**
+ * Run a command stream. Failed commands are reported and skipped; the
+ * run stops at end of input or 'quit'.
+ * @param db Database kept resident across commands
+ * @param input Commands, one per line
+ * @param output Receives one JSON object per line
+ * @return Number of commands that failed
+ */
+int run_batch(StudentDatabase *db, FILE *input, FILE *output) {
+    char line[BATCH_MAX_LINE];
+    int line_number = 0;
+    int failures = 0;
+    bool quit = false;
+
+    while (!quit && fgets(line, sizeof(line), input)) {
+        line_number++;
+
+        size_t length = strcspn(line, "\r\n");
+        bool truncated = line[length] == '\0' && length == sizeof(line) - 1 && !feof(input);
+        line[length] = '\0';
+
+        if (truncated) {
+            int c;
+            while ((c = fgetc(input)) != EOF && c != '\n') {}
+            batch_report_overlong_line(line_number, output);
+            failures++;
+            continue;
+        }
+
+        if (!batch_execute_line(db, line, line_number, output, &quit)) {
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * Run a script on a fresh database, writing results to stdout
+ * @param script_path Script file, or "-" for stdin
+ * @return EXIT_SUCCESS if every command succeeded
+ */
+int run_batch_file(const char *script_path) {
+    FILE *input = strcmp(script_path, "-") == 0 ? stdin : fopen(script_path, "r");
+    if (!input) {
+        LOG_ERROR("Cannot open batch script: %s", script_path);
+        return EXIT_FAILURE;
+    }
+
+    StudentDatabase *db = create_database();
+    if (!db) {
+        if (input != stdin) fclose(input);
+        LOG_ERROR("Failed to create database");
+        return EXIT_FAILURE;
+    }
+
+    int failures = run_batch(db, input, stdout);
+    LOG_INFO("Batch finished with %d failed command%s", failures, failures == 1 ? "" : "s");
+
+    destroy_database(db);
+    if (input != stdin) fclose(input);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
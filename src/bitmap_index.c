@@ -0,0 +1,181 @@
+/*
+ * File: src/bitmap_index.c
+ * Path: SchoolRecordSystem/src/bitmap_index.c
+ * Description: Compressed bitmap indexes over student attributes, keyed by roll number
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Every mutation touches one bitmap per attribute, so upkeep is O(1)
+ *   container operations per student change
+ * - Marks and GPA are bucketed; queries refine the boundary buckets
+ */
+
+#include "bitmap_index.h"
+#include "student.h"
+#include "memory_manager.h"
+#include <math.h>
+
+/**
+ * Bucket for a marks value (clamped to the index range)
+ * @param marks Marks value
+ * @return Bucket number
+ */
+int bitmap_marks_bucket(float marks) {
+    int bucket = (int)floorf(marks);
+    if (bucket < 0) return 0;
+    if (bucket >= BITMAP_MARKS_BUCKETS) return BITMAP_MARKS_BUCKETS - 1;
+    return bucket;
+}
+
+/**
+ * Bucket for a GPA value (clamped to the index range)
+ * @param gpa GPA value
+ * @return Bucket number
+ */
+int bitmap_gpa_bucket(float gpa) {
+    int bucket = (int)floorf(gpa * BITMAP_GPA_BUCKET_SCALE);
+    if (bucket < 0) return 0;
+    if (bucket >= BITMAP_GPA_BUCKETS) return BITMAP_GPA_BUCKETS - 1;
+    return bucket;
+}
+
+/**
+ * Initialize an empty index
+ * @param index Index to initialize
+ */
+void bitmap_index_init(BitmapIndex *index) {
+    if (!index) return;
+
+    roaring_init(&index->all);
+    roaring_init(&index->passed);
+    for (int i = 0; i < BITMAP_GRADE_COUNT; i++) roaring_init(&index->grades[i]);
+    for (int i = 0; i < BITMAP_MARKS_BUCKETS; i++) roaring_init(&index->marks_buckets[i]);
+    for (int i = 0; i < BITMAP_GPA_BUCKETS; i++) roaring_init(&index->gpa_buckets[i]);
+    index->courses = NULL;
+    index->course_count = 0;
+    index->course_capacity = 0;
+}
+
+/**
+ * Release all bitmaps
+ * @param index Index to free
+ */
+void bitmap_index_free(BitmapIndex *index) {
+    if (!index) return;
+
+    roaring_free(&index->all);
+    roaring_free(&index->passed);
+    for (int i = 0; i < BITMAP_GRADE_COUNT; i++) roaring_free(&index->grades[i]);
+    for (int i = 0; i < BITMAP_MARKS_BUCKETS; i++) roaring_free(&index->marks_buckets[i]);
+    for (int i = 0; i < BITMAP_GPA_BUCKETS; i++) roaring_free(&index->gpa_buckets[i]);
+    for (int i = 0; i < index->course_count; i++) {
+        free(index->courses[i].course_name);
+        roaring_free(&index->courses[i].members);
+    }
+    free(index->courses);
+    bitmap_index_init(index);
+}
+
+/**
+ * Remove every member from every bitmap
+ * @param index Index to clear
+ */
+void bitmap_index_clear(BitmapIndex *index) {
+    if (!index) return;
+
+    roaring_clear(&index->all);
+    roaring_clear(&index->passed);
+    for (int i = 0; i < BITMAP_GRADE_COUNT; i++) roaring_clear(&index->grades[i]);
+    for (int i = 0; i < BITMAP_MARKS_BUCKETS; i++) roaring_clear(&index->marks_buckets[i]);
+    for (int i = 0; i < BITMAP_GPA_BUCKETS; i++) roaring_clear(&index->gpa_buckets[i]);
+    for (int i = 0; i < index->course_count; i++) {
+        roaring_clear(&index->courses[i].members);
+    }
+}
+
+/**
+ * Add or remove a student's per-value bits (status, grade, marks and GPA buckets)
+ * @param index Index to update
+ * @param roll_number Student's roll number
+ * @param marks Student's overall marks
+ * @param gpa Student's GPA
+ * @param add true to add, false to remove
+ */
+void bitmap_index_update(BitmapIndex *index, int roll_number, float marks, float gpa, bool add) {
+    if (!index || roll_number <= 0) return;
+
+    uint32_t value = (uint32_t)roll_number;
+    bool (*apply)(RoaringBitmap*, uint32_t) = add ? roaring_add : roaring_remove;
+
+    apply(&index->all, value);
+    if (marks >= PASSING_MARKS) {
+        apply(&index->passed, value);
+    }
+    apply(&index->grades[grade_index_for_marks(marks)], value);
+    apply(&index->marks_buckets[bitmap_marks_bucket(marks)], value);
+    apply(&index->gpa_buckets[bitmap_gpa_bucket(gpa)], value);
+}
+
+/**
+ * Find a course entry by name
+ * @return Entry index or -1
+ */
+static int find_course_entry(const BitmapIndex *index, const char *course_name) {
+    for (int i = 0; i < index->course_count; i++) {
+        if (strcmp(index->courses[i].course_name, course_name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Record or clear a student's enrolment in a course
+ * @param index Index to update
+ * @param course_name Course name
+ * @param roll_number Student's roll number
+ * @param enrolled true to add the student, false to remove
+ */
+void bitmap_index_set_enrolment(BitmapIndex *index, const char *course_name,
+                                int roll_number, bool enrolled) {
+    if (!index || !course_name || roll_number <= 0) return;
+
+    int entry = find_course_entry(index, course_name);
+    if (entry < 0) {
+        if (!enrolled) return;
+
+        if (index->course_count >= index->course_capacity) {
+            int new_capacity = index->course_capacity > 0 ? index->course_capacity * 2 : 8;
+            index->courses = (CourseBitmap*)safe_realloc(index->courses,
+                                                         (size_t)new_capacity * sizeof(CourseBitmap));
+            index->course_capacity = new_capacity;
+        }
+
+        entry = index->course_count++;
+        CourseBitmap *course = &index->courses[entry];
+        course->course_name = (char*)safe_malloc(strlen(course_name) + 1);
+        strcpy(course->course_name, course_name);
+        roaring_init(&course->members);
+    }
+
+    if (enrolled) {
+        roaring_add(&index->courses[entry].members, (uint32_t)roll_number);
+    } else {
+        roaring_remove(&index->courses[entry].members, (uint32_t)roll_number);
+    }
+}
+
+/**
+ * Get the member bitmap of a course
+ * @param index Index to query
+ * @param course_name Course name
+ * @return Bitmap or NULL if no student was ever enrolled
+ */
+const RoaringBitmap* bitmap_index_course(const BitmapIndex *index, const char *course_name) {
+    if (!index || !course_name) return NULL;
+
+    int entry = find_course_entry(index, course_name);
+    return (entry >= 0) ? &index->courses[entry].members : NULL;
+}
@@ -14,121 +14,228 @@
  */
 
 #include "calculations.h"
+#include "report.h"
+#include "simd_kernels.h"
+#include "logger.h"
 #include <string.h>
 #include <tgmath.h>
 
 /* ============================================================================
- * STATISTICAL CALCULATION FUNCTIONS
+ * FUSED STATISTICS KERNEL
  * ============================================================================ */
 
 /**
- * Calculate average marks for all students
+ * Recompute every database-wide aggregate in a single pass over the marks
+ * column: count, sum, min/max with their indices, pass/fail counts, mean and
+ * variance, GPA mean and the A-F histogram. The marks part runs through the
+ * vectorized kernel. Used to verify and rebuild the running aggregates.
  * @param db Student database
- * @return Average marks or 0.0 if no students
+ * @return Summary (count == 0 and indices == -1 if there are no active students)
  */
-float calculate_average_marks(StudentDatabase *db) {
-    if (!db || db->count == 0) {
-        printf("Warning: No students found for average calculation\n");
-        return 0.0f;
+StatisticsSummary scan_statistics_summary(StudentDatabase *db) {
+    StatisticsSummary summary = {0};
+    summary.highest_index = -1;
+    summary.lowest_index = -1;
+
+    if (!db || !db->students || !db->marks_column || db->count <= 0) {
+        return summary;
     }
 
-    float total = 0.0f;
-    int active_count = 0;
+    // Descending thresholds: counts of marks >= A, B, C, D, E and the pass mark
+    float thresholds[GRADE_BOUNDARY_COUNT + 1];
+    memcpy(thresholds, active_grading_scheme()->minimums, sizeof(float) * GRADE_BOUNDARY_COUNT);
+    thresholds[GRADE_BOUNDARY_COUNT] = (float)PASSING_MARKS;
+
+    // Every slot below db->count is active (remove_student compacts the array)
+    MarksReduction reduction;
+    marks_reduce(db->marks_column, db->count, thresholds, GRADE_BOUNDARY_COUNT + 1, &reduction);
+
+    summary.count = reduction.count;
+    summary.sum_marks = reduction.sum;
+    summary.highest_marks = reduction.max;
+    summary.highest_index = reduction.max_index;
+    summary.lowest_marks = reduction.min;
+    summary.lowest_index = reduction.min_index;
+    summary.passed_students = reduction.threshold_counts[5];
+    summary.failed_students = reduction.count - reduction.threshold_counts[5];
+
+    // Sum-of-squares variance; marks are bounded to [0, 100] so double
+    // accumulation keeps this well conditioned
+    summary.mean_marks = reduction.sum / reduction.count;
+    summary.m2_marks = reduction.sum_squares - reduction.sum * summary.mean_marks;
+    if (summary.m2_marks < 0.0) {
+        summary.m2_marks = 0.0;
+    }
+
+    // Histogram from the cumulative threshold counts
+    int previous = 0;
+    for (int g = 0; g < 5; g++) {
+        summary.grade_counts[g] = reduction.threshold_counts[g] - previous;
+        previous = reduction.threshold_counts[g];
+    }
+    summary.grade_counts[5] = reduction.count - previous;
 
     for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active) {
-            total += db->students[i].marks;
-            active_count++;
+        const Student *student = &db->students[i];
+        if (student->course_count > 0) {
+            summary.sum_gpa += student->gpa;
+            summary.students_with_courses++;
         }
     }
 
-    if (active_count == 0) {
-        printf("Warning: No active students found\n");
-        return 0.0f;
+    return summary;
+}
+
+/**
+ * Locate the extreme entry of the marks tree (ties go to the lowest roll number)
+ * @param db Student database
+ * @param highest true for the maximum, false for the minimum
+ * @param marks Receives the extreme marks
+ * @return Position in the students array or -1
+ */
+static int find_extreme_position(StudentDatabase *db, bool highest, float *marks) {
+    int size = rank_tree_size(&db->marks_tree);
+    int roll_number = 0;
+    float value = 0.0f;
+
+    if (!rank_tree_select(&db->marks_tree, highest ? size - 1 : 0, &value, NULL)) {
+        return -1;
     }
 
-    float average = total / active_count;
-    printf("Calculated average marks: %.2f from %d students\n", average, active_count);
-    return average;
+    // The tree orders ties by roll number; step back to the first of them
+    int first = rank_tree_count_less(&db->marks_tree, value);
+    if (!rank_tree_select(&db->marks_tree, first, &value, &roll_number)) {
+        return -1;
+    }
+
+    *marks = value;
+    return roll_index_get(&db->roll_index, roll_number);
 }
 
 /**
- * Calculate comprehensive statistics for the database
+ * Get every database-wide aggregate in O(log n) from the running aggregates
+ * kept up to date by student.c: count, sum, min/max with their indices,
+ * pass/fail counts, mean and variance, GPA mean and the A-F histogram.
+ * All other statistics functions are views over this result.
  * @param db Student database
- * @return Statistics structure with calculated values
+ * @return Summary (count == 0 and indices == -1 if there are no active students)
  */
-Statistics calculate_statistics(StudentDatabase *db) {
-    Statistics stats = {0}; // Initialize all fields to 0
+StatisticsSummary compute_statistics_summary(StudentDatabase *db) {
+    StatisticsSummary summary = {0};
+    summary.highest_index = -1;
+    summary.lowest_index = -1;
 
-    if (!db || db->count == 0) {
-        printf("Warning: No students found for statistics calculation\n");
-        return stats;
+    if (!db || db->aggregates.count <= 0) {
+        return summary;
     }
 
-    // Count active students first
-    int active_count = 0;
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active) {
-            active_count++;
-        }
+    const RunningAggregates *agg = &db->aggregates;
+
+    summary.count = agg->count;
+    summary.sum_marks = agg->sum_marks;
+    summary.passed_students = agg->passed_students;
+    summary.failed_students = agg->count - agg->passed_students;
+    summary.students_with_courses = agg->students_with_courses;
+    summary.sum_gpa = agg->sum_gpa;
+    memcpy(summary.grade_counts, agg->grade_counts, sizeof(summary.grade_counts));
+
+    summary.mean_marks = agg->sum_marks / agg->count;
+    summary.m2_marks = agg->sum_squares - agg->sum_marks * summary.mean_marks;
+    if (summary.m2_marks < 0.0) {
+        summary.m2_marks = 0.0;
     }
 
-    if (active_count == 0) {
-        printf("Warning: No active students found\n");
+    summary.highest_index = find_extreme_position(db, true, &summary.highest_marks);
+    summary.lowest_index = find_extreme_position(db, false, &summary.lowest_marks);
+
+    return summary;
+}
+
+/**
+ * Build the classic Statistics view from a summary
+ * @param summary Fused statistics summary
+ * @return Statistics structure
+ */
+Statistics statistics_from_summary(const StatisticsSummary *summary) {
+    Statistics stats = {0};
+    if (!summary || summary->count == 0) {
         return stats;
     }
 
-    stats.total_students = active_count;
-    
-    // Initialize highest and lowest with first active student's marks
-    bool first_found = false;
-    float total_marks = 0.0f;
+    stats.total_students = summary->count;
+    stats.average_marks = (float)summary->mean_marks;
+    stats.highest_marks = summary->highest_marks;
+    stats.lowest_marks = summary->lowest_marks;
+    stats.passed_students = summary->passed_students;
+    stats.failed_students = summary->failed_students;
+    stats.pass_percentage = PERCENTAGE_OF_TOTAL(summary->passed_students, summary->count);
+    return stats;
+}
 
-    for (int i = 0; i < db->count; i++) {
-        if (!db->students[i].is_active) continue;
-        
-        float marks = db->students[i].marks;
-        total_marks += marks;
-
-        // Initialize highest and lowest on first active student
-        if (!first_found) {
-            stats.highest_marks = marks;
-            stats.lowest_marks = marks;
-            first_found = true;
-        } else {
-            if (marks > stats.highest_marks) {
-                stats.highest_marks = marks;
-            }
-            if (marks < stats.lowest_marks) {
-                stats.lowest_marks = marks;
-            }
-        }
+/**
+ * Sample standard deviation from a summary
+ * @param summary Fused statistics summary
+ * @return Standard deviation or 0.0 for fewer than two students
+ */
+float summary_standard_deviation(const StatisticsSummary *summary) {
+    if (!summary || summary->count <= 1) {
+        return 0.0f;
+    }
+    return (float)sqrt(summary->m2_marks / (summary->count - 1));
+}
 
-        // Count pass/fail
-        if (marks >= PASSING_MARKS) {
-            stats.passed_students++;
-        } else {
-            stats.failed_students++;
-        }
+/**
+ * Average GPA over students with at least one course
+ * @param summary Fused statistics summary
+ * @return Average GPA or 0.0 if nobody has courses
+ */
+float summary_average_gpa(const StatisticsSummary *summary) {
+    if (!summary || summary->students_with_courses == 0) {
+        return 0.0f;
     }
+    return (float)(summary->sum_gpa / summary->students_with_courses);
+}
 
-   /*
- * File: src/calculations.c (Continued)
- * Path: SchoolRecordSystem/src/calculations.c
- * Description: Fixed statistical calculations and sorting algorithms (Part 2)
- * Author: Wisdom Chimezie
- * Date: July 20, 2025
- * Version: 2.0.0
+/* ============================================================================
+ * STATISTICAL CALCULATION FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Calculate average marks for all students
+ * @param db Student database
+ * @return Average marks or 0.0 if no students
+ */
+float calculate_average_marks(StudentDatabase *db) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+
+    if (summary.count == 0) {
+        LOG_DEBUG("No active students found for average calculation");
+        return 0.0f;
+    }
+
+    float average = (float)summary.mean_marks;
+    LOG_DEBUG("Calculated average marks: %.2f from %d students", average, summary.count);
+    return average;
+}
+
+/**
+ * Calculate comprehensive statistics for the database
+ * @param db Student database
+ * @return Statistics structure with calculated values
  */
+Statistics calculate_statistics(StudentDatabase *db) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+
+    if (summary.count == 0) {
+        LOG_DEBUG("No active students found for statistics calculation");
+        return statistics_from_summary(&summary);
+    }
 
-    // Calculate average and pass percentage
-    stats.average_marks = total_marks / stats.total_students;
-    stats.pass_percentage = (stats.total_students > 0) ?
-                           ((float)stats.passed_students / stats.total_students) * 100.0f : 0.0f;
+    Statistics stats = statistics_from_summary(&summary);
 
-    printf("Statistics calculated: Total=%d, Average=%.2f, Passed=%d, Failed=%d, Pass%%=%.1f\n",
-           stats.total_students, stats.average_marks, stats.passed_students,
-           stats.failed_students, stats.pass_percentage);
+    LOG_DEBUG("Statistics calculated: Total=%d, Average=%.2f, Passed=%d, Failed=%d, Pass%%=%.1f",
+              stats.total_students, stats.average_marks, stats.passed_students,
+              stats.failed_students, stats.pass_percentage);
 
     return stats;
 }
@@ -139,24 +246,13 @@ Statistics calculate_statistics(StudentDatabase *db) {
  * @return Pointer to student with highest marks or NULL if none found
  */
 Student* find_highest_scorer(StudentDatabase *db) {
-    if (!db || db->count == 0) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+    if (summary.highest_index < 0) {
         return NULL;
     }
 
-    Student *highest = NULL;
-    float highest_marks = -1.0f;
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].marks > highest_marks) {
-            highest_marks = db->students[i].marks;
-            highest = &db->students[i];
-        }
-    }
-
-    if (highest) {
-        printf("Highest scorer found: %s (%.2f marks)\n", highest->name, highest->marks);
-    }
-
+    Student *highest = &db->students[summary.highest_index];
+    LOG_DEBUG("Highest scorer found: %s (%.2f marks)", highest->name, highest->marks);
     return highest;
 }
 
@@ -166,24 +262,13 @@ Student* find_highest_scorer(StudentDatabase *db) {
  * @return Pointer to student with lowest marks or NULL if none found
  */
 Student* find_lowest_scorer(StudentDatabase *db) {
-    if (!db || db->count == 0) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+    if (summary.lowest_index < 0) {
         return NULL;
     }
 
-    Student *lowest = NULL;
-    float lowest_marks = 101.0f; // Start with value higher than max possible
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].marks < lowest_marks) {
-            lowest_marks = db->students[i].marks;
-            lowest = &db->students[i];
-        }
-    }
-
-    if (lowest) {
-        printf("Lowest scorer found: %s (%.2f marks)\n", lowest->name, lowest->marks);
-    }
-
+    Student *lowest = &db->students[summary.lowest_index];
+    LOG_DEBUG("Lowest scorer found: %s (%.2f marks)", lowest->name, lowest->marks);
     return lowest;
 }
 
@@ -193,17 +278,9 @@ Student* find_lowest_scorer(StudentDatabase *db) {
  * @return Number of students who passed
  */
 int count_passed_students(StudentDatabase *db) {
-    if (!db) return 0;
-
-    int count = 0;
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].marks >= PASSING_MARKS) {
-            count++;
-        }
-    }
-
-    printf("Passed students count: %d\n", count);
-    return count;
+    StatisticsSummary summary = compute_statistics_summary(db);
+    LOG_DEBUG("Passed students count: %d", summary.passed_students);
+    return summary.passed_students;
 }
 
 /**
@@ -212,20 +289,9 @@ int count_passed_students(StudentDatabase *db) {
  * @return Number of students who failed
  */
 int count_failed_students(StudentDatabase *db) {
-    if (!db) return 0;
-
-    int passed = count_passed_students(db);
-    int active_count = 0;
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active) {
-            active_count++;
-        }
-    }
-
-    int failed = active_count - passed;
-    printf("Failed students count: %d\n", failed);
-    return failed;
+    StatisticsSummary summary = compute_statistics_summary(db);
+    LOG_DEBUG("Failed students count: %d", summary.failed_students);
+    return summary.failed_students;
 }
 
 /**
@@ -234,25 +300,14 @@ int count_failed_students(StudentDatabase *db) {
  * @return Pass percentage
  */
 float calculate_pass_percentage(StudentDatabase *db) {
-    if (!db || db->count == 0) {
-        return 0.0f;
-    }
-
-    int active_count = 0;
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active) {
-            active_count++;
-        }
-    }
-
-    if (active_count == 0) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+    if (summary.count == 0) {
         return 0.0f;
     }
 
-    int passed = count_passed_students(db);
-    float percentage = ((float)passed / active_count) * 100.0f;
-
-    printf("Pass percentage calculated: %.2f%% (%d/%d)\n", percentage, passed, active_count);
+    float percentage = PERCENTAGE_OF_TOTAL(summary.passed_students, summary.count);
+    LOG_DEBUG("Pass percentage calculated: %.2f%% (%d/%d)",
+              percentage, summary.passed_students, summary.count);
     return percentage;
 }
 
@@ -453,7 +508,7 @@ void bubble_sort_names(Student *arr, int n, bool ascending) {
         }
     }
 
-    printf("Name sorting completed (%s)\n", ascending ? "ascending" : "descending");
+    LOG_DEBUG("Name sorting completed (%s)", ascending ? "ascending" : "descending");
 }
 
 /* ============================================================================
@@ -467,7 +522,7 @@ void bubble_sort_names(Student *arr, int n, bool ascending) {
  */
 void sort_students(StudentDatabase *db, SortCriteria criteria) {
     if (!db || db->count <= 1) {
-        printf("Warning: Database is empty or has only one student, no sorting needed\n");
+        LOG_DEBUG("Database is empty or has only one student, no sorting needed");
         return;
     }
 
@@ -480,52 +535,207 @@ void sort_students(StudentDatabase *db, SortCriteria criteria) {
     }
 
     if (active_count <= 1) {
-        printf("Warning: Less than 2 active students, no sorting needed\n");
+        LOG_DEBUG("Less than 2 active students, no sorting needed");
         return;
     }
 
-    printf("Sorting %d students by ", active_count);
+    preserve_student_records(db, 0, db->count);
 
     switch (criteria) {
         case SORT_BY_MARKS_ASC:
-            printf("marks (ascending)...\n");
+            LOG_DEBUG("Sorting %d students by marks (ascending)...", active_count);
             quicksort_marks(db->students, 0, db->count - 1, true);
             break;
 
         case SORT_BY_MARKS_DESC:
-            printf("marks (descending)...\n");
+            LOG_DEBUG("Sorting %d students by marks (descending)...", active_count);
             quicksort_marks(db->students, 0, db->count - 1, false);
             break;
 
         case SORT_BY_NAME_ASC:
-            printf("name (ascending)...\n");
+            LOG_DEBUG("Sorting %d students by name (ascending)...", active_count);
             bubble_sort_names(db->students, db->count, true);
             break;
 
         case SORT_BY_NAME_DESC:
-            printf("name (descending)...\n");
+            LOG_DEBUG("Sorting %d students by name (descending)...", active_count);
             bubble_sort_names(db->students, db->count, false);
             break;
 
         case SORT_BY_ROLL_NUMBER_ASC:
-            printf("roll number (ascending)...\n");
+            LOG_DEBUG("Sorting %d students by roll number (ascending)...", active_count);
             quicksort_roll_numbers(db->students, 0, db->count - 1, true);
             break;
 
         case SORT_BY_ROLL_NUMBER_DESC:
-            printf("roll number (descending)...\n");
+            LOG_DEBUG("Sorting %d students by roll number (descending)...", active_count);
             quicksort_roll_numbers(db->students, 0, db->count - 1, false);
             break;
 
         default:
-            printf("unknown criteria, using marks ascending as default...\n");
+            LOG_WARN("Unknown sort criteria, sorting %d students by marks (ascending)...", active_count);
             quicksort_marks(db->students, 0, db->count - 1, true);
             break;
     }
 
+    // Reordering the array invalidates the column layout and roll index
+    refresh_student_positions(db);
+
     // Mark database as changed
     mark_database_changed(db);
-    printf("Sorting completed successfully\n");
+    LOG_DEBUG("Sorting completed successfully");
+}
+
+/* ============================================================================
+ * ORDER-BASED SORTING (SAFE TO RUN OFF THE MAIN THREAD)
+ * ============================================================================ */
+
+// Records merged between progress reports
+#define SORT_PROGRESS_STRIDE 65536
+
+/**
+ * Compare two students by a criteria; equal students compare as 0 so the
+ * stable merge keeps their current order
+ */
+static int compare_for_criteria(const StudentDatabase *db, SortCriteria criteria, int a, int b) {
+    const Student *x = &db->students[a];
+    const Student *y = &db->students[b];
+    int order;
+
+    switch (criteria) {
+        case SORT_BY_NAME_ASC:
+        case SORT_BY_NAME_DESC:
+            order = strcmp(x->name, y->name);
+            break;
+        case SORT_BY_ROLL_NUMBER_ASC:
+        case SORT_BY_ROLL_NUMBER_DESC:
+            order = (x->roll_number > y->roll_number) - (x->roll_number < y->roll_number);
+            break;
+        default:
+            order = (db->marks_column[a] > db->marks_column[b]) - (db->marks_column[a] < db->marks_column[b]);
+            break;
+    }
+
+    bool descending = criteria == SORT_BY_MARKS_DESC || criteria == SORT_BY_NAME_DESC ||
+                      criteria == SORT_BY_ROLL_NUMBER_DESC;
+    return descending ? -order : order;
+}
+
+static void merge_positions(const StudentDatabase *db, SortCriteria criteria,
+                            const int *from, int *to, int low, int middle, int high) {
+    int left = low;
+    int right = middle;
+
+    for (int out = low; out < high; out++) {
+        if (left < middle && (right >= high ||
+                              compare_for_criteria(db, criteria, from[left], from[right]) <= 0)) {
+            to[out] = from[left++];
+        } else {
+            to[out] = from[right++];
+        }
+    }
+}
+
+/**
+ * Work out the sorted order of the students without moving them. The
+ * database is only read, so this can run on a worker thread while other
+ * threads read too. Bottom-up merge sort: O(n log n), stable.
+ * @param db Student database
+ * @param criteria Sorting criteria
+ * @param order Receives db->count positions, in sorted order
+ * @param progress Called between merge runs (may be NULL); returning false stops the sort
+ * @param context Passed to progress
+ * @return true if the order is complete, false if stopped or out of memory
+ */
+bool compute_sort_order(const StudentDatabase *db, SortCriteria criteria, int *order,
+                        StudentProgressFunc progress, void *context) {
+    if (!db || !order) return false;
+
+    int n = db->count;
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    if (n <= 1) {
+        return !progress || progress(1.0, context);
+    }
+
+    int *scratch = (int*)malloc((size_t)n * sizeof(int));
+    if (!scratch) return false;
+
+    int passes = 0;
+    for (int width = 1; width < n; width *= 2) {
+        passes++;
+    }
+
+    int *from = order;
+    int *to = scratch;
+    int pass = 0;
+    bool completed = true;
+
+    for (int width = 1; width < n && completed; width *= 2, pass++) {
+        int since_report = 0;
+        for (int low = 0; low < n && completed; low += 2 * width) {
+            int middle = low + width < n ? low + width : n;
+            int high = middle + width < n ? middle + width : n;
+            merge_positions(db, criteria, from, to, low, middle, high);
+
+            since_report += high - low;
+            if (progress && since_report >= SORT_PROGRESS_STRIDE) {
+                since_report = 0;
+                completed = progress((pass + (double)high / n) / passes, context);
+            }
+        }
+
+        int *swap = from;
+        from = to;
+        to = swap;
+
+        if (completed && progress) {
+            completed = progress((double)(pass + 1) / passes, context);
+        }
+    }
+
+    if (completed && from != order) {
+        memcpy(order, from, (size_t)n * sizeof(int));
+    }
+    free(scratch);
+    return completed;
+}
+
+/**
+ * Move the students into an order from compute_sort_order(), in place by
+ * following the permutation's cycles, then rebuild the position indexes
+ * @param db Student database (unchanged since the order was computed)
+ * @param order Positions in their new order
+ * @param count Number of positions (must equal db->count)
+ * @return true on success
+ */
+bool apply_sort_order(StudentDatabase *db, const int *order, int count) {
+    if (!db || !order || count != db->count) return false;
+
+    bool *placed = (bool*)calloc((size_t)(count > 0 ? count : 1), sizeof(bool));
+    if (!placed) return false;
+    preserve_student_records(db, 0, count);
+
+    for (int start = 0; start < count; start++) {
+        if (placed[start]) continue;
+
+        // Slot i takes the student from order[i]; walk the cycle through 'start'
+        Student held = db->students[start];
+        int slot = start;
+        while (order[slot] != start) {
+            db->students[slot] = db->students[order[slot]];
+            placed[slot] = true;
+            slot = order[slot];
+        }
+        db->students[slot] = held;
+        placed[slot] = true;
+    }
+    free(placed);
+
+    refresh_student_positions(db);
+    mark_database_changed(db);
+    return true;
 }
 
 /* ============================================================================
@@ -542,90 +752,159 @@ float calculate_median_marks(StudentDatabase *db) {
         return 0.0f;
     }
 
-    // Create a temporary array of active student marks
-    float *marks = malloc(db->count * sizeof(float));
-    if (!marks) {
-        printf("Error: Memory allocation failed for median calculation\n");
+    float median = calculate_percentile_marks(db, 50.0f);
+    LOG_DEBUG("Median marks calculated: %.2f", median);
+    return median;
+}
+
+/**
+ * Calculate a single percentile of the active students' marks
+ * @param db Student database
+ * @param percentile Percentile to compute (0-100)
+ * @return Interpolated percentile value or 0.0 if no students
+ */
+float calculate_percentile_marks(StudentDatabase *db, float percentile) {
+    float result = 0.0f;
+    if (calculate_marks_quantiles(db, &percentile, &result, 1) != CALC_SUCCESS) {
         return 0.0f;
     }
+    return result;
+}
+
+/**
+ * Map a percentile to its interpolation rank over count sorted values
+ * @param percentile Percentile (clamped to 0-100)
+ * @param count Number of values
+ * @return Fractional 0-based rank
+ */
+static double percentile_rank(float percentile, int count) {
+    if (percentile < 0.0f) percentile = 0.0f;
+    if (percentile > 100.0f) percentile = 100.0f;
+    return ((double)percentile / 100.0) * (count - 1);
+}
+
+/**
+ * Answer percentile queries from the marks rank tree in O(log n) each
+ * @param tree Order-statistic tree over the marks
+ * @param percentiles Requested percentiles (0-100)
+ * @param results Output array
+ * @param n Number of requested percentiles
+ */
+static void quantiles_from_rank_tree(const RankTree *tree, const float *percentiles,
+                                     float *results, int n) {
+    int count = rank_tree_size(tree);
+
+    for (int i = 0; i < n; i++) {
+        double rank = percentile_rank(percentiles[i], count);
+        int lower = (int)floor(rank);
+        int upper = (lower + 1 < count) ? lower + 1 : lower;
+        float low_value = 0.0f;
+        float high_value = 0.0f;
+
+        rank_tree_select(tree, lower, &low_value, NULL);
+        rank_tree_select(tree, upper, &high_value, NULL);
+        results[i] = (float)(low_value + (high_value - low_value) * (rank - lower));
+    }
+}
+
+/**
+ * Calculate several percentiles of the active students' marks at once.
+ * Reads the marks rank tree when it is in sync with the database; otherwise
+ * uses the fixed-point counting path for large databases and multi-rank
+ * selection for small ones.
+ * @param db Student database
+ * @param percentiles Requested percentiles (0-100), any order
+ * @param results Output array receiving one value per requested percentile
+ * @param n Number of requested percentiles
+ * @return CalculationError code
+ */
+CalculationError calculate_marks_quantiles(StudentDatabase *db, const float *percentiles,
+                                           float *results, int n) {
+    if (!db || !percentiles || !results || n <= 0) {
+        return CALC_ERROR_NULL_POINTER;
+    }
+
+    if (db->count > 0 && rank_tree_size(&db->marks_tree) == db->count) {
+        quantiles_from_rank_tree(&db->marks_tree, percentiles, results, n);
+        return CALC_SUCCESS;
+    }
+
+    float *marks = malloc((db->count > 0 ? db->count : 1) * sizeof(float));
+    if (!marks) {
+        LOG_ERROR("Memory allocation failed for quantile calculation");
+        return CALC_ERROR_INVALID_DATA;
+    }
 
     int active_count = 0;
     for (int i = 0; i < db->count; i++) {
         if (db->students[i].is_active) {
-            marks[active_count] = db->students[i].marks;
-            active_count++;
+            marks[active_count++] = db->students[i].marks;
         }
     }
 
     if (active_count == 0) {
         free(marks);
-        return 0.0f;
+        for (int i = 0; i < n; i++) {
+            results[i] = 0.0f;
+        }
+        return CALC_ERROR_EMPTY_DATABASE;
     }
 
-    // Sort the marks array (simple bubble sort for small arrays)
-    for (int i = 0; i < active_count - 1; i++) {
-        for (int j = 0; j < active_count - i - 1; j++) {
-            if (marks[j] > marks[j + 1]) {
-                float temp = marks[j];
-                marks[j] = marks[j + 1];
-                marks[j + 1] = temp;
-            }
-        }
+    bool counted = false;
+    if (active_count >= QUANTILE_COUNTING_THRESHOLD) {
+        counted = calculate_quantiles_by_counting(marks, active_count, percentiles, results, n);
     }
 
-    float median;
-    if (active_count % 2 == 0) {
-        // Even number of elements
-        median = (marks[active_count / 2 - 1] + marks[active_count / 2]) / 2.0f;
-    } else {
-        // Odd number of elements
-        median = marks[active_count / 2];
+    CalculationError error = CALC_SUCCESS;
+    if (!counted) {
+        error = select_percentiles(marks, active_count, percentiles, results, n);
     }
 
     free(marks);
-    printf("Median marks calculated: %.2f\n", median);
-    return median;
+    return error;
 }
 
 /**
- * Calculate standard deviation
+ * Calculate the p10/p25/p50/p75/p90 summary in one batched call
  * @param db Student database
- * @return Standard deviation
+ * @return Quantile summary (all zero if no students)
  */
-float calculate_standard_deviation(StudentDatabase *db) {
-    if (!db || db->count == 0) {
-        return 0.0f;
-    }
+QuantileSummary calculate_quantile_summary(StudentDatabase *db) {
+    static const float requested[5] = {10.0f, 25.0f, 50.0f, 75.0f, 90.0f};
+    float values[5] = {0};
+    QuantileSummary summary = {0};
 
-    float mean = calculate_average_marks(db);
-    if (mean == 0.0f) {
-        return 0.0f;
+    if (calculate_marks_quantiles(db, requested, values, 5) != CALC_SUCCESS) {
+        return summary;
     }
 
-    float sum_squared_diff = 0.0f;
-    int active_count = 0;
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active) {
-            float diff = db->students[i].marks - mean;
-            sum_squared_diff += diff * diff;
-            active_count++;
-        }
-    }
+    summary.p10 = values[0];
+    summary.p25 = values[1];
+    summary.p50 = values[2];
+    summary.p75 = values[3];
+    summary.p90 = values[4];
+    return summary;
+}
 
-    if (active_count <= 1) {
+/**
+ * Calculate standard deviation
+ * @param db Student database
+ * @return Standard deviation
+ */
+float calculate_standard_deviation(StudentDatabase *db) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+    if (summary.count <= 1) {
         return 0.0f;
     }
 
-    float variance = sum_squared_diff / (active_count - 1);
-    float std_dev = sqrt(variance);
-
-    printf("Standard deviation calculated: %.2f\n", std_dev);
+    float std_dev = summary_standard_deviation(&summary);
+    LOG_DEBUG("Standard deviation calculated: %.2f", std_dev);
     return std_dev;
 }
 
 /**
- * Get grade distribution
+ * Get grade distribution. The running aggregates count each student under
+ * the grade the grading table gave it when it changed, so this is O(1).
  * @param db Student database
  * @param distribution Array to store distribution counts [A, B, C, D, E, F]
  */
@@ -634,27 +913,14 @@ void get_grade_distribution(StudentDatabase *db, int distribution[6]) {
         return;
     }
 
-    // Initialize distribution array
+    StatisticsSummary summary = compute_statistics_summary(db);
     for (int i = 0; i < 6; i++) {
-        distribution[i] = 0;
-    }
-
-    for (int i = 0; i < db->count; i++) {
-        if (!db->students[i].is_active) continue;
-
-        float marks = db->students[i].marks;
-
-        if (marks >= 90.0f) distribution[0]++;      // A
-        else if (marks >= 80.0f) distribution[1]++; // B
-        else if (marks >= 70.0f) distribution[2]++; // C
-        else if (marks >= 60.0f) distribution[3]++; // D
-        else if (marks >= 40.0f) distribution[4]++; // E
-        else distribution[5]++;                     // F
+        distribution[i] = summary.grade_counts[i];
     }
 
-    printf("Grade distribution: A=%d, B=%d, C=%d, D=%d, E=%d, F=%d\n",
-           distribution[0], distribution[1], distribution[2],
-           distribution[3], distribution[4], distribution[5]);
+    LOG_DEBUG("Grade distribution: A=%d, B=%d, C=%d, D=%d, E=%d, F=%d",
+              distribution[0], distribution[1], distribution[2],
+              distribution[3], distribution[4], distribution[5]);
 }
 
 /* ============================================================================
@@ -667,27 +933,830 @@ void get_grade_distribution(StudentDatabase *db, int distribution[6]) {
  * @return Average GPA
  */
 float calculate_average_gpa(StudentDatabase *db) {
-    if (!db || db->count == 0) {
+    StatisticsSummary summary = compute_statistics_summary(db);
+    if (summary.students_with_courses == 0) {
         return 0.0f;
     }
 
-    float total_gpa = 0.0f;
-    int students_with_courses = 0;
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].course_count > 0) {
-            total_gpa += db->students[i].gpa;
-            students_with_courses++;
-        }
-    }
+    float average_gpa = summary_average_gpa(&summary);
+    LOG_DEBUG("Average GPA calculated: %.2f from %d students with courses",
+              average_gpa, summary.students_with_courses);
 
-    if (students_with_courses == 0) {
+    return average_gpa;
+}
+
+/* ============================================================================
+ * COURSE STATISTICS
+ * ============================================================================ */
+
+/**
+ * Add every active course of one student to a course table
+ * @param table Table to update
+ * @param student Student whose courses to add
+ * @param position The student's position (students are added in increasing order)
+ */
+void group_student_courses(CourseTable *table, const Student *student, int position) {
+    for (int c = 0; c < MAX_COURSES; c++) {
+        const Course *course = &student->courses[c];
+        if (course->is_active && course->course_name[0] != '\0') {
+            course_table_add(table, course->course_name, course->course_score, position);
+        }
+    }
+}
+
+/**
+ * The database's course breakdowns, regrouped in one pass over every
+ * student's courses if the records changed since the last call. The
+ * table stays valid while the caller keeps its read lock.
+ * @param db Student database (read lock held)
+ * @return Course table
+ */
+static const CourseTable* current_course_table(StudentDatabase *db) {
+    CourseStatsCache *cache = &db->course_stats;
+
+    // Writers only mark it stale under the write lock, so one rebuild serves every reader
+    pthread_mutex_lock(&cache->lock);
+    if (cache->stale) {
+        course_table_free(&cache->table);
+        for (int i = 0; i < db->count; i++) {
+            group_student_courses(&cache->table, &db->students[i], i);
+        }
+        cache->stale = false;
+        LOG_DEBUG("Course statistics regrouped: %d courses over %d students",
+                  cache->table.count, db->count);
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    return &cache->table;
+}
+
+/**
+ * Get the breakdown of one course: count, mean, variance, extremes with
+ * the positions holding them, passes and grades
+ * @param db Student database
+ * @param course_name Course to look up
+ * @param stats Receives the breakdown
+ * @return false if no student takes the course
+ */
+bool get_course_statistics(StudentDatabase *db, const char *course_name, MarksBreakdown *stats) {
+    if (!db || !course_name || !stats) return false;
+
+    const CourseBreakdown *course = course_table_find(current_course_table(db), course_name);
+    if (!course) {
+        return false;
+    }
+
+    *stats = course->scores;
+    return true;
+}
+
+/**
+ * Visit the breakdown of every course in name order
+ * @param db Student database
+ * @param func Called per course; return false to stop
+ * @param context Passed to func
+ * @return Number of courses visited
+ */
+int visit_course_statistics(StudentDatabase *db, CourseVisitFunc func, void *context) {
+    if (!db || !func) return 0;
+
+    const CourseTable *table = current_course_table(db);
+    CourseBreakdown *courses = course_table_sorted(table);
+    int visited = 0;
+    while (visited < table->count) {
+        const CourseBreakdown *course = &courses[visited++];
+        if (!func(course->course_name, &course->scores, context)) break;
+    }
+    free(courses);
+    return visited;
+}
+
+/**
+ * Calculate the average score in a course
+ * @param db Student database
+ * @param course_name Course name
+ * @return Average score (0 if no student takes the course)
+ */
+float calculate_course_average(StudentDatabase *db, const char *course_name) {
+    MarksBreakdown stats;
+    return get_course_statistics(db, course_name, &stats) ? breakdown_mean(&stats) : 0.0f;
+}
+
+/**
+ * Count the students taking a course
+ * @param db Student database
+ * @param course_name Course name
+ * @return Number of students
+ */
+int count_students_in_course(StudentDatabase *db, const char *course_name) {
+    MarksBreakdown stats;
+    return get_course_statistics(db, course_name, &stats) ? stats.count : 0;
+}
+
+/**
+ * Find the student with the highest score in a course (the first one on a tie)
+ * @param db Student database
+ * @param course_name Course name
+ * @return The student, or NULL if no student takes the course
+ */
+Student* find_top_performer_in_course(StudentDatabase *db, const char *course_name) {
+    MarksBreakdown stats;
+    if (!get_course_statistics(db, course_name, &stats)) {
+        return NULL;
+    }
+    return &db->students[stats.highest_position];
+}
+
+/* ============================================================================
+ * SELECTION AND QUANTILE FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Swap two floats in place
+ * @param a First value
+ * @param b Second value
+ */
+static void swap_floats(float *a, float *b) {
+    float temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * Comparison function for qsort on floats (ascending)
+ */
+static int compare_floats_ascending(const void *a, const void *b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/**
+ * Floyd-Rivest selection restricted to [left, right]. After the call,
+ * values[k] holds the k-th smallest element of the range, everything on
+ * its left is <= values[k] and everything on its right is >= values[k].
+ * Falls back to sorting the range if the sampling degenerates, which
+ * bounds the worst case at O(n log n) (introselect-style guard).
+ * @param values Array to partially reorder
+ * @param left First index of the range
+ * @param right Last index of the range
+ * @param k Target rank (left <= k <= right)
+ * @param depth_budget Remaining partition rounds before falling back
+ */
+static void floyd_rivest_select(float *values, int left, int right, int k, int depth_budget) {
+    while (right > left) {
+        if (depth_budget-- <= 0) {
+            qsort(values + left, (size_t)(right - left + 1), sizeof(float), compare_floats_ascending);
+            return;
+        }
+
+        // Narrow the range around k using a recursive sample
+        if (right - left > SELECTION_SAMPLE_CUTOFF) {
+            double n = right - left + 1;
+            double i = k - left + 1;
+            double z = log(n);
+            double s = 0.5 * exp(2.0 * z / 3.0);
+            double sd = 0.5 * sqrt(z * s * (n - s) / n) * ((i - n / 2.0) < 0 ? -1.0 : 1.0);
+            int new_left = (int)fmax(left, floor(k - i * s / n + sd));
+            int new_right = (int)fmin(right, floor(k + (n - i) * s / n + sd));
+            floyd_rivest_select(values, new_left, new_right, k, depth_budget);
+        }
+
+        // Partition the range around t = values[k]
+        float t = values[k];
+        int i = left;
+        int j = right;
+
+        swap_floats(&values[left], &values[k]);
+        if (values[right] > t) {
+            swap_floats(&values[right], &values[left]);
+        }
+
+        while (i < j) {
+            swap_floats(&values[i], &values[j]);
+            i++;
+            j--;
+            while (values[i] < t) i++;
+            while (values[j] > t) j--;
+        }
+
+        if (values[left] == t) {
+            swap_floats(&values[left], &values[j]);
+        } else {
+            j++;
+            swap_floats(&values[j], &values[right]);
+        }
+
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+/**
+ * Compute the partition round budget for a selection over n elements
+ * @param n Number of elements
+ * @return Round budget (2 * log2(n) + a small constant)
+ */
+static int selection_depth_budget(int n) {
+    int budget = 8;
+    while (n > 1) {
+        budget += 2;
+        n >>= 1;
+    }
+    return budget;
+}
+
+/**
+ * Select the k-th smallest value (0-based) in expected linear time.
+ * The array is partially reordered.
+ * @param values Array of values
+ * @param count Number of values
+ * @param k Rank to select (0 <= k < count)
+ * @return The k-th smallest value or 0.0 on invalid input
+ */
+float select_kth_smallest(float *values, int count, int k) {
+    if (!values || count <= 0 || k < 0 || k >= count) {
         return 0.0f;
     }
 
-    float average_gpa = total_gpa / students_with_courses;
-    printf("Average GPA calculated: %.2f from %d students with courses\n",
-           average_gpa, students_with_courses);
+    floyd_rivest_select(values, 0, count - 1, k, selection_depth_budget(count));
+    return values[k];
+}
 
-    return average_gpa;
-}
\ No newline at end of file
+/**
+ * Calculate a percentile from an already sorted array using linear
+ * interpolation between the closest ranks
+ * @param sorted_values Values in ascending order
+ * @param count Number of values
+ * @param percentile Percentile (0-100)
+ * @return Percentile value or 0.0 on invalid input
+ */
+float calculate_percentile(float *sorted_values, int count, float percentile) {
+    if (!sorted_values || count <= 0) {
+        return 0.0f;
+    }
+
+    double rank = percentile_rank(percentile, count);
+    int lower = (int)floor(rank);
+    int upper = (lower + 1 < count) ? lower + 1 : lower;
+    double fraction = rank - lower;
+
+    return (float)(sorted_values[lower] + (sorted_values[upper] - sorted_values[lower]) * fraction);
+}
+
+/**
+ * Recursively place every requested rank at its sorted position.
+ * Each round selects the middle requested rank and splits both the value
+ * range and the rank list around it, so q ranks cost O(n log q).
+ * @param values Array of values
+ * @param left First index of the value range
+ * @param right Last index of the value range
+ * @param ranks Sorted, de-duplicated ranks inside [left, right]
+ * @param rank_count Number of ranks
+ */
+static void multi_select(float *values, int left, int right, const int *ranks, int rank_count) {
+    if (rank_count <= 0 || left >= right) {
+        return;
+    }
+
+    int middle = rank_count / 2;
+    int k = ranks[middle];
+    floyd_rivest_select(values, left, right, k, selection_depth_budget(right - left + 1));
+
+    multi_select(values, left, k - 1, ranks, middle);
+    multi_select(values, k + 1, right, ranks + middle + 1, rank_count - middle - 1);
+}
+
+/**
+ * Comparison function for qsort on ints (ascending)
+ */
+static int compare_ints_ascending(const void *a, const void *b) {
+    int ia = *(const int*)a;
+    int ib = *(const int*)b;
+    return (ia > ib) - (ia < ib);
+}
+
+/**
+ * Calculate several interpolated percentiles from unsorted values using
+ * multi-rank selection. The array is partially reordered.
+ * @param values Array of values
+ * @param count Number of values
+ * @param percentiles Requested percentiles (0-100)
+ * @param results Output array, one value per requested percentile
+ * @param n Number of requested percentiles
+ * @return CalculationError code
+ */
+CalculationError select_percentiles(float *values, int count, const float *percentiles,
+                                    float *results, int n) {
+    if (!values || !percentiles || !results || n <= 0) {
+        return CALC_ERROR_NULL_POINTER;
+    }
+    if (count <= 0) {
+        return CALC_ERROR_EMPTY_DATABASE;
+    }
+
+    // Every percentile needs its floor and ceiling rank
+    int *ranks = malloc((size_t)n * 2 * sizeof(int));
+    if (!ranks) {
+        return CALC_ERROR_INVALID_DATA;
+    }
+
+    int rank_count = 0;
+    for (int i = 0; i < n; i++) {
+        double rank = percentile_rank(percentiles[i], count);
+        int lower = (int)floor(rank);
+        ranks[rank_count++] = lower;
+        if (lower + 1 < count) {
+            ranks[rank_count++] = lower + 1;
+        }
+    }
+
+    qsort(ranks, (size_t)rank_count, sizeof(int), compare_ints_ascending);
+    int unique = 0;
+    for (int i = 0; i < rank_count; i++) {
+        if (unique == 0 || ranks[unique - 1] != ranks[i]) {
+            ranks[unique++] = ranks[i];
+        }
+    }
+
+    multi_select(values, 0, count - 1, ranks, unique);
+    free(ranks);
+
+    // Selected ranks are now in their sorted positions
+    for (int i = 0; i < n; i++) {
+        results[i] = calculate_percentile(values, count, percentiles[i]);
+    }
+
+    return CALC_SUCCESS;
+}
+
+/**
+ * Exact percentiles via a counting pass over fixed-point marks.
+ * Marks are stored with two decimals in [0, 100], so 10001 buckets of
+ * hundredths hold every distinct value and the quantiles fall out of one
+ * prefix walk. Returns false (leaving results untouched) if any value is
+ * off the two-decimal grid, e.g. averaged course scores.
+ * @param values Array of marks
+ * @param count Number of values
+ * @param percentiles Requested percentiles (0-100)
+ * @param results Output array, one value per requested percentile
+ * @param n Number of requested percentiles
+ * @return true if the counting path applied, false otherwise
+ */
+bool calculate_quantiles_by_counting(const float *values, int count, const float *percentiles,
+                                     float *results, int n) {
+    if (!values || !percentiles || !results || count <= 0 || n <= 0) {
+        return false;
+    }
+
+    int *buckets = calloc(MARKS_FIXED_POINT_BUCKETS, sizeof(int));
+    if (!buckets) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        float scaled = values[i] * MARKS_FIXED_POINT_SCALE;
+        long bucket = lroundf(scaled);
+        if (bucket < 0 || bucket >= MARKS_FIXED_POINT_BUCKETS ||
+            fabsf(scaled - (float)bucket) > MARKS_FIXED_POINT_TOLERANCE) {
+            free(buckets);
+            return false;
+        }
+        buckets[bucket]++;
+    }
+
+    calculate_quantiles_from_counts(buckets, count, percentiles, results, n);
+    free(buckets);
+    return true;
+}
+
+/**
+ * Interpolated percentiles from counts per hundredth of a mark
+ * @param counts MARKS_FIXED_POINT_BUCKETS counts (bucket b holds marks b / 100)
+ * @param count Total of the counts (> 0)
+ * @param percentiles Requested percentiles (0-100)
+ * @param results Output array, one value per requested percentile
+ * @param n Number of requested percentiles
+ */
+void calculate_quantiles_from_counts(const int *counts, int count, const float *percentiles,
+                                     float *results, int n) {
+    for (int p = 0; p < n; p++) {
+        double rank = percentile_rank(percentiles[p], count);
+        int lower = (int)floor(rank);
+        int upper = (lower + 1 < count) ? lower + 1 : lower;
+
+        // Walk the cumulative counts to the buckets holding both ranks
+        int seen = 0;
+        int lower_bucket = -1;
+        int upper_bucket = -1;
+        for (int b = 0; b < MARKS_FIXED_POINT_BUCKETS && upper_bucket < 0; b++) {
+            seen += counts[b];
+            if (lower_bucket < 0 && seen > lower) lower_bucket = b;
+            if (seen > upper) upper_bucket = b;
+        }
+
+        float low_value = (float)lower_bucket / MARKS_FIXED_POINT_SCALE;
+        float high_value = (float)upper_bucket / MARKS_FIXED_POINT_SCALE;
+        results[p] = (float)(low_value + (high_value - low_value) * (rank - lower));
+    }
+}
+
+/* ============================================================================
+ * RANKING FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Competition rank ("1224") of a student within one of the rank trees
+ * @param db Student database
+ * @param tree Rank tree to query
+ * @param roll_number Roll number of the student
+ * @param use_gpa true to rank by GPA, false by marks
+ * @return 1-based rank or -1 if the student does not exist
+ */
+static int rank_in_tree(StudentDatabase *db, const RankTree *tree, int roll_number, bool use_gpa) {
+    Student *student = find_student(db, roll_number);
+    if (!student) {
+        return -1;
+    }
+
+    float value = use_gpa ? student->gpa : student->marks;
+    return rank_tree_count_greater(tree, value) + 1;
+}
+
+/**
+ * Get a student's rank by marks in O(log n); equal marks share a rank
+ * @param db Student database
+ * @param roll_number Roll number of the student
+ * @return 1-based rank or -1 if the student does not exist
+ */
+int get_student_rank_by_marks(StudentDatabase *db, int roll_number) {
+    if (!db) return -1;
+    return rank_in_tree(db, &db->marks_tree, roll_number, false);
+}
+
+/**
+ * Get a student's rank by GPA in O(log n); equal GPAs share a rank
+ * @param db Student database
+ * @param roll_number Roll number of the student
+ * @return 1-based rank or -1 if the student does not exist
+ */
+int get_student_rank_by_gpa(StudentDatabase *db, int roll_number) {
+    if (!db) return -1;
+    return rank_in_tree(db, &db->gpa_tree, roll_number, true);
+}
+
+// Output cursor shared by the index-backed queries
+typedef struct {
+    StudentDatabase *db;
+    Student **results;
+    int filled;
+} StudentCollector;
+
+/**
+ * Append the student with a given roll number to a collector
+ */
+static bool collect_student_by_roll(uint32_t roll_number, void *context) {
+    StudentCollector *collector = (StudentCollector*)context;
+
+    int position = roll_index_get(&collector->db->roll_index, (int)roll_number);
+    if (position >= 0) {
+        collector->results[collector->filled++] = &collector->db->students[position];
+    }
+    return true;
+}
+
+/**
+ * Rank tree visitor adapter for collect_student_by_roll
+ */
+static bool collect_student_by_key(float key, int id, void *context) {
+    (void)key;
+    return collect_student_by_roll((uint32_t)id, context);
+}
+
+/**
+ * Get the n students with the highest marks in O(n + log count)
+ * @param db Student database
+ * @param top_students Caller-provided array of at least n pointers; slots
+ *                     beyond the number of students are set to NULL
+ * @param n Number of students requested
+ */
+void get_top_n_students(StudentDatabase *db, Student **top_students, int n) {
+    if (!db || !top_students || n <= 0) return;
+
+    StudentCollector collector = {db, top_students, 0};
+    rank_tree_visit_descending(&db->marks_tree, n, collect_student_by_key, &collector);
+
+    for (int i = collector.filled; i < n; i++) {
+        top_students[i] = NULL;
+    }
+}
+
+/* ============================================================================
+ * SEARCH AND FILTER FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Find students whose marks fall in [min_marks, max_marks] using the marks
+ * rank tree: O(log n + k). Results are ordered by ascending marks.
+ * @param db Student database
+ * @param min_marks Inclusive lower bound
+ * @param max_marks Inclusive upper bound
+ * @param results Caller-provided buffer with room for get_student_count(db)
+ *                pointers, or NULL to only count matches in O(log n)
+ * @return Number of matching students
+ */
+int find_students_by_grade_range(StudentDatabase *db, float min_marks, float max_marks, Student **results) {
+    if (!db) return 0;
+
+    if (!results) {
+        return rank_tree_count_range(&db->marks_tree, min_marks, max_marks);
+    }
+
+    StudentCollector collector = {db, results, 0};
+    rank_tree_visit_range(&db->marks_tree, min_marks, max_marks, collect_student_by_key, &collector);
+    return collector.filled;
+}
+
+/**
+ * Find students by overall status ("Pass" or "Fail") using the compressed
+ * status bitmaps. Results are ordered by roll number.
+ * @param db Student database
+ * @param status "Pass" or "Fail"
+ * @param results Caller-provided buffer with room for get_student_count(db)
+ *                pointers, or NULL to only count matches in O(1)
+ * @return Number of matching students (0 for an unknown status)
+ */
+int find_students_by_status(StudentDatabase *db, const char *status, Student **results) {
+    if (!db || !status) return 0;
+
+    bool want_pass = strcmp(status, "Pass") == 0;
+    if (!want_pass && strcmp(status, "Fail") != 0) {
+        return 0;
+    }
+
+    const BitmapIndex *index = &db->bitmap_index;
+    if (!results) {
+        int passed = roaring_cardinality(&index->passed);
+        return want_pass ? passed : roaring_cardinality(&index->all) - passed;
+    }
+
+    StudentCollector collector = {db, results, 0};
+    if (want_pass) {
+        roaring_visit(&index->passed, collect_student_by_roll, &collector);
+    } else {
+        RoaringBitmap failed;
+        roaring_init(&failed);
+        roaring_andnot(&index->all, &index->passed, &failed);
+        roaring_visit(&failed, collect_student_by_roll, &collector);
+        roaring_free(&failed);
+    }
+    return collector.filled;
+}
+
+/**
+ * Find students with a GPA strictly above a threshold using the GPA rank
+ * tree: O(log n + k). Results are ordered by ascending GPA.
+ * @param db Student database
+ * @param min_gpa Exclusive lower bound
+ * @param results Caller-provided buffer with room for get_student_count(db)
+ *                pointers, or NULL to only count matches in O(log n)
+ * @return Number of matching students
+ */
+int find_students_with_gpa_above(StudentDatabase *db, float min_gpa, Student **results) {
+    if (!db) return 0;
+
+    if (!results) {
+        return rank_tree_count_greater(&db->gpa_tree, min_gpa);
+    }
+
+    StudentCollector collector = {db, results, 0};
+    rank_tree_visit_range(&db->gpa_tree, nextafterf(min_gpa, INFINITY), INFINITY,
+                          collect_student_by_key, &collector);
+    return collector.filled;
+}
+
+/**
+ * Find students matching a compound query over the bitmap index. Leaf
+ * predicates resolve to stored bitmaps and combinators run container by
+ * container, so cost tracks the compressed bitmap sizes rather than a
+ * scan of every record. Results are ordered by roll number.
+ * @param db Student database
+ * @param query Root of the query expression
+ * @param results Caller-provided buffer with room for get_student_count(db)
+ *                pointers, or NULL to only count matches
+ * @return Number of matching students (0 for a malformed query)
+ */
+int find_students_by_query(StudentDatabase *db, const StudentQuery *query, Student **results) {
+    if (!db || !query) return 0;
+
+    RoaringBitmap matches;
+    roaring_init(&matches);
+
+    int found = 0;
+    if (evaluate_student_query(db, query, &matches)) {
+        if (results) {
+            StudentCollector collector = {db, results, 0};
+            roaring_visit(&matches, collect_student_by_roll, &collector);
+            found = collector.filled;
+        } else {
+            found = roaring_cardinality(&matches);
+        }
+    }
+
+    roaring_free(&matches);
+    return found;
+}
+
+/**
+ * Collect the students accepted by a filter callback. Passing
+ * student_matches_query as the filter evaluates the query through the
+ * bitmap index; any other filter is applied to each student in turn.
+ * @param db Student database
+ * @param filter Predicate applied to each student
+ * @param criteria Opaque argument forwarded to the filter
+ * @param results Caller-provided buffer with room for get_student_count(db)
+ *                pointers, or NULL to only count matches
+ * @return Number of matching students
+ */
+int filter_students(StudentDatabase *db, StudentFilterFunc filter, void *criteria, Student **results) {
+    if (!db || !filter) return 0;
+
+    if (filter == student_matches_query) {
+        return find_students_by_query(db, (const StudentQuery*)criteria, results);
+    }
+
+    int found = 0;
+    for (int i = 0; i < db->count; i++) {
+        if (filter(&db->students[i], criteria)) {
+            if (results) {
+                results[found] = &db->students[i];
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+/* ============================================================================
+ * DATA VALIDATION AND INTEGRITY
+ * ============================================================================ */
+
+/**
+ * Compare two accumulated sums with a tolerance relative to their size
+ */
+static bool sums_match(double running, double scanned) {
+    double scale = fabs(scanned) > 1.0 ? fabs(scanned) : 1.0;
+    return fabs(running - scanned) <= 1e-7 * scale;
+}
+
+/**
+ * Count marks into 0.5-mark histogram bins in one pass
+ * @param marks Marks values (e.g. the database's marks column)
+ * @param count Number of values
+ * @param bins Receives MARKS_HISTOGRAM_BINS counts
+ */
+void build_marks_histogram(const float *marks, int count, int bins[MARKS_HISTOGRAM_BINS]) {
+    memset(bins, 0, MARKS_HISTOGRAM_BINS * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        bins[marks_histogram_bin(marks[i])]++;
+    }
+}
+
+/**
+ * Verify that the incrementally maintained state (running aggregates, marks
+ * rank tree, roll number index and marks column) agrees with a full scan
+ * @param db Student database
+ * @return true if everything is consistent
+ */
+bool check_data_consistency(StudentDatabase *db) {
+    if (!db) return false;
+
+    bool consistent = true;
+    StatisticsSummary running = compute_statistics_summary(db);
+    StatisticsSummary scanned = scan_statistics_summary(db);
+
+    if (running.count != scanned.count ||
+        running.passed_students != scanned.passed_students ||
+        running.students_with_courses != scanned.students_with_courses ||
+        memcmp(running.grade_counts, scanned.grade_counts, sizeof(running.grade_counts)) != 0) {
+        LOG_WARN("Inconsistency: running counts differ from a full scan");
+        consistent = false;
+    }
+
+    int histogram[MARKS_HISTOGRAM_BINS];
+    build_marks_histogram(db->marks_column, db->count, histogram);
+    if (memcmp(histogram, db->aggregates.marks_histogram, sizeof(histogram)) != 0) {
+        LOG_WARN("Inconsistency: running marks histogram differs from a full scan");
+        consistent = false;
+    }
+
+    if (!sums_match(running.sum_marks, scanned.sum_marks) ||
+        !sums_match(running.m2_marks, scanned.m2_marks) ||
+        !sums_match(running.sum_gpa, scanned.sum_gpa)) {
+        LOG_WARN("Inconsistency: running sums differ from a full scan");
+        consistent = false;
+    }
+
+    if (running.highest_marks != scanned.highest_marks ||
+        running.lowest_marks != scanned.lowest_marks) {
+        LOG_WARN("Inconsistency: rank tree extremes differ from a full scan");
+        consistent = false;
+    }
+
+    if (rank_tree_size(&db->marks_tree) != db->count ||
+        rank_tree_size(&db->gpa_tree) != db->count ||
+        db->roll_index.count != db->count ||
+        roaring_cardinality(&db->bitmap_index.all) != db->count ||
+        roaring_cardinality(&db->bitmap_index.passed) != scanned.passed_students) {
+        LOG_WARN("Inconsistency: index sizes do not match student count %d", db->count);
+        consistent = false;
+    }
+
+    for (int i = 0; i < db->count; i++) {
+        const Student *student = &db->students[i];
+        if (roll_index_get(&db->roll_index, student->roll_number) != i ||
+            db->marks_column[i] != student->marks) {
+            LOG_WARN("Inconsistency: derived state out of date for roll number %d",
+                     student->roll_number);
+            consistent = false;
+            break;
+        }
+    }
+
+    return consistent;
+}
+
+/**
+ * Rebuild all derived state from the students array
+ * @param db Student database
+ */
+void repair_data_inconsistencies(StudentDatabase *db) {
+    if (!db) return;
+
+    refresh_student_positions(db);
+    rebuild_running_aggregates(db);
+    LOG_INFO("Derived statistics and indexes rebuilt for %d students", db->count);
+}
+
+/* ============================================================================
+ * EXPORT AND REPORTING FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Write a statistics report with every section: summary, quartiles,
+ * grade and course breakdowns and every student. The format follows the
+ * extension (.csv, .json, otherwise text). Call without holding the
+ * database lock.
+ * @param db Student database
+ * @param filename File to write
+ * @return true if the report was written
+ */
+bool generate_statistics_report(StudentDatabase *db, const char *filename) {
+    if (!db || !filename) {
+        return false;
+    }
+
+    ReportOptions options = {report_format_for_file(filename), REPORT_SECTION_ALL, 0};
+    if (!write_report_file(db, &options, filename)) {
+        return false;
+    }
+
+    LOG_INFO("Statistics report written to %s", filename);
+    return true;
+}
+
+/**
+ * Export the grade distribution: students, spread and pass counts per
+ * grade. The format follows the extension, as for reports. Call without
+ * holding the database lock.
+ * @param db Student database
+ * @param filename File to write
+ * @return true if the file was written
+ */
+bool export_grade_distribution(StudentDatabase *db, const char *filename) {
+    if (!db || !filename) {
+        return false;
+    }
+
+    ReportOptions options = {report_format_for_file(filename), REPORT_SECTION_GRADES, 0};
+    if (!write_report_file(db, &options, filename)) {
+        return false;
+    }
+
+    LOG_INFO("Grade distribution exported to %s", filename);
+    return true;
+}
+
+/**
+ * Print the summary, grade and course sections of a report to stdout
+ * @param db Student database
+ */
+void print_detailed_statistics(StudentDatabase *db) {
+    if (!db) return;
+
+    ReportOptions options = {
+        REPORT_FORMAT_TEXT, REPORT_SECTION_SUMMARY | REPORT_SECTION_GRADES | REPORT_SECTION_COURSES, 0
+    };
+    write_report(db, &options, stdout);
+    fflush(stdout);
+}
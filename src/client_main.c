@@ -0,0 +1,161 @@
+/*
+ * File: src/client_main.c
+ * Path: SchoolRecordSystem/src/client_main.c
+ * Description: Command-line client (srs_client) for the query daemon
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Usage: srs_client [--socket PATH] [COMMAND ...]
+ *
+ * With a COMMAND its words are sent as one request; otherwise request
+ * lines are read from stdin and pipelined. Results are copied to stdout
+ * as they arrive. The exit status is nonzero if any request failed.
+ */
+
+#include "server.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define CLIENT_BUFFER 65536
+#define FAILURE_MARK ",\"ok\":false"
+
+static void print_usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [--socket PATH] [COMMAND ...]\n\n", program_name);
+    fprintf(stderr, "Send COMMAND (or request lines from stdin) to a server started with\n");
+    fprintf(stderr, "--serve and print the JSON results.\n\n");
+    fprintf(stderr, "  --socket PATH  Server socket (default: %s)\n", SERVER_DEFAULT_SOCKET);
+    fprintf(stderr, "\nExamples:\n");
+    fprintf(stderr, "  %s find 101\n", program_name);
+    fprintf(stderr, "  %s filter failed course=Physics\n", program_name);
+    fprintf(stderr, "  %s < requests.txt\n", program_name);
+}
+
+/**
+ * Copy results to stdout, noting failed requests. The tail of the
+ * previous chunk is kept so a mark split across reads is still seen.
+ */
+static void copy_results(const char *data, size_t length, char *tail, bool *failed) {
+    char scan[CLIENT_BUFFER + sizeof(FAILURE_MARK)];
+    size_t tail_length = strlen(tail);
+
+    memcpy(scan, tail, tail_length);
+    memcpy(scan + tail_length, data, length);
+    scan[tail_length + length] = '\0';
+    if (strstr(scan, FAILURE_MARK)) {
+        *failed = true;
+    }
+
+    size_t keep = sizeof(FAILURE_MARK) - 2;
+    size_t total = tail_length + length;
+    size_t start = total > keep ? total - keep : 0;
+    memcpy(tail, scan + start, total - start);
+    tail[total - start] = '\0';
+
+    fwrite(data, 1, length, stdout);
+}
+
+int main(int argc, char *argv[]) {
+    const char *socket_path = SERVER_DEFAULT_SOCKET;
+    int first_command = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else {
+            first_command = i;
+            break;
+        }
+    }
+
+    int fd = server_connect(socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot connect to %s: %s\n", socket_path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    char buffer[CLIENT_BUFFER];
+    char pending[CLIENT_BUFFER];
+    size_t pending_length = 0;
+    size_t pending_sent = 0;
+    bool input_done = false;
+
+    // A command on the command line is the whole request
+    if (first_command < argc) {
+        for (int i = first_command; i < argc; i++) {
+            size_t length = strlen(argv[i]);
+            if (pending_length + length + 2 > sizeof(pending)) {
+                fprintf(stderr, "Command too long\n");
+                close(fd);
+                return EXIT_FAILURE;
+            }
+            memcpy(pending + pending_length, argv[i], length);
+            pending_length += length;
+            pending[pending_length++] = i + 1 < argc ? ' ' : '\n';
+        }
+        input_done = true;
+    }
+
+    // Interleave sending and receiving so a long pipeline cannot stall
+    char tail[sizeof(FAILURE_MARK)] = "";
+    bool failed = false;
+    bool write_open = true;
+    for (;;) {
+        if (input_done && pending_sent == pending_length && write_open) {
+            shutdown(fd, SHUT_WR);
+            write_open = false;
+        }
+
+        struct pollfd watch[2];
+        int watch_count = 0;
+        short socket_events = POLLIN;
+        if (pending_sent < pending_length) socket_events |= POLLOUT;
+        watch[watch_count++] = (struct pollfd){fd, socket_events, 0};
+        bool reading_stdin = !input_done && pending_sent == pending_length;
+        if (reading_stdin) {
+            watch[watch_count++] = (struct pollfd){STDIN_FILENO, POLLIN, 0};
+        }
+
+        if (poll(watch, (nfds_t)watch_count, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (watch[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t received = read(fd, buffer, sizeof(buffer));
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) break;
+            copy_results(buffer, (size_t)received, tail, &failed);
+        }
+
+        if (watch[0].revents & POLLOUT) {
+            ssize_t sent = send(fd, pending + pending_sent, pending_length - pending_sent,
+                                MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (sent < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) break;
+            if (sent > 0) pending_sent += (size_t)sent;
+        }
+
+        if (reading_stdin && watch_count > 1 && (watch[1].revents & (POLLIN | POLLHUP))) {
+            ssize_t received = read(STDIN_FILENO, pending, sizeof(pending));
+            if (received <= 0) {
+                input_done = true;
+            } else {
+                pending_length = (size_t)received;
+                pending_sent = 0;
+            }
+        }
+    }
+
+    fflush(stdout);
+    close(fd);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
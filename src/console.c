@@ -0,0 +1,275 @@
+/*
+ * File: src/console.c
+ * Path: SchoolRecordSystem/src/console.c
+ * Description: Text-mode front end shared by the GUI binary and the headless srs_console
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "console.h"
+#include "student.h"
+#include "file_operations.h"
+#include "calculations.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Global variables for cleanup
+static StudentDatabase *g_database = NULL;
+
+// Set by the signal handler; console_mode saves and returns when it sees it
+static volatile sig_atomic_t g_shutdown_signal = 0;
+static volatile sig_atomic_t g_console_active = 0;
+
+/**
+ * Signal handler for graceful shutdown. Only async-signal-safe work
+ * happens here: the menu loop notices the flag, saves and returns.
+ * Without an open console database there is nothing to save, so the
+ * signal's default action is restored and it is raised again.
+ * @param signal_number Signal number
+ */
+void signal_handler(int signal_number) {
+    if (!g_console_active) {
+        signal(signal_number, SIG_DFL);
+        raise(signal_number);
+        return;
+    }
+    g_shutdown_signal = signal_number;
+}
+
+// Setup signal handlers
+void setup_signal_handlers(void) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0;                 // No SA_RESTART: a blocked read returns at once
+
+    sigaction(SIGINT, &action, NULL);    // Ctrl+C
+    sigaction(SIGTERM, &action, NULL);   // Termination signal
+
+#ifdef SIGQUIT
+    sigaction(SIGQUIT, &action, NULL);   // Quit signal (Unix)
+#endif
+}
+
+/**
+ * Read one line of input
+ * @return false at end of input or when a shutdown signal interrupted the read
+ */
+static bool read_line(char *buffer, int size) {
+    if (g_shutdown_signal || fgets(buffer, size, stdin) == NULL) {
+        buffer[0] = '\0';
+        return false;
+    }
+    return true;
+}
+
+// Console mode for testing without GUI
+void console_mode(const char *data_file) {
+    printf("Starting in console mode...\n");
+    printf("Data file: %s\n\n", data_file);
+
+    StudentDatabase *db = create_database();
+    if (!db) {
+        fprintf(stderr, "Failed to create database\n");
+        return;
+    }
+
+    g_database = db;
+    g_console_active = 1;
+
+    // Load existing data
+    if (load_from_file(db, data_file)) {
+        printf("Loaded existing data from %s\n", data_file);
+    } else {
+        printf("Starting with empty database\n");
+    }
+
+    char input[256];
+    int choice;
+
+    while (1) {
+        printf("\n=== Student Record Management System ===\n");
+        printf("1. Display all students\n");
+        printf("2. Add student\n");
+        printf("3. Search student\n");
+        printf("4. Calculate statistics\n");
+        printf("5. Sort students by marks\n");
+        printf("6. Save to file\n");
+        printf("7. Exit\n");
+        printf("Enter your choice (1-7): ");
+
+        if (!read_line(input, sizeof(input))) {
+            break;
+        }
+
+        choice = atoi(input);
+
+        switch (choice) {
+            case 1:
+                display_all_students(db);
+                break;
+
+            case 2: {
+                char name[MAX_NAME_LENGTH];
+                int roll;
+                float marks;
+
+                printf("Enter student name: ");
+                if (!read_line(name, sizeof(name))) break;
+                name[strcspn(name, "\n")] = '\0';
+
+                printf("Enter roll number: ");
+                if (!read_line(input, sizeof(input))) break;
+                roll = atoi(input);
+
+                printf("Enter marks: ");
+                if (!read_line(input, sizeof(input))) break;
+                marks = atof(input);
+
+                if (add_student(db, name, roll, marks) == STUDENT_SUCCESS) {
+                    printf("Student added successfully!\n");
+                } else {
+                    printf("Failed to add student. Roll number may already exist.\n");
+                }
+                break;
+            }
+
+            case 3: {
+                printf("Enter roll number or name to search: ");
+                if (!read_line(input, sizeof(input))) break;
+                input[strcspn(input, "\n")] = '\0';
+
+                // Anything that is not a plain number is a name search
+                if (input[strspn(input, " 0123456789")] != '\0') {
+                    Student *matches[20];
+                    int found = search_students_by_name(db, input, NAME_SEARCH_SUBSTRING, matches, 20);
+                    if (found == 0) {
+                        FuzzyNameMatch close[10];
+                        int near = fuzzy_search_students_by_name(db, input, -1, close, 10);
+                        if (near == 0) {
+                            printf("No student name contains or resembles \"%s\".\n", input);
+                            break;
+                        }
+
+                        printf("\nNo exact match for \"%s\". Closest names:\n", input);
+                        for (int i = 0; i < near; i++) {
+                            printf("  %-30s Roll: %-8d Marks: %6.2f  (%d edit%s)\n", close[i].student->name,
+                                   close[i].student->roll_number, close[i].student->marks,
+                                   close[i].distance, close[i].distance == 1 ? "" : "s");
+                        }
+                        break;
+                    }
+
+                    printf("\n%d student(s) matching \"%s\"%s:\n", found, input,
+                           found == 20 ? " (first 20 shown)" : "");
+                    for (int i = 0; i < found; i++) {
+                        printf("  %-30s Roll: %-8d Marks: %6.2f  %s\n", matches[i]->name,
+                               matches[i]->roll_number, matches[i]->marks, matches[i]->status);
+                    }
+                    break;
+                }
+
+                int roll = atoi(input);
+
+                Student *student = find_student(db, roll);
+                if (student) {
+                    printf("\nStudent Found:\n");
+                    printf("Name: %s\n", student->name);
+                    printf("Roll Number: %d\n", student->roll_number);
+                    printf("Marks: %.2f\n", student->marks);
+                    printf("Status: %s\n", student->status);
+                } else {
+                    printf("Student with roll number %d not found.\n", roll);
+                }
+                break;
+            }
+
+            case 4: {
+                StatisticsSummary summary = compute_statistics_summary(db);
+                Statistics stats = statistics_from_summary(&summary);
+                printf("\n=== Statistics ===\n");
+                printf("Total Students: %d\n", stats.total_students);
+                printf("Average Marks: %.2f\n", stats.average_marks);
+                printf("Highest Marks: %.2f\n", stats.highest_marks);
+                printf("Lowest Marks: %.2f\n", stats.lowest_marks);
+                printf("Passed Students: %d\n", stats.passed_students);
+                printf("Failed Students: %d\n", stats.failed_students);
+                printf("Pass Percentage: %.1f%%\n", stats.pass_percentage);
+
+                if (summary.highest_index >= 0) {
+                    Student *top_student = &db->students[summary.highest_index];
+                    printf("Top Scorer: %s (Roll: %d, Marks: %.2f)\n",
+                           top_student->name, top_student->roll_number, top_student->marks);
+                }
+                break;
+            }
+
+            case 5: {
+                printf("Sort by: 1) Marks Ascending 2) Marks Descending\n");
+                printf("Enter choice (1-2): ");
+                if (!read_line(input, sizeof(input))) break;
+                int sort_choice = atoi(input);
+
+                if (sort_choice == 1) {
+                    sort_students(db, SORT_BY_MARKS_ASC);
+                    printf("Students sorted by marks (ascending)\n");
+                } else if (sort_choice == 2) {
+                    sort_students(db, SORT_BY_MARKS_DESC);
+                    printf("Students sorted by marks (descending)\n");
+                } else {
+                    printf("Invalid choice\n");
+                }
+                break;
+            }
+
+            case 6:
+                if (save_to_file(db, data_file)) {
+                    printf("Data saved successfully to %s\n", data_file);
+                } else {
+                    printf("Failed to save data\n");
+                }
+                break;
+
+            case 7:
+                printf("Saving data and exiting...\n");
+                save_to_file(db, data_file);
+                g_console_active = 0;
+                destroy_database(db);
+                g_database = NULL;
+                return;
+
+            default:
+                printf("Invalid choice. Please enter 1-7.\n");
+                break;
+        }
+    }
+
+    if (g_shutdown_signal) {
+        printf("\nReceived signal %d. Saving data and exiting...\n", (int)g_shutdown_signal);
+        save_to_file(db, data_file);
+    }
+
+    g_console_active = 0;
+    destroy_database(db);
+    g_database = NULL;
+}
+
+// Cleanup function called at exit
+void cleanup_at_exit(void) {
+    if (g_database) {
+        printf("Performing cleanup...\n");
+        save_to_file(g_database, get_default_filename());
+        destroy_database(g_database);
+        g_database = NULL;
+    }
+}
+
+// Register cleanup function
+__attribute__((constructor))
+void register_cleanup(void) {
+    atexit(cleanup_at_exit);
+}
@@ -0,0 +1,102 @@
+/*
+ * File: src/console_main.c
+ * Path: SchoolRecordSystem/src/console_main.c
+ * Description: Headless front end (srs_console): console mode without GTK
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "batch.h"
+#include "console.h"
+#include "file_operations.h"
+#include "logger.h"
+#include "server.h"
+#include "startup_options.h"
+#include <stdio.h>
+#include <string.h>
+
+// Print help information
+static void print_help(const char *program_name) {
+    printf("Usage: %s [OPTIONS]\n\n", program_name);
+    printf("Student Record Management System - headless console front end.\n");
+    printf("Links only the srs_core library, so it runs without a display or GTK.\n\n");
+    printf("Options:\n");
+    printf("  -h, --help     Display this help message\n");
+    printf("  -v, --version  Display version information\n");
+    printf("  --data FILE    Specify custom data file (default: data/students.txt)\n");
+    printf("  --exec SCRIPT  Run commands from SCRIPT ('-' for stdin), one JSON result\n");
+    printf("                 line per command on stdout; nonzero exit if any failed\n");
+    printf("  --serve        Keep the data file loaded and answer the same commands\n");
+    printf("                 on a Unix socket until SIGINT/SIGTERM (see srs_client)\n");
+    printf("  --socket PATH  Socket for --serve (default: %s)\n", SERVER_DEFAULT_SOCKET);
+    print_startup_options_help();
+    printf("\n");
+}
+
+// Print version information
+static void print_version(void) {
+    printf("Student Record Management System (srs_console) v2.0.0\n");
+    printf("Headless build: no GTK dependency\n");
+}
+
+// Main function
+int main(int argc, char *argv[]) {
+    const char *data_file = NULL;
+    StartupOptions startup_options = {NULL, NULL};
+    const char *batch_script = NULL;
+    const char *socket_path = SERVER_DEFAULT_SOCKET;
+    bool serve_mode = false;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_help(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--version") == 0) {
+            print_version();
+            return 0;
+        } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            data_file = argv[++i];
+        } else if (strcmp(argv[i], "--exec") == 0 && i + 1 < argc) {
+            batch_script = argv[++i];
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            serve_mode = true;
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (!parse_startup_option(&startup_options, argc, argv, &i)) {
+            printf("Unknown option: %s\n", argv[i]);
+            printf("Use --help for usage information.\n");
+            return 1;
+        }
+    }
+
+    if (!apply_startup_options(&startup_options)) {
+        return 1;
+    }
+
+    if (batch_script) {
+        create_data_directory();
+        int status = run_batch_file(batch_script);
+        log_shutdown();
+        return status;
+    }
+
+    if (serve_mode) {
+        create_data_directory();
+        int status = run_server(socket_path, data_file ? data_file : get_default_filename());
+        log_shutdown();
+        return status;
+    }
+
+    setup_signal_handlers();
+    create_data_directory();
+    if (!data_file) {
+        data_file = get_default_filename();
+    }
+
+    console_mode(data_file);
+
+    log_shutdown();
+    return 0;
+}
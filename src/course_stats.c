@@ -0,0 +1,227 @@
+/*
+ * File: src/course_stats.c
+ * Path: SchoolRecordSystem/src/course_stats.c
+ * Description: Per-course score breakdowns grouped in one pass, in a hash table keyed by course
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - A breakdown keeps sums rather than a mean, so partial breakdowns of
+ *   disjoint ranges merge exactly
+ * - Linear probing over a power-of-two table kept under half full; a few
+ *   hundred courses fit in a few cache lines of probing
+ */
+
+#include "course_stats.h"
+#include "student.h"
+#include "memory_manager.h"
+#include <math.h>
+
+/* ============================================================================
+ * BREAKDOWNS
+ * ============================================================================ */
+
+void breakdown_init(MarksBreakdown *breakdown) {
+    memset(breakdown, 0, sizeof(*breakdown));
+    breakdown->lowest_position = -1;
+    breakdown->highest_position = -1;
+}
+
+/**
+ * Add one value
+ * @param breakdown Breakdown to update
+ * @param value Marks or course score
+ * @param position Position of the student it belongs to (added in increasing order)
+ */
+void breakdown_add(MarksBreakdown *breakdown, float value, int position) {
+    // Strictly less/greater, so ties keep the earlier position
+    if (breakdown->count == 0 || value < breakdown->lowest) {
+        breakdown->lowest = value;
+        breakdown->lowest_position = position;
+    }
+    if (breakdown->count == 0 || value > breakdown->highest) {
+        breakdown->highest = value;
+        breakdown->highest_position = position;
+    }
+    breakdown->count++;
+    breakdown->sum += value;
+    breakdown->sum_squares += (double)value * value;
+    if (value >= PASSING_MARKS) breakdown->passed++;
+    breakdown->grade_counts[grade_index_for_marks(value)]++;
+}
+
+/**
+ * Fold in the breakdown of a later range of positions
+ */
+void breakdown_merge(MarksBreakdown *into, const MarksBreakdown *from) {
+    if (from->count == 0) return;
+
+    if (into->count == 0 || from->lowest < into->lowest) {
+        into->lowest = from->lowest;
+        into->lowest_position = from->lowest_position;
+    }
+    if (into->count == 0 || from->highest > into->highest) {
+        into->highest = from->highest;
+        into->highest_position = from->highest_position;
+    }
+    into->count += from->count;
+    into->passed += from->passed;
+    into->sum += from->sum;
+    into->sum_squares += from->sum_squares;
+    for (int g = 0; g < GRADE_COUNT; g++) {
+        into->grade_counts[g] += from->grade_counts[g];
+    }
+}
+
+float breakdown_mean(const MarksBreakdown *breakdown) {
+    return breakdown->count > 0 ? (float)(breakdown->sum / breakdown->count) : 0.0f;
+}
+
+/**
+ * Sample variance (n - 1 denominator), as summary_standard_deviation()
+ */
+float breakdown_variance(const MarksBreakdown *breakdown) {
+    if (breakdown->count <= 1) return 0.0f;
+
+    double m2 = breakdown->sum_squares - breakdown->sum * (breakdown->sum / breakdown->count);
+    return m2 > 0.0 ? (float)(m2 / (breakdown->count - 1)) : 0.0f;
+}
+
+float breakdown_standard_deviation(const MarksBreakdown *breakdown) {
+    return sqrtf(breakdown_variance(breakdown));
+}
+
+float breakdown_pass_rate(const MarksBreakdown *breakdown) {
+    return breakdown->count > 0 ? (float)breakdown->passed * 100.0f / (float)breakdown->count : 0.0f;
+}
+
+/* ============================================================================
+ * COURSE TABLES
+ * ============================================================================ */
+
+// FNV-1a over the course name
+static unsigned int course_hash(const char *name) {
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char*)name; *c; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Slot holding a course, or the empty slot where it belongs
+ */
+static CourseBreakdown* find_slot(const CourseTable *table, const char *course_name) {
+    unsigned int mask = (unsigned int)table->capacity - 1;
+    unsigned int slot = course_hash(course_name) & mask;
+    while (table->slots[slot].course_name &&
+           strcmp(table->slots[slot].course_name, course_name) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    return &table->slots[slot];
+}
+
+static void grow_table(CourseTable *table) {
+    CourseBreakdown *old = table->slots;
+    int old_capacity = table->capacity;
+
+    table->capacity = old_capacity > 0 ? old_capacity * 2 : COURSE_TABLE_INITIAL_CAPACITY;
+    table->slots = (CourseBreakdown*)safe_malloc((size_t)table->capacity * sizeof(CourseBreakdown));
+    memset(table->slots, 0, (size_t)table->capacity * sizeof(CourseBreakdown));
+
+    // Names move with their breakdowns
+    for (int i = 0; i < old_capacity; i++) {
+        if (old[i].course_name) {
+            *find_slot(table, old[i].course_name) = old[i];
+        }
+    }
+    free(old);
+}
+
+/**
+ * Breakdown of a course, added empty if the course is new
+ */
+static MarksBreakdown* claim_course(CourseTable *table, const char *course_name) {
+    if ((table->count + 1) * 2 > table->capacity) {
+        grow_table(table);
+    }
+
+    CourseBreakdown *slot = find_slot(table, course_name);
+    if (!slot->course_name) {
+        size_t length = strlen(course_name) + 1;
+        slot->course_name = (char*)safe_malloc(length);
+        memcpy(slot->course_name, course_name, length);
+        breakdown_init(&slot->scores);
+        table->count++;
+    }
+    return &slot->scores;
+}
+
+void course_table_init(CourseTable *table) {
+    table->slots = NULL;
+    table->capacity = 0;
+    table->count = 0;
+}
+
+void course_table_free(CourseTable *table) {
+    for (int i = 0; i < table->capacity; i++) {
+        free(table->slots[i].course_name);
+    }
+    free(table->slots);
+    course_table_init(table);
+}
+
+void course_table_add(CourseTable *table, const char *course_name, float score, int position) {
+    breakdown_add(claim_course(table, course_name), score, position);
+}
+
+/**
+ * Fold in a table built over a later range of positions
+ */
+void course_table_merge(CourseTable *into, const CourseTable *from) {
+    for (int i = 0; i < from->capacity; i++) {
+        if (from->slots[i].course_name) {
+            breakdown_merge(claim_course(into, from->slots[i].course_name), &from->slots[i].scores);
+        }
+    }
+}
+
+const CourseBreakdown* course_table_find(const CourseTable *table, const char *course_name) {
+    if (table->count == 0 || !course_name) return NULL;
+
+    const CourseBreakdown *slot = find_slot(table, course_name);
+    return slot->course_name ? slot : NULL;
+}
+
+static int compare_course_names(const void *a, const void *b) {
+    return strcmp(((const CourseBreakdown*)a)->course_name, ((const CourseBreakdown*)b)->course_name);
+}
+
+CourseBreakdown* course_table_sorted(const CourseTable *table) {
+    CourseBreakdown *sorted = (CourseBreakdown*)safe_malloc(
+        (size_t)(table->count > 0 ? table->count : 1) * sizeof(CourseBreakdown));
+    int filled = 0;
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->slots[i].course_name) {
+            sorted[filled++] = table->slots[i];
+        }
+    }
+    qsort(sorted, (size_t)filled, sizeof(CourseBreakdown), compare_course_names);
+    return sorted;
+}
+
+/* ============================================================================
+ * CACHE
+ * ============================================================================ */
+
+void course_stats_cache_init(CourseStatsCache *cache) {
+    course_table_init(&cache->table);
+    cache->stale = true;
+    pthread_mutex_init(&cache->lock, NULL);
+}
+
+void course_stats_cache_free(CourseStatsCache *cache) {
+    course_table_free(&cache->table);
+    pthread_mutex_destroy(&cache->lock);
+}
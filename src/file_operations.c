@@ -1,4 +1,5 @@
 #include "file_operations.h"
+#include "logger.h"
 #include <sys/stat.h>
 #include <errno.h>
 #include <unistd.h>
@@ -35,7 +36,7 @@ char* get_data_directory_path(void) {
         }
 
         initialized = true;
-        printf("Data directory path: %s\n", data_path);
+        LOG_DEBUG("Data directory path: %s", data_path);
     }
 
     return data_path;
@@ -48,18 +49,18 @@ void create_data_directory(void) {
 
     if (stat(data_dir, &st) == -1) {
         if (mkdir(data_dir, 0755) == 0) {
-            printf("Created data directory: %s\n", data_dir);
+            LOG_INFO("Created data directory: %s", data_dir);
         } else {
-            fprintf(stderr, "Failed to create data directory: %s (errno: %d)\n", data_dir, errno);
+            LOG_ERROR("Failed to create data directory: %s (errno: %d)", data_dir, errno);
             // Try creating in current directory as fallback
             if (mkdir("data", 0755) == 0) {
-                printf("Created fallback data directory: ./data\n");
+                LOG_INFO("Created fallback data directory: ./data");
             } else {
-                fprintf(stderr, "Failed to create fallback data directory\n");
+                LOG_ERROR("Failed to create fallback data directory");
             }
         }
     } else {
-        printf("Data directory exists: %s\n", data_dir);
+        LOG_DEBUG("Data directory exists: %s", data_dir);
     }
 }
 
@@ -100,27 +101,27 @@ char* get_data_file_path(const char *filename) {
 // Save student records to file
 bool save_to_file(StudentDatabase *db, const char *filename) {
     if (!db || !filename) {
-        fprintf(stderr, "Invalid parameters for save_to_file\n");
+        LOG_ERROR("Invalid parameters for save_to_file");
         return false;
     }
 
     // Ensure data directory exists
     create_data_directory();
 
-    printf("Attempting to save to: %s\n", filename);
+    LOG_DEBUG("Attempting to save to: %s", filename);
 
     FILE *file = fopen(filename, "w");
     if (!file) {
-        fprintf(stderr, "Error opening file for writing: %s (errno: %d)\n", filename, errno);
+        LOG_ERROR("Error opening file for writing: %s (errno: %d)", filename, errno);
 
         // Try saving to current directory as fallback
         char fallback_name[256];
         snprintf(fallback_name, sizeof(fallback_name), "./students_backup.txt");
-        printf("Trying fallback location: %s\n", fallback_name);
+        LOG_WARN("Trying fallback location: %s", fallback_name);
 
         file = fopen(fallback_name, "w");
         if (!file) {
-            fprintf(stderr, "Failed to open fallback file: %s\n", fallback_name);
+            LOG_ERROR("Failed to open fallback file: %s", fallback_name);
             return false;
         }
     }
@@ -138,42 +139,63 @@ bool save_to_file(StudentDatabase *db, const char *filename) {
     }
 
     fclose(file);
-    printf("Successfully saved %d student records to %s\n", db->count, filename);
+    LOG_INFO("Successfully saved %d student records to %s", db->count, filename);
     return true;
 }
 
 // Load student records from file
 bool load_from_file(StudentDatabase *db, const char *filename) {
+    return load_from_file_with_progress(db, filename, NULL, NULL);
+}
+
+/**
+ * Load student records, reporting how much of the file has been read
+ * @param db Database to fill (cleared first)
+ * @param filename File to read
+ * @param progress Called every FILE_PROGRESS_STRIDE lines (may be NULL); returning false stops the load
+ * @param context Passed to progress
+ * @return true if at least one record was loaded and the load was not stopped
+ */
+bool load_from_file_with_progress(StudentDatabase *db, const char *filename,
+                                  StudentProgressFunc progress, void *context) {
     if (!db || !filename) {
-        fprintf(stderr, "Invalid parameters for load_from_file\n");
+        LOG_ERROR("Invalid parameters for load_from_file");
         return false;
     }
 
-    printf("Attempting to load from: %s\n", filename);
+    LOG_DEBUG("Attempting to load from: %s", filename);
 
     // Check if file exists first
     if (!file_exists(filename)) {
-        printf("File %s not found.\n", filename);
+        LOG_INFO("File %s not found.", filename);
 
         // Try to find the file in current directory
         if (file_exists("students.txt")) {
-            printf("Found students.txt in current directory, loading...\n");
+            LOG_INFO("Found students.txt in current directory, loading...");
             filename = "students.txt";
         } else if (file_exists("data/students.txt")) {
-            printf("Found data/students.txt, loading...\n");
+            LOG_INFO("Found data/students.txt, loading...");
             filename = "data/students.txt";
         } else {
-            printf("No existing data file found. Starting with empty database.\n");
+            LOG_INFO("No existing data file found. Starting with empty database.");
             return false;
         }
     }
 
     FILE *file = fopen(filename, "r");
     if (!file) {
-        fprintf(stderr, "Error opening file for reading: %s (errno: %d)\n", filename, errno);
+        LOG_ERROR("Error opening file for reading: %s (errno: %d)", filename, errno);
         return false;
     }
 
+    // File size, for progress reports
+    long file_size = 0;
+    if (progress && fseek(file, 0, SEEK_END) == 0) {
+        file_size = ftell(file);
+        rewind(file);
+    }
+    bool stopped = false;
+
     char line[512];
     char name[MAX_NAME_LENGTH];
     int roll_number;
@@ -187,26 +209,34 @@ bool load_from_file(StudentDatabase *db, const char *filename) {
         line_count++;
         // Check if this is actually a header or data
         if (strstr(line, "Roll Number") || strstr(line, "Name") || strstr(line, "Marks")) {
-            printf("Skipping header line\n");
+            LOG_DEBUG("Skipping header line");
         } else {
             // This is actually data, parse it
             rewind(file);
         }
     }
 
+    // Observers get one reset for the whole file, not one event per record
+    begin_student_batch(db);
+
     // Clear existing data
     clear_database(db);
 
     // Read student data
     while (fgets(line, sizeof(line), file)) {
         line_count++;
+        if (progress && line_count % FILE_PROGRESS_STRIDE == 0 && file_size > 0 &&
+            !progress((double)ftell(file) / file_size, context)) {
+            stopped = true;
+            break;
+        }
         // Remove newline character
         line[strcspn(line, "\n")] = '\0';
 
         // Skip empty lines
         if (strlen(line) == 0) continue;
 
-        printf("Parsing line %d: %s\n", line_count, line);
+        LOG_TRACE("Parsing line %d: %s", line_count, line);
 
         // Try different parsing methods
         int parsed = 0;
@@ -250,22 +280,30 @@ bool load_from_file(StudentDatabase *db, const char *filename) {
         }
 
         if (parsed) {
-            printf("Parsed: Roll=%d, Name='%s', Marks=%.2f, Status='%s'\n",
-                   roll_number, name, marks, status);
+            LOG_TRACE("Parsed: Roll=%d, Name='%s', Marks=%.2f, Status='%s'",
+                      roll_number, name, marks, status);
 
-            if (add_student(db, name, roll_number, marks)) {
+            if (add_student(db, name, roll_number, marks) == STUDENT_SUCCESS) {
                 loaded_count++;
-                printf("Successfully added student %d\n", loaded_count);
+                LOG_TRACE("Successfully added student %d", loaded_count);
             } else {
-                printf("Failed to add student with roll number %d\n", roll_number);
+                LOG_WARN("Failed to add student with roll number %d", roll_number);
             }
         } else {
-            printf("Failed to parse line: %s\n", line);
+            LOG_WARN("Failed to parse line: %s", line);
         }
     }
 
     fclose(file);
-    printf("Successfully loaded %d student records from %s\n", loaded_count, filename);
+    end_student_batch(db);
+    if (stopped) {
+        LOG_INFO("Loading %s stopped after %d student records", filename, loaded_count);
+        return false;
+    }
+    if (progress) {
+        progress(1.0, context);
+    }
+    LOG_INFO("Successfully loaded %d student records from %s", loaded_count, filename);
     return loaded_count > 0;
 }
 
@@ -281,42 +319,125 @@ bool create_backup(StudentDatabase *db, const char *backup_filename) {
 
 // Export to CSV format with additional formatting
 bool export_to_csv(StudentDatabase *db, const char *filename) {
+    return export_to_csv_with_progress(db, filename, NULL, NULL);
+}
+
+/**
+ * Export to CSV, reporting how many records have been written. The
+ * records are read from a snapshot, so edits made meanwhile neither
+ * wait for the export nor show up in the file. A stopped export removes
+ * the partial file. Call without holding the database lock.
+ * @param db Database to export
+ * @param filename CSV file to write
+ * @param progress Called every FILE_PROGRESS_STRIDE records (may be NULL); returning false stops the export
+ * @param context Passed to progress
+ * @return true if every record was written
+ */
+bool export_to_csv_with_progress(StudentDatabase *db, const char *filename,
+                                 StudentProgressFunc progress, void *context) {
     if (!db || !filename) {
         return false;
     }
 
+    Snapshot *snapshot = open_student_snapshot(db);
+    bool exported = export_snapshot_to_csv(db, snapshot, filename, progress, context);
+    close_student_snapshot(db, snapshot);
+    return exported;
+}
+
+/**
+ * Write one chunk of records, graded in a single classify_grades() call
+ * @param file CSV file
+ * @param records Records to write
+ * @param count Number of records
+ */
+static void write_csv_records(FILE *file, const Student *records, int count) {
+    float marks[SNAPSHOT_CHUNK_RECORDS];
+    uint8_t grades[SNAPSHOT_CHUNK_RECORDS];
+    if (count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        marks[i] = records[i].marks;
+    }
+    classify_grades(marks, grades, count);
+
+    for (int i = 0; i < count; i++) {
+        const Student *student = &records[i];
+        fprintf(file, "%d,\"%s\",%.2f,%s,%c\n",
+                student->roll_number,
+                student->name,
+                student->marks,
+                student->status,
+                grade_letter(grades[i]));
+    }
+}
+
+/**
+ * Export the records of an open snapshot to CSV
+ * @param db Database the snapshot was opened on
+ * @param snapshot Open snapshot
+ * @param filename CSV file to write
+ * @param progress Called every FILE_PROGRESS_STRIDE records (may be NULL); returning false stops the export
+ * @param context Passed to progress
+ * @return true if every record was written
+ */
+bool export_snapshot_to_csv(StudentDatabase *db, const Snapshot *snapshot, const char *filename,
+                            StudentProgressFunc progress, void *context) {
+    if (!db || !snapshot || !filename) {
+        return false;
+    }
+
     // Ensure data directory exists
     create_data_directory();
 
     FILE *file = fopen(filename, "w");
     if (!file) {
-        fprintf(stderr, "Error opening file for export: %s\n", filename);
+        LOG_ERROR("Error opening file for export: %s", filename);
         return false;
     }
 
     // Write enhanced header
     fprintf(file, "Roll Number,Student Name,Marks Obtained,Pass/Fail Status,Grade\n");
 
-    // Write student data with grades
-    for (int i = 0; i < db->count; i++) {
-        char grade;
-        if (db->students[i].marks >= 90) grade = 'A';
-        else if (db->students[i].marks >= 80) grade = 'B';
-        else if (db->students[i].marks >= 70) grade = 'C';
-        else if (db->students[i].marks >= 60) grade = 'D';
-        else if (db->students[i].marks >= 40) grade = 'E';
-        else grade = 'F';
+    // Write student data with grades, a chunk at a time
+    Student *chunk = malloc(SNAPSHOT_CHUNK_RECORDS * sizeof(Student));
+    if (!chunk) {
+        fclose(file);
+        remove(filename);
+        LOG_ERROR("Out of memory exporting to %s", filename);
+        return false;
+    }
 
-        fprintf(file, "%d,\"%s\",%.2f,%s,%c\n",
-                db->students[i].roll_number,
-                db->students[i].name,
-                db->students[i].marks,
-                db->students[i].status,
-                grade);
+    int position = 0;
+    bool stopped = false;
+    while (position < snapshot->count && !stopped) {
+        int copied = read_student_snapshot(db, snapshot, position, chunk, SNAPSHOT_CHUNK_RECORDS);
+        if (copied <= 0) break;
+        write_csv_records(file, chunk, copied);
+
+        // Once per FILE_PROGRESS_STRIDE records
+        int next = position + copied;
+        if (progress && next < snapshot->count &&
+            next / FILE_PROGRESS_STRIDE != position / FILE_PROGRESS_STRIDE) {
+            stopped = !progress((double)next / snapshot->count, context);
+        }
+        position = next;
+    }
+    free(chunk);
+
+    if (stopped) {
+        fclose(file);
+        remove(filename);
+        LOG_INFO("Export to %s stopped before all %d student records were written",
+                 filename, snapshot->count);
+        return false;
     }
 
     fclose(file);
-    printf("Successfully exported %d student records to %s\n", db->count, filename);
+    if (progress) {
+        progress(1.0, context);
+    }
+    LOG_INFO("Successfully exported %d student records to %s", snapshot->count, filename);
     return true;
 }
 
@@ -324,7 +445,7 @@ bool export_to_csv(StudentDatabase *db, const char *filename) {
 bool initialize_sample_data(StudentDatabase *db) {
     if (!db) return false;
 
-    printf("Creating sample data...\n");
+    LOG_INFO("Creating sample data...");
 
     // Sample student data
     struct {
@@ -347,18 +468,20 @@ bool initialize_sample_data(StudentDatabase *db) {
     int sample_count = sizeof(sample_students) / sizeof(sample_students[0]);
     int added_count = 0;
 
+    begin_student_batch(db);
     for (int i = 0; i < sample_count; i++) {
         if (add_student(db, sample_students[i].name, sample_students[i].roll, sample_students[i].marks)) {
             added_count++;
         }
     }
+    end_student_batch(db);
 
-    printf("Added %d sample students\n", added_count);
+    LOG_INFO("Added %d sample students", added_count);
 
     // Save the sample data
     char *default_file = get_default_filename();
     if (save_to_file(db, default_file)) {
-        printf("Sample data saved to %s\n", default_file);
+        LOG_INFO("Sample data saved to %s", default_file);
         return true;
     }
 
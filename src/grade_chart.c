@@ -0,0 +1,271 @@
+/*
+ * File: src/grade_chart.c
+ * Path: SchoolRecordSystem/src/grade_chart.c
+ * Description: Cairo marks histogram and density chart over the running aggregates
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "grade_chart.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define GRADE_CHART_DATA_KEY "grade-chart"
+
+// Density curve: Gaussian smoothing with a 2-mark standard deviation,
+// cut off at three standard deviations (12 half-mark bins)
+#define DENSITY_SIGMA_MARKS 2.0
+#define DENSITY_RADIUS 12
+
+// Plot margins in pixels
+#define MARGIN_LEFT 48.0
+#define MARGIN_RIGHT 16.0
+#define MARGIN_TOP 28.0
+#define MARGIN_BOTTOM 32.0
+
+typedef struct {
+    StudentDatabase *db;
+    bool stale;                          // Marks changed since the cache was filled
+    bool redraw_queued;                  // A frame is already pending
+    int bins[MARKS_HISTOGRAM_BINS];      // Copy of the running histogram
+    double density[MARKS_HISTOGRAM_BINS];  // Smoothed bins, in students per bin
+    double kernel[2 * DENSITY_RADIUS + 1];
+    int total;
+    double peak;                         // Tallest bar or density point
+} GradeChart;
+
+// Bar colours for grades A to F
+static const double grade_colors[6][3] = {
+    {0.18, 0.55, 0.34},
+    {0.33, 0.64, 0.36},
+    {0.55, 0.70, 0.30},
+    {0.86, 0.68, 0.22},
+    {0.90, 0.49, 0.20},
+    {0.80, 0.24, 0.24}
+};
+
+/* ============================================================================
+ * CACHED HISTOGRAM
+ * ============================================================================ */
+
+static void build_kernel(GradeChart *chart) {
+    double sigma_bins = DENSITY_SIGMA_MARKS / MARKS_HISTOGRAM_BIN_WIDTH;
+    double sum = 0.0;
+
+    for (int k = -DENSITY_RADIUS; k <= DENSITY_RADIUS; k++) {
+        double weight = exp(-0.5 * (k / sigma_bins) * (k / sigma_bins));
+        chart->kernel[k + DENSITY_RADIUS] = weight;
+        sum += weight;
+    }
+    for (int k = 0; k < 2 * DENSITY_RADIUS + 1; k++) {
+        chart->kernel[k] /= sum;
+    }
+}
+
+/**
+ * Copy the running histogram and smooth it into the density curve.
+ * O(bins x kernel), and only after the marks changed.
+ * @param chart Chart to refresh
+ */
+static void refresh_cache(GradeChart *chart) {
+    memcpy(chart->bins, chart->db->aggregates.marks_histogram, sizeof(chart->bins));
+
+    chart->total = 0;
+    chart->peak = 0.0;
+    for (int i = 0; i < MARKS_HISTOGRAM_BINS; i++) {
+        chart->total += chart->bins[i];
+        if (chart->bins[i] > chart->peak) chart->peak = chart->bins[i];
+    }
+
+    for (int i = 0; i < MARKS_HISTOGRAM_BINS; i++) {
+        double value = 0.0;
+        for (int k = -DENSITY_RADIUS; k <= DENSITY_RADIUS; k++) {
+            int bin = i + k;
+            if (bin >= 0 && bin < MARKS_HISTOGRAM_BINS) {
+                value += chart->bins[bin] * chart->kernel[k + DENSITY_RADIUS];
+            }
+        }
+        chart->density[i] = value;
+        if (value > chart->peak) chart->peak = value;
+    }
+
+    chart->stale = false;
+}
+
+/* ============================================================================
+ * DRAWING
+ * ============================================================================ */
+
+// Smallest 1, 2 or 5 x 10^k at or above 'value'
+static double nice_ceiling(double value) {
+    if (value <= 1.0) return 1.0;
+
+    double magnitude = pow(10.0, floor(log10(value)));
+    double steps[] = {1.0, 2.0, 5.0, 10.0};
+    for (int i = 0; i < 4; i++) {
+        if (steps[i] * magnitude >= value) return steps[i] * magnitude;
+    }
+    return 10.0 * magnitude;
+}
+
+static void draw_axes(cairo_t *cr, double left, double top, double width, double height, double y_max) {
+    char label[32];
+
+    cairo_set_font_size(cr, 10.0);
+    cairo_set_line_width(cr, 1.0);
+
+    // Horizontal grid with count labels
+    for (int step = 0; step <= 4; step++) {
+        double y = top + height - height * step / 4.0;
+        cairo_set_source_rgb(cr, 0.88, 0.88, 0.88);
+        cairo_move_to(cr, left, floor(y) + 0.5);
+        cairo_line_to(cr, left + width, floor(y) + 0.5);
+        cairo_stroke(cr);
+
+        snprintf(label, sizeof(label), "%g", y_max * step / 4.0);
+        cairo_set_source_rgb(cr, 0.35, 0.35, 0.35);
+        cairo_move_to(cr, 6.0, y + 3.0);
+        cairo_show_text(cr, label);
+    }
+
+    // Marks ticks every 10
+    for (int marks = 0; marks <= 100; marks += 10) {
+        double x = left + width * marks / 100.0;
+        cairo_set_source_rgb(cr, 0.35, 0.35, 0.35);
+        cairo_move_to(cr, floor(x) + 0.5, top + height);
+        cairo_line_to(cr, floor(x) + 0.5, top + height + 4.0);
+        cairo_stroke(cr);
+
+        snprintf(label, sizeof(label), "%d", marks);
+        cairo_move_to(cr, x - 3.0 * strlen(label), top + height + 16.0);
+        cairo_show_text(cr, label);
+    }
+}
+
+/**
+ * Draw the histogram bars, coloured by grade, the density curve and the
+ * pass mark. Reads only the cache, so a frame is O(bins).
+ */
+static gboolean draw_grade_chart(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    GradeChart *chart = (GradeChart*)data;
+    chart->redraw_queued = false;
+    if (chart->stale) {
+        refresh_cache(chart);
+    }
+
+    double full_width = gtk_widget_get_allocated_width(widget);
+    double full_height = gtk_widget_get_allocated_height(widget);
+    double left = MARGIN_LEFT;
+    double top = MARGIN_TOP;
+    double width = full_width - MARGIN_LEFT - MARGIN_RIGHT;
+    double height = full_height - MARGIN_TOP - MARGIN_BOTTOM;
+
+    cairo_set_source_rgb(cr, 1.0, 1.0, 1.0);
+    cairo_paint(cr);
+    if (width < 40.0 || height < 40.0) return FALSE;
+
+    char title[96];
+    snprintf(title, sizeof(title), "Marks distribution - %d student%s (0.5-mark bins)",
+             chart->total, chart->total == 1 ? "" : "s");
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+    cairo_set_font_size(cr, 12.0);
+    cairo_set_source_rgb(cr, 0.15, 0.15, 0.15);
+    cairo_move_to(cr, left, 18.0);
+    cairo_show_text(cr, title);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+
+    double y_max = nice_ceiling(chart->peak);
+    draw_axes(cr, left, top, width, height, y_max);
+
+    if (chart->total == 0) {
+        cairo_set_source_rgb(cr, 0.45, 0.45, 0.45);
+        cairo_move_to(cr, left + width / 2.0 - 45.0, top + height / 2.0);
+        cairo_show_text(cr, "No students yet");
+        return FALSE;
+    }
+
+    // Bars, one rectangle per non-empty bin
+    double bin_width = width / MARKS_HISTOGRAM_BINS;
+    for (int i = 0; i < MARKS_HISTOGRAM_BINS; i++) {
+        if (chart->bins[i] == 0) continue;
+
+        const double *color = grade_colors[grade_index_for_marks(i * MARKS_HISTOGRAM_BIN_WIDTH)];
+        double bar_height = height * chart->bins[i] / y_max;
+        cairo_set_source_rgba(cr, color[0], color[1], color[2], 0.85);
+        cairo_rectangle(cr, left + i * bin_width, top + height - bar_height,
+                        bin_width > 1.5 ? bin_width - 0.5 : bin_width, bar_height);
+        cairo_fill(cr);
+    }
+
+    // Density curve through the bin centres
+    cairo_set_source_rgb(cr, 0.12, 0.29, 0.62);
+    cairo_set_line_width(cr, 2.0);
+    for (int i = 0; i < MARKS_HISTOGRAM_BINS; i++) {
+        double x = left + (i + 0.5) * bin_width;
+        double y = top + height - height * chart->density[i] / y_max;
+        if (i == 0) {
+            cairo_move_to(cr, x, y);
+        } else {
+            cairo_line_to(cr, x, y);
+        }
+    }
+    cairo_stroke(cr);
+
+    // Pass mark
+    double pass_x = left + width * PASSING_MARKS / 100.0;
+    double dashes[] = {4.0, 3.0};
+    cairo_set_dash(cr, dashes, 2, 0.0);
+    cairo_set_line_width(cr, 1.0);
+    cairo_set_source_rgb(cr, 0.55, 0.10, 0.10);
+    cairo_move_to(cr, floor(pass_x) + 0.5, top);
+    cairo_line_to(cr, floor(pass_x) + 0.5, top + height);
+    cairo_stroke(cr);
+    cairo_set_dash(cr, NULL, 0, 0.0);
+    cairo_move_to(cr, pass_x + 4.0, top + 10.0);
+    cairo_show_text(cr, "Pass");
+
+    return FALSE;
+}
+
+/* ============================================================================
+ * PUBLIC INTERFACE
+ * ============================================================================ */
+
+/**
+ * Create the chart widget
+ * @param db Database whose running marks histogram is drawn
+ * @return New drawing area (floating reference)
+ */
+GtkWidget* grade_chart_new(StudentDatabase *db) {
+    GradeChart *chart = g_new0(GradeChart, 1);
+    chart->db = db;
+    chart->stale = true;
+    build_kernel(chart);
+
+    GtkWidget *area = gtk_drawing_area_new();
+    gtk_widget_set_size_request(area, -1, 260);
+    g_object_set_data_full(G_OBJECT(area), GRADE_CHART_DATA_KEY, chart, g_free);
+    g_signal_connect(area, "draw", G_CALLBACK(draw_grade_chart), chart);
+    return area;
+}
+
+/**
+ * Note that the marks changed. Only the first call before a frame queues
+ * a redraw; GTK paces frames to the display, so bulk changes never draw
+ * more often than the screen refreshes.
+ * @param widget Chart from grade_chart_new()
+ */
+void grade_chart_queue_update(GtkWidget *widget) {
+    if (!widget) return;
+
+    GradeChart *chart = (GradeChart*)g_object_get_data(G_OBJECT(widget), GRADE_CHART_DATA_KEY);
+    if (!chart) return;
+
+    chart->stale = true;
+    if (!chart->redraw_queued) {
+        chart->redraw_queued = true;
+        gtk_widget_queue_draw(widget);
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * File: src/grading.c
+ * Path: SchoolRecordSystem/src/grading.c
+ * Description: Grading scheme: letter grade boundaries and their fixed-point lookup table
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Marks are classified by the hundredth they fall in: floor(marks * 100)
+ *   indexes a 10001-entry table, so one value costs a multiply and a load
+ * - A float times 100 is exact in double precision, so the floor never
+ *   lands in the wrong hundredth
+ */
+
+#include "grading.h"
+#include "simd_kernels.h"
+#include "student.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+static GradingScheme active_scheme;
+static pthread_once_t default_scheme_once = PTHREAD_ONCE_INIT;
+
+static const char *grade_letters[GRADE_COUNT] = {"A", "B", "C", "D", "E", "F"};
+
+static void init_default_scheme(void) {
+    static const float defaults[GRADE_BOUNDARY_COUNT] = {
+        GRADE_A_THRESHOLD, GRADE_B_THRESHOLD, GRADE_C_THRESHOLD,
+        GRADE_D_THRESHOLD, GRADE_E_THRESHOLD
+    };
+    grading_scheme_init(&active_scheme, defaults);
+}
+
+/**
+ * Smallest float whose marks reach a boundary of 'hundredths' / 100
+ */
+static float boundary_float(int hundredths) {
+    float value = (float)hundredths / GRADING_TABLE_SCALE;
+    while ((double)value * GRADING_TABLE_SCALE < hundredths) {
+        value = nextafterf(value, INFINITY);
+    }
+    while ((double)nextafterf(value, -INFINITY) * GRADING_TABLE_SCALE >= hundredths) {
+        value = nextafterf(value, -INFINITY);
+    }
+    return value;
+}
+
+/* ============================================================================
+ * SCHEMES
+ * ============================================================================ */
+
+/**
+ * Build a scheme from its boundaries
+ * @param scheme Scheme to fill
+ * @param minimums Lowest marks for A .. E, strictly descending within 0 .. 100
+ *                 (rounded to hundredths); E must be PASSING_MARKS
+ * @return false if the boundaries are out of range, out of order, or E is
+ *         not the pass mark
+ */
+bool grading_scheme_init(GradingScheme *scheme, const float minimums[GRADE_BOUNDARY_COUNT]) {
+    if (!scheme || !minimums) return false;
+
+    int hundredths[GRADE_BOUNDARY_COUNT];
+    for (int g = 0; g < GRADE_BOUNDARY_COUNT; g++) {
+        if (!(minimums[g] >= 0.0f && minimums[g] <= 100.0f)) return false;
+        hundredths[g] = (int)lround((double)minimums[g] * GRADING_TABLE_SCALE);
+        if (g > 0 && hundredths[g] >= hundredths[g - 1]) return false;
+    }
+
+    // Pass/fail status, counts and filters use PASSING_MARKS, so F must mean fail
+    if (hundredths[GRADE_BOUNDARY_COUNT - 1] != (int)lround(PASSING_MARKS * GRADING_TABLE_SCALE)) {
+        return false;
+    }
+
+    for (int g = 0; g < GRADE_BOUNDARY_COUNT; g++) {
+        scheme->minimums[g] = boundary_float(hundredths[g]);
+    }
+
+    // Each entry: the number of boundaries its hundredth falls short of
+    for (int k = 0; k < GRADING_TABLE_SIZE; k++) {
+        int grade = GRADE_BOUNDARY_COUNT;
+        while (grade > 0 && k >= hundredths[grade - 1]) {
+            grade--;
+        }
+        scheme->table[k] = (uint8_t)grade;
+    }
+    return true;
+}
+
+const GradingScheme* active_grading_scheme(void) {
+    pthread_once(&default_scheme_once, init_default_scheme);
+    return &active_scheme;
+}
+
+/**
+ * Replace the active scheme (at startup only; see grading.h)
+ * @param minimums Lowest marks for A .. E
+ * @return false if the boundaries are invalid (the active scheme is kept)
+ */
+bool set_grading_scheme(const float minimums[GRADE_BOUNDARY_COUNT]) {
+    GradingScheme scheme;
+    if (!grading_scheme_init(&scheme, minimums)) return false;
+
+    pthread_once(&default_scheme_once, init_default_scheme);
+    active_scheme = scheme;
+    return true;
+}
+
+/**
+ * Parse "A,B,C,D,E" lowest marks
+ * @param text Comma-separated boundaries, e.g. "85,75,65,55,45"
+ * @param minimums Receives the boundaries
+ * @return false unless the text holds exactly five numbers
+ */
+bool grading_boundaries_from_string(const char *text, float minimums[GRADE_BOUNDARY_COUNT]) {
+    if (!text || !minimums) return false;
+
+    const char *cursor = text;
+    for (int g = 0; g < GRADE_BOUNDARY_COUNT; g++) {
+        char *end;
+        minimums[g] = strtof(cursor, &end);
+        if (end == cursor) return false;
+        if (g < GRADE_BOUNDARY_COUNT - 1 && *end != ',') return false;
+        cursor = end + 1;
+    }
+    return cursor[-1] == '\0';
+}
+
+/* ============================================================================
+ * CLASSIFICATION
+ * ============================================================================ */
+
+/**
+ * Grade index of one mark through the active table
+ * @param marks Marks to classify
+ * @return 0 = A ... 5 = F (negative or NaN marks are F)
+ */
+int grade_index_for_marks(float marks) {
+    const GradingScheme *scheme = active_grading_scheme();
+
+    if (!(marks >= 0.0f)) return GRADE_COUNT - 1;
+    if (marks >= 100.0f) return scheme->table[GRADING_TABLE_SIZE - 1];
+    return scheme->table[(int)((double)marks * GRADING_TABLE_SCALE)];
+}
+
+char grade_letter(int grade_index) {
+    return (grade_index >= 0 && grade_index < GRADE_COUNT) ? grade_letters[grade_index][0] : '?';
+}
+
+/**
+ * Grade letter of one mark as a constant string ("A" .. "F")
+ */
+const char* grade_letter_for_marks(float marks) {
+    return grade_letters[grade_index_for_marks(marks)];
+}
+
+/**
+ * Lowest marks of a grade in the active scheme (0 for F)
+ */
+float grade_minimum_marks(int grade_index) {
+    if (grade_index < 0 || grade_index >= GRADE_BOUNDARY_COUNT) return 0.0f;
+    return active_grading_scheme()->minimums[grade_index];
+}
+
+/**
+ * Classify a marks array. The SIMD kernel counts the boundaries each
+ * mark misses, which is its grade index; boundaries are stored so that
+ * this agrees with grade_index_for_marks().
+ * @param marks Marks to classify
+ * @param out Receives one grade index per mark
+ * @param n Number of marks
+ */
+void classify_grades(const float *marks, uint8_t *out, int n) {
+    marks_classify(marks, n, active_grading_scheme()->minimums, GRADE_BOUNDARY_COUNT, out);
+}
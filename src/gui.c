@@ -15,6 +15,9 @@
  */
 
 #include "gui.h"
+#include "logger.h"
+#include <glib-unix.h>
+#include <signal.h>
 
 // Global application data
 static AppData *g_app = NULL;
@@ -63,6 +66,188 @@ static void format_gpa_cell_data(GtkTreeViewColumn *column, GtkCellRenderer *ren
     g_object_set(renderer, "text", buffer, NULL);
 }
 
+/**
+ * Point the student list at a new set of rows. The model is detached
+ * while its rows are replaced, so the view rebuilds once instead of
+ * handling a signal per row.
+ * @param app Application data
+ * @param roll_numbers Students to show, or NULL for every student
+ * @param count Number of roll numbers
+ */
+static void show_student_rows(AppData *app, const int *roll_numbers, int count) {
+    GtkTreeView *tree_view = GTK_TREE_VIEW(app->tree_view);
+
+    g_object_ref(app->student_model);
+    gtk_tree_view_set_model(tree_view, NULL);
+    if (roll_numbers) {
+        student_list_model_show_students(app->student_model, roll_numbers, count);
+    } else {
+        student_list_model_show_all(app->student_model);
+    }
+    gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(app->student_model));
+    g_object_unref(app->student_model);
+
+    app->showing_search_results = roll_numbers != NULL;
+}
+
+/**
+ * Tell the user to wait if a job that needs the records left alone is
+ * unfinished. Exports read a snapshot, so edits may go on beside them.
+ * @param app Application data
+ * @return true if the caller must not change the database now
+ */
+static bool refuse_while_busy(AppData *app) {
+    if (app->exclusive_jobs == 0) return false;
+
+    set_status_message(app, "Please wait for the background task to finish, or cancel it");
+    return true;
+}
+
+/**
+ * Take the database write lock for a change made from the main thread.
+ * Changes are refused while an exclusive job is unfinished: it may be
+ * reading the records, or about to commit results computed from them.
+ * @param app Application data
+ * @return true if the change may go ahead (call end_database_change after)
+ */
+static bool begin_database_change(AppData *app) {
+    if (refuse_while_busy(app)) return false;
+
+    // A running export holds the read lock for one chunk at a time, so
+    // this waits for at most one chunk copy
+    write_lock_database(app->db);
+    return true;
+}
+
+static void end_database_change(AppData *app) {
+    write_unlock_database(app->db);
+}
+
+/**
+ * Take the name index lock as well before changing student names, so a
+ * live search running on its worker never sees a half-made change
+ * @param app Application data
+ * @return true if the change may go ahead (call end_name_change after)
+ */
+static bool begin_name_change(AppData *app) {
+    if (!begin_database_change(app)) return false;
+
+    g_mutex_lock(&app->index_lock);
+    return true;
+}
+
+/**
+ * Release both locks and drop live search results cached from the old names
+ * @param app Application data
+ */
+static void end_name_change(AppData *app) {
+    live_search_invalidate(app->live_search);
+    g_mutex_unlock(&app->index_lock);
+    end_database_change(app);
+}
+
+/**
+ * Show the running job in the progress bar, or hide the bar once the
+ * queue is idle
+ * @param job Running job, or NULL
+ * @param user_data Application data
+ */
+static void on_job_status(const Job *job, void *user_data) {
+    AppData *app = (AppData*)user_data;
+
+    if (!job) {
+        hide_progress(app);
+        gtk_widget_set_visible(app->cancel_job_button, FALSE);
+        return;
+    }
+
+    char text[MAX_STATUS_MESSAGE_LENGTH];
+    double fraction = job_progress(job);
+    snprintf(text, sizeof(text), "%s %d%%", job_name(job), (int)(fraction * 100.0));
+
+    gtk_widget_set_visible(app->progress_bar, TRUE);
+    gtk_widget_set_visible(app->cancel_job_button, TRUE);
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(app->progress_bar), TRUE);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(app->progress_bar), text);
+    update_progress(app, fraction);
+}
+
+/**
+ * Show one page of live search results; the first page replaces the list
+ * @param page Result page (valid only during the call)
+ * @param user_data Application data
+ */
+static void on_live_search_page(const LiveSearchPage *page, void *user_data) {
+    AppData *app = (AppData*)user_data;
+
+    if (page->first_page) {
+        show_student_rows(app, page->roll_numbers, page->count);
+    } else {
+        student_list_model_append_students(app->student_model, page->roll_numbers, page->count);
+    }
+
+    if (!page->last_page) return;
+
+    char status_msg[MAX_STATUS_MESSAGE_LENGTH];
+    if (page->total == 0) {
+        snprintf(status_msg, sizeof(status_msg), "No student name contains or resembles \"%s\"", page->query);
+    } else if (page->kind == LIVE_SEARCH_CLOSEST) {
+        snprintf(status_msg, sizeof(status_msg), "No exact match for \"%s\" - showing %d closest name%s, best first",
+                 page->query, page->total, page->total == 1 ? "" : "s");
+    } else if (page->truncated) {
+        snprintf(status_msg, sizeof(status_msg), "Showing the first %d students matching \"%s\" - keep typing to narrow",
+                 page->total, page->query);
+    } else {
+        snprintf(status_msg, sizeof(status_msg), "Found %d student%s matching \"%s\" - clear the search to show all",
+                 page->total, page->total == 1 ? "" : "s", page->query);
+    }
+    set_status_message(app, status_msg);
+}
+
+/**
+ * Idle callback - refresh the statistics labels once per burst of changes
+ * @param data Application data
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean statistics_update_idle(gpointer data) {
+    AppData *app = (AppData*)data;
+    app->stats_update_source = 0;
+    update_statistics_display(app);
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * Database observer - patch the affected list row and schedule a
+ * statistics refresh (the labels read the running aggregates, so the
+ * cost does not depend on the number of students)
+ * @param change What changed
+ * @param context Application data
+ */
+static void on_database_changed(const StudentChange *change, void *context) {
+    AppData *app = (AppData*)context;
+    if (!app->student_model) return;
+
+    switch (change->kind) {
+        case STUDENT_CHANGE_ADDED:
+            student_list_model_student_added(app->student_model, change->roll_number);
+            break;
+        case STUDENT_CHANGE_MODIFIED:
+            student_list_model_student_changed(app->student_model, change->roll_number);
+            break;
+        case STUDENT_CHANGE_REMOVED:
+            student_list_model_student_removed(app->student_model, change->roll_number, change->position);
+            break;
+        case STUDENT_CHANGE_RESET:
+            refresh_student_list(app);
+            break;
+    }
+
+    if (app->stats_update_source == 0) {
+        app->stats_update_source = g_idle_add(statistics_update_idle, app);
+    }
+    grade_chart_queue_update(app->grade_chart_area);
+}
+
 /* ============================================================================
  * INITIALIZATION AND SETUP FUNCTIONS
  * ============================================================================ */
@@ -91,10 +276,10 @@ void init_gui(int argc, char *argv[]) {
 
     // Improved data loading with fallback options
     char *default_file = get_default_filename();
-    printf("Trying to load data from: %s\n", default_file);
+    LOG_DEBUG("Trying to load data from: %s", default_file);
 
     if (!load_from_file(g_app->db, default_file)) {
-        printf("No existing data found. Offering to create sample data...\n");
+        LOG_INFO("No existing data found. Offering to create sample data...");
 
         GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(g_app->window),
                                                   GTK_DIALOG_MODAL,
@@ -134,6 +319,10 @@ void init_gui(int argc, char *argv[]) {
 
     set_status_message(g_app, info_message);
 
+    // SIGINT/SIGTERM close the window the normal way, saving on the main loop
+    g_unix_signal_add(SIGINT, on_quit_signal, g_app);
+    g_unix_signal_add(SIGTERM, on_quit_signal, g_app);
+
     gtk_widget_show_all(g_app->window);
     gtk_main();
 
@@ -162,14 +351,24 @@ AppData* create_app_data(void) {
     app->selected_course = NULL;
     app->is_editing_mode = false;
     app->auto_save_enabled = false;
+    app->showing_search_results = false;
     app->input_loop_active = false;
     app->students_added_in_session = 0;
     app->welcome_shown = false;
+
+    g_mutex_init(&app->index_lock);
+    app->live_search = live_search_new(app->db, &app->index_lock, on_live_search_page, app);
+
+    app->jobs = job_queue_new(on_job_status, app);
+
+    // List rows and statistics follow the database through its observer
+    app->stats_update_source = 0;
+    add_student_observer(app->db, on_database_changed, app);
     
     strcpy(app->user_name, "User");
     strcpy(app->last_error_message, "");
 
-    printf("Application data created successfully\n");
+    LOG_DEBUG("Application data created successfully");
     return app;
 }
 
@@ -179,13 +378,24 @@ AppData* create_app_data(void) {
  */
 void destroy_app_data(AppData *app) {
     if (app) {
+        // Stop the workers before the records they read go away
+        job_queue_free(app->jobs);
+        app->jobs = NULL;
+        live_search_free(app->live_search);
+        app->live_search = NULL;
+
+        if (app->stats_update_source != 0) {
+            g_source_remove(app->stats_update_source);
+        }
+
         if (app->db) {
             // Auto-save before exit
             save_to_file(app->db, get_default_filename());
             destroy_database(app->db);
         }
+        g_mutex_clear(&app->index_lock);
         g_free(app);
-        printf("Application data destroyed successfully\n");
+        LOG_DEBUG("Application data destroyed successfully");
     }
 }
 
@@ -216,7 +426,7 @@ void setup_main_window(AppData *app) {
     setup_notebook_tabs(app);
     setup_status_bar(app);
 
-    printf("Main window setup completed\n");
+    LOG_DEBUG("Main window setup completed");
 }
 
 /**
@@ -270,6 +480,9 @@ void setup_menu_bar(AppData *app) {
     GtkWidget *calc_stats = gtk_menu_item_new_with_label("Calculate Statistics");
     gtk_menu_shell_append(GTK_MENU_SHELL(stats_menu), calc_stats);
 
+    GtkWidget *grade_chart_item = gtk_menu_item_new_with_label("Grade Distribution Chart");
+    gtk_menu_shell_append(GTK_MENU_SHELL(stats_menu), grade_chart_item);
+
     // Help menu
     GtkWidget *help_menu = gtk_menu_new();
     GtkWidget *help_item = gtk_menu_item_new_with_label("Help");
@@ -298,9 +511,10 @@ void setup_menu_bar(AppData *app) {
     g_signal_connect(sort_roll_asc, "activate", G_CALLBACK(on_sort_by_roll_asc_activate), app);
     g_signal_connect(sort_roll_desc, "activate", G_CALLBACK(on_sort_by_roll_desc_activate), app);
     g_signal_connect(calc_stats, "activate", G_CALLBACK(on_calculate_stats_activate), app);
+    g_signal_connect(grade_chart_item, "activate", G_CALLBACK(on_show_grade_distribution_activate), app);
     g_signal_connect(about_item, "activate", G_CALLBACK(on_about_activate), app);
 
-    printf("Menu bar setup completed\n");
+    LOG_DEBUG("Menu bar setup completed");
 }
 
 /**
@@ -361,7 +575,7 @@ void setup_toolbar(AppData *app) {
     g_signal_connect(app->toolbar_load_button, "clicked", G_CALLBACK(on_toolbar_load_clicked), app);
     g_signal_connect(stats_button, "clicked", G_CALLBACK(on_calculate_stats_activate), app);
 
-    printf("Enhanced toolbar setup completed with FUNCTIONAL buttons\n");
+    LOG_DEBUG("Enhanced toolbar setup completed with FUNCTIONAL buttons");
 }
 
 /**
@@ -447,7 +661,8 @@ void setup_notebook_tabs(AppData *app) {
     // Statistics Tab
     GtkWidget *stats_tab = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
     gtk_container_set_border_width(GTK_CONTAINER(stats_tab), 10);
-    gtk_box_pack_start(GTK_BOX(stats_tab), app->stats_label, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(stats_tab), app->stats_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(stats_tab), app->grade_chart_area, TRUE, TRUE, 0);
 
     // Add tabs to notebook
     gtk_notebook_append_page(GTK_NOTEBOOK(app->notebook), student_tab,
@@ -457,7 +672,7 @@ void setup_notebook_tabs(AppData *app) {
 
     gtk_box_pack_start(GTK_BOX(app->main_box), app->notebook, TRUE, TRUE, 0);
 
-    printf("Notebook tabs setup completed\n");
+    LOG_DEBUG("Notebook tabs setup completed");
 }
 
 /**
@@ -465,17 +680,11 @@ void setup_notebook_tabs(AppData *app) {
  * @param app Application data
  */
 void setup_student_list_view(AppData *app) {
-    // Create list store with additional columns
-    app->list_store = gtk_list_store_new(NUM_STUDENT_COLS,
-                                        G_TYPE_INT,    // Roll Number
-                                        G_TYPE_STRING, // Name
-                                        G_TYPE_FLOAT,  // Marks
-                                        G_TYPE_STRING, // Status
-                                        G_TYPE_INT,    // Number of Courses
-                                        G_TYPE_FLOAT); // GPA
+    // Rows are read from the database on demand; nothing is copied
+    app->student_model = student_list_model_new(app->db);
 
     // Create tree view
-    app->tree_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(app->list_store));
+    app->tree_view = gtk_tree_view_new_with_model(GTK_TREE_MODEL(app->student_model));
     gtk_tree_view_set_rules_hint(GTK_TREE_VIEW(app->tree_view), TRUE);
 
     // Create columns
@@ -540,6 +749,15 @@ void setup_student_list_view(AppData *app) {
     gtk_tree_view_column_set_resizable(column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(app->tree_view), column);
 
+    // Fixed-height rows let the view lay out only the rows on screen
+    static const int column_widths[] = {110, 260, 90, 90, 80, 80};
+    for (int i = 0; i < (int)G_N_ELEMENTS(column_widths); i++) {
+        column = gtk_tree_view_get_column(GTK_TREE_VIEW(app->tree_view), i);
+        gtk_tree_view_column_set_sizing(column, GTK_TREE_VIEW_COLUMN_FIXED);
+        gtk_tree_view_column_set_fixed_width(column, column_widths[i]);
+    }
+    gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(app->tree_view), TRUE);
+
     // Setup selection
     GtkTreeSelection *selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(app->tree_view));
     gtk_tree_selection_set_mode(selection, GTK_SELECTION_SINGLE);
@@ -548,7 +766,7 @@ void setup_student_list_view(AppData *app) {
     // Connect double-click event for showing student details
     g_signal_connect(app->tree_view, "row-activated", G_CALLBACK(on_student_row_activated), app);
 
-    printf("Enhanced student list view setup completed\n");
+    LOG_DEBUG("Enhanced student list view setup completed");
 }
 
 /**
@@ -591,7 +809,7 @@ void setup_student_form(AppData *app) {
     g_signal_connect(app->delete_button, "clicked", G_CALLBACK(on_delete_student_clicked), app);
     g_signal_connect(app->clear_button, "clicked", G_CALLBACK(on_clear_form_clicked), app);
 
-    printf("Student form setup completed\n");
+    LOG_DEBUG("Student form setup completed");
 }
 
 /**
@@ -600,14 +818,15 @@ void setup_student_form(AppData *app) {
  */
 void setup_search_panel(AppData *app) {
     app->search_entry = gtk_entry_new();
-    gtk_entry_set_placeholder_text(GTK_ENTRY(app->search_entry), "Enter roll number to search");
+    gtk_entry_set_placeholder_text(GTK_ENTRY(app->search_entry), "Enter roll number or name to search");
 
     app->search_button = gtk_button_new_with_label("Search");
 
     g_signal_connect(app->search_button, "clicked", G_CALLBACK(on_search_clicked), app);
     g_signal_connect(app->search_entry, "activate", G_CALLBACK(on_search_clicked), app); // Enter key
+    g_signal_connect(app->search_entry, "changed", G_CALLBACK(on_search_entry_changed), app);
 
-    printf("Search panel setup completed\n");
+    LOG_DEBUG("Search panel setup completed");
 }
 
 /**
@@ -632,7 +851,7 @@ void setup_welcome_display(AppData *app) {
 
     update_welcome_display(app);
 
-    printf("Welcome display setup completed\n");
+    LOG_DEBUG("Welcome display setup completed");
 }
 
 /**
@@ -676,7 +895,10 @@ void setup_statistics_panel(AppData *app) {
     gtk_container_add(GTK_CONTAINER(stats_frame), stats_grid);
     app->stats_label = stats_frame;
 
-    printf("Statistics panel setup completed\n");
+    // Marks histogram, redrawn from the running aggregates as records change
+    app->grade_chart_area = grade_chart_new(app->db);
+
+    LOG_DEBUG("Statistics panel setup completed");
 }
 
 /**
@@ -687,18 +909,25 @@ void setup_status_bar(AppData *app) {
     app->status_bar = gtk_statusbar_new();
     app->status_context_id = gtk_statusbar_get_context_id(GTK_STATUSBAR(app->status_bar), "main");
 
-    // Add progress bar
+    // Add progress bar and the cancel button for background jobs
     app->progress_bar = gtk_progress_bar_new();
+    gtk_widget_set_no_show_all(app->progress_bar, TRUE);
     gtk_widget_set_visible(app->progress_bar, FALSE);
 
+    app->cancel_job_button = gtk_button_new_with_label("Cancel");
+    gtk_widget_set_no_show_all(app->cancel_job_button, TRUE);
+    gtk_widget_set_visible(app->cancel_job_button, FALSE);
+    g_signal_connect(app->cancel_job_button, "clicked", G_CALLBACK(on_cancel_job_clicked), app);
+
     GtkWidget *status_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
     gtk_box_pack_start(GTK_BOX(status_box), app->status_bar, TRUE, TRUE, 0);
     gtk_box_pack_start(GTK_BOX(status_box), app->progress_bar, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(status_box), app->cancel_job_button, FALSE, FALSE, 0);
 
     gtk_box_pack_start(GTK_BOX(app->main_box), status_box, FALSE, FALSE, 0);
 
     set_status_message(app, "Ready");
-    printf("Status bar setup completed\n");
+    LOG_DEBUG("Status bar setup completed");
 }
 
 /* ============================================================================
@@ -729,7 +958,7 @@ void on_toolbar_add_clicked(GtkButton *button, gpointer data) {
         start_input_loop(app);
     }
 
-    printf("Toolbar Add button clicked - form ready for new student\n");
+    LOG_DEBUG("Toolbar Add button clicked - form ready for new student");
 }
 
 /**
@@ -749,7 +978,7 @@ void on_toolbar_remove_clicked(GtkButton *button, gpointer data) {
     // Call the main delete function
     on_delete_student_clicked(NULL, app);
 
-    printf("Toolbar Remove button clicked\n");
+    LOG_DEBUG("Toolbar Remove button clicked");
 }
 
 /**
@@ -784,7 +1013,7 @@ void on_toolbar_save_clicked(GtkButton *button, gpointer data) {
                          "Failed to save student records. Please check file permissions.");
     }
 
-    printf("Toolbar Save button clicked\n");
+    LOG_DEBUG("Toolbar Save button clicked");
 }
 
 /**
@@ -806,7 +1035,7 @@ void on_toolbar_load_clicked(GtkButton *button, gpointer data) {
     // Call the main load function
     on_load_file_activate(NULL, app);
 
-    printf("Toolbar Load button clicked\n");
+    LOG_DEBUG("Toolbar Load button clicked");
 }
 
 /* ============================================================================
@@ -833,11 +1062,11 @@ void on_add_student_clicked(GtkButton *button, gpointer data) {
     float marks = atof(marks_text);
 
     // Use enhanced error handling
+    if (!begin_name_change(app)) return;
     StudentError result = add_student(app->db, name, roll_number, marks);
+    end_name_change(app);
 
     if (result == STUDENT_SUCCESS) {
-        refresh_student_list(app);
-        update_statistics_display(app);
 
         app->students_added_in_session++;
 
@@ -887,11 +1116,11 @@ void on_update_student_clicked(GtkButton *button, gpointer data) {
     float old_marks = app->selected_student->marks;
     strcpy(old_name, app->selected_student->name);
 
+    if (!begin_name_change(app)) return;
     StudentError result = modify_student(app->db, app->selected_student->roll_number, name, marks);
+    end_name_change(app);
 
     if (result == STUDENT_SUCCESS) {
-        refresh_student_list(app);
-        update_statistics_display(app);
 
         char success_msg[512];
         snprintf(success_msg, sizeof(success_msg),
@@ -922,6 +1151,8 @@ void on_delete_student_clicked(GtkButton *button, gpointer data) {
         return;
     }
 
+    if (refuse_while_busy(app)) return;
+
     GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(app->window),
                                               GTK_DIALOG_MODAL,
                                               GTK_MESSAGE_QUESTION,
@@ -939,11 +1170,11 @@ void on_delete_student_clicked(GtkButton *button, gpointer data) {
         int deleted_roll = app->selected_student->roll_number;
         strcpy(deleted_name, app->selected_student->name);
 
-        StudentError result = remove_student(app->db, app->selected_student->roll_number);
+        if (!begin_name_change(app)) return;
+        StudentError result = remove_student(app->db, deleted_roll);
+        end_name_change(app);
 
         if (result == STUDENT_SUCCESS) {
-            refresh_student_list(app);
-            update_statistics_display(app);
             clear_form_fields(app);
 
             char success_msg[256];
@@ -971,62 +1202,84 @@ void on_clear_form_clicked(GtkButton *button, gpointer data) {
 }
 
 /**
- * Search button clicked - ENHANCED
- * @param button Button widget
- * @param data Application data
+ * Select and scroll to the list row of a student
+ * @param app Application data
+ * @param roll_number Roll number of the row to select
  */
-void on_search_clicked(GtkButton *button, gpointer data) {
-    AppData *app = (AppData*)data;
+static void select_student_row(AppData *app, int roll_number) {
+    int row = student_list_model_row_of(app->student_model, roll_number);
+    if (row < 0) return;
 
-    const char *search_text = gtk_entry_get_text(GTK_ENTRY(app->search_entry));
-    if (strlen(search_text) == 0) {
-        show_error_dialog(app, "Search Error", "Please enter a roll number to search");
-        return;
-    }
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    GtkTreeSelection *selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(app->tree_view));
+    gtk_tree_selection_select_path(selection, path);
+    gtk_tree_view_scroll_to_cell(GTK_TREE_VIEW(app->tree_view), path, NULL, FALSE, 0.0, 0.0);
+    gtk_tree_path_free(path);
+}
 
-    int roll_number = atoi(search_text);
-    if (roll_number <= 0) {
-        show_error_dialog(app, "Search Error", "Please enter a valid roll number (positive integer)");
-        return;
+/**
+ * Show a student in the form and select their row. The list goes back to
+ * every student only when the row is hidden by a name search.
+ * @param app Application data
+ * @param roll_number Roll number of the student
+ * @return true if the student exists
+ */
+bool jump_to_student(AppData *app, int roll_number) {
+    Student *student = find_student(app->db, roll_number);
+    if (!student) return false;
+
+    if (student_list_model_row_of(app->student_model, roll_number) < 0) {
+        refresh_student_list(app);
     }
 
-    Student *student = find_student(app->db, roll_number);
+    populate_form_fields(app, student);
+    app->selected_student = student;
+    select_student_row(app, roll_number);
 
-    if (student) {
-        populate_form_fields(app, student);
-        app->selected_student = student;
+    // Switch to student management tab
+    gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 0);
+    return true;
+}
 
-        // Highlight the student in the tree view
-        GtkTreeIter iter;
-        gboolean valid = gtk_tree_model_get_iter_first(GTK_TREE_MODEL(app->list_store), &iter);
+/**
+ * Check whether search text is a roll number (digits, optionally padded with spaces)
+ * @param text Search text
+ * @return true if the text should be treated as a roll number
+ */
+static bool is_roll_number_query(const char *text) {
+    while (*text == ' ') text++;
 
-        while (valid) {
-            int row_roll;
-            gtk_tree_model_get(GTK_TREE_MODEL(app->list_store), &iter,
-                             COL_ROLL_NUMBER, &row_roll, -1);
+    bool has_digits = false;
+    while (*text >= '0' && *text <= '9') {
+        has_digits = true;
+        text++;
+    }
+    while (*text == ' ') text++;
 
-            if (row_roll == roll_number) {
-                GtkTreeSelection *selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(app->tree_view));
-                gtk_tree_selection_select_iter(selection, &iter);
+    return has_digits && *text == '\0';
+}
 
-                GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(app->list_store), &iter);
-                gtk_tree_view_scroll_to_cell(GTK_TREE_VIEW(app->tree_view), path, NULL, FALSE, 0.0, 0.0);
-                gtk_tree_path_free(path);
-                break;
-            }
+/**
+ * Search by roll number and select the matching student
+ * @param app Application data
+ * @param search_text Roll number text
+ */
+static void search_by_roll_number(AppData *app, const char *search_text) {
+    int roll_number = atoi(search_text);
+    if (roll_number <= 0) {
+        show_error_dialog(app, "Search Error", "Please enter a valid roll number (positive integer)");
+        return;
+    }
 
-            valid = gtk_tree_model_iter_next(GTK_TREE_MODEL(app->list_store), &iter);
-        }
+    Student *student = find_student(app->db, roll_number);
 
+    if (jump_to_student(app, roll_number)) {
         char success_msg[256];
         snprintf(success_msg, sizeof(success_msg),
                 "Found: %s (Roll: %d, Marks: %.2f, Status: %s)",
                 student->name, student->roll_number, student->marks, student->status);
         set_status_message(app, success_msg);
 
-        // Switch to student management tab
-        gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 0);
-
     } else {
         char message[200];
         snprintf(message, sizeof(message), "Student with roll number %d not found.\n\nTip: Check the roll number and try again.", roll_number);
@@ -1037,6 +1290,94 @@ void on_search_clicked(GtkButton *button, gpointer data) {
     gtk_entry_set_text(GTK_ENTRY(app->search_entry), "");
 }
 
+/**
+ * Search by name and show only the matching students in the list.
+ * Names starting with the text are listed first, then names containing it.
+ * @param app Application data
+ * @param search_text Name fragment
+ */
+static void search_by_name(AppData *app, const char *search_text) {
+    // This answer replaces whatever the live search was about to show
+    live_search_cancel(app->live_search);
+
+    Student **matches = g_new(Student*, NAME_SEARCH_MAX_RESULTS);
+    g_mutex_lock(&app->index_lock);
+    int found = search_students_by_name(app->db, search_text, NAME_SEARCH_SUBSTRING,
+                                        matches, NAME_SEARCH_MAX_RESULTS);
+    bool fuzzy = false;
+
+    // No name contains the text - fall back to the closest spellings
+    if (found == 0) {
+        FuzzyNameMatch fuzzy_matches[FUZZY_SEARCH_MAX_RESULTS];
+        found = fuzzy_search_students_by_name(app->db, search_text, -1,
+                                              fuzzy_matches, FUZZY_SEARCH_MAX_RESULTS);
+        for (int i = 0; i < found; i++) {
+            matches[i] = fuzzy_matches[i].student;
+        }
+        fuzzy = true;
+    }
+    g_mutex_unlock(&app->index_lock);
+
+    if (found == 0) {
+        char message[256];
+        snprintf(message, sizeof(message), "No student name contains or resembles \"%s\".\n\nTip: Search ignores case and extra spaces.", search_text);
+        show_error_dialog(app, "Student Not Found", message);
+        set_status_message(app, "Student not found");
+        g_free(matches);
+        return;
+    }
+
+    int *roll_numbers = g_new(int, found);
+    for (int i = 0; i < found; i++) {
+        roll_numbers[i] = matches[i]->roll_number;
+    }
+    show_student_rows(app, roll_numbers, found);
+    g_free(roll_numbers);
+
+    populate_form_fields(app, matches[0]);
+    app->selected_student = matches[0];
+    select_student_row(app, matches[0]->roll_number);
+
+    char status_msg[MAX_STATUS_MESSAGE_LENGTH];
+    if (fuzzy) {
+        snprintf(status_msg, sizeof(status_msg), "No exact match for \"%s\" - showing %d closest name%s, best first",
+                 search_text, found, found == 1 ? "" : "s");
+    } else if (found >= NAME_SEARCH_MAX_RESULTS) {
+        snprintf(status_msg, sizeof(status_msg), "Showing the first %d students matching \"%s\" - clear the search to show all",
+                 found, search_text);
+    } else {
+        snprintf(status_msg, sizeof(status_msg), "Found %d student%s matching \"%s\" - clear the search to show all",
+                 found, found == 1 ? "" : "s", search_text);
+    }
+    set_status_message(app, status_msg);
+
+    gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 0);
+    g_free(matches);
+}
+
+/**
+ * Search button clicked - roll numbers jump to the student, any other
+ * text filters the list by name (prefix and substring matches, then
+ * the closest spellings when nothing matches)
+ * @param button Button widget
+ * @param data Application data
+ */
+void on_search_clicked(GtkButton *button, gpointer data) {
+    AppData *app = (AppData*)data;
+
+    const char *search_text = gtk_entry_get_text(GTK_ENTRY(app->search_entry));
+    if (strlen(search_text) == 0) {
+        show_error_dialog(app, "Search Error", "Please enter a roll number or name to search");
+        return;
+    }
+
+    if (is_roll_number_query(search_text)) {
+        search_by_roll_number(app, search_text);
+    } else {
+        search_by_name(app, search_text);
+    }
+}
+
 /**
  * Student selected in tree view - ENHANCED WITH VISUAL FEEDBACK
  * @param selection Tree selection
@@ -1100,103 +1441,298 @@ void on_student_row_activated(GtkTreeView *tree_view, GtkTreePath *path,
 }
 
 /* ============================================================================
- * ENHANCED SORTING EVENT HANDLERS - NOW FIXED
+ * BACKGROUND JOBS
  * ============================================================================ */
 
+// StudentProgressFunc adapter for code running inside a job
+static bool report_job_progress(double fraction, void *context) {
+    return job_report_progress((Job*)context, fraction);
+}
+
 /**
- * Sort by marks ascending - FIXED
+ * Report a job that did not succeed
+ * @param app Application data
+ * @param job Finished job
+ * @param outcome JOB_FAILED or JOB_CANCELLED
+ * @param failure_title Error dialog title for failures
+ * @param failure_message Error dialog text for failures
+ */
+static void report_job_failure(AppData *app, Job *job, JobOutcome outcome,
+                               const char *failure_title, const char *failure_message) {
+    char status_msg[MAX_STATUS_MESSAGE_LENGTH];
+    if (outcome == JOB_CANCELLED) {
+        snprintf(status_msg, sizeof(status_msg), "%s cancelled", job_name(job));
+        set_status_message(app, status_msg);
+    } else {
+        snprintf(status_msg, sizeof(status_msg), "%s failed", job_name(job));
+        set_status_message(app, status_msg);
+        show_error_dialog(app, failure_title, failure_message);
+    }
+}
+
+// Sorting: the order is worked out on the worker, then applied here
+typedef struct {
+    AppData *app;
+    SortCriteria criteria;
+    char description[64];
+    int *order;
+    int count;
+} SortJob;
+
+static void free_sort_job(gpointer data) {
+    SortJob *sort = (SortJob*)data;
+    sort->app->exclusive_jobs--;
+    g_free(sort->order);
+    g_free(sort);
+}
+
+static bool run_sort_job(Job *job, void *data) {
+    SortJob *sort = (SortJob*)data;
+    StudentDatabase *db = sort->app->db;
+
+    read_lock_database(sort->app->db);
+    sort->count = db->count;
+    sort->order = g_new(int, sort->count > 0 ? sort->count : 1);
+    bool sorted = compute_sort_order(db, sort->criteria, sort->order, report_job_progress, job);
+    read_unlock_database(sort->app->db);
+
+    return sorted;
+}
+
+static void finish_sort_job(Job *job, JobOutcome outcome, void *data) {
+    SortJob *sort = (SortJob*)data;
+    AppData *app = sort->app;
+
+    if (outcome != JOB_SUCCEEDED) {
+        report_job_failure(app, job, outcome, "Sort Failed", "Not enough memory to sort the student records.");
+        return;
+    }
+
+    // Header sorting would hide the new order
+    gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(app->student_model),
+                                         GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, GTK_SORT_ASCENDING);
+
+    write_lock_database(app->db);
+    bool applied = apply_sort_order(app->db, sort->order, sort->count);
+    write_unlock_database(app->db);
+
+    char status_msg[MAX_STATUS_MESSAGE_LENGTH];
+    snprintf(status_msg, sizeof(status_msg),
+             applied ? "Students sorted by %s" : "Sorting by %s failed", sort->description);
+    set_status_message(app, status_msg);
+
+    LOG_INFO("Sort by %s completed", sort->description);
+}
+
+/**
+ * Sort the students on the worker thread
+ * @param app Application data
+ * @param criteria Sorting criteria
+ * @param description What the sort is by, e.g. "marks (ascending)"
  */
-void on_sort_by_marks_asc_activate(GtkMenuItem *menuitem, gpointer data) {
-    AppData *app = (AppData*)data;
+static void start_sort_job(AppData *app, SortCriteria criteria, const char *description) {
+    SortJob *sort = g_new0(SortJob, 1);
+    sort->app = app;
+    sort->criteria = criteria;
+    g_strlcpy(sort->description, description, sizeof(sort->description));
+
+    char name[JOB_NAME_LENGTH];
+    snprintf(name, sizeof(name), "Sorting by %s", description);
+    app->exclusive_jobs++;
+    job_queue_submit(app->jobs, name, run_sort_job, finish_sort_job, sort, free_sort_job);
+}
 
-    show_progress(app, "Sorting by marks (ascending)...");
-    sort_students(app->db, SORT_BY_MARKS_ASC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by marks (ascending)");
+// Loading: records are read into a private database, then swapped in here
+typedef struct {
+    AppData *app;
+    char *filename;
+    StudentDatabase *loaded;
+} LoadJob;
 
-    printf("Sort by marks ascending completed\n");
+static void free_load_job(gpointer data) {
+    LoadJob *load = (LoadJob*)data;
+    load->app->exclusive_jobs--;
+    destroy_database(load->loaded);
+    g_free(load->filename);
+    g_free(load);
+}
+
+static bool run_load_job(Job *job, void *data) {
+    LoadJob *load = (LoadJob*)data;
+
+    load->loaded = create_database();
+    if (!load->loaded) return false;
+
+    return load_from_file_with_progress(load->loaded, load->filename, report_job_progress, job);
+}
+
+static void finish_load_job(Job *job, JobOutcome outcome, void *data) {
+    LoadJob *load = (LoadJob*)data;
+    AppData *app = load->app;
+
+    if (outcome != JOB_SUCCEEDED) {
+        report_job_failure(app, job, outcome, "Load Failed",
+                           "Failed to load file. Please check if the file exists and is readable.");
+        return;
+    }
+
+    // The old records go to the job's database and are freed with it
+    write_lock_database(app->db);
+    g_mutex_lock(&app->index_lock);
+    swap_database_records(app->db, load->loaded);
+    live_search_invalidate(app->live_search);
+    g_mutex_unlock(&app->index_lock);
+    write_unlock_database(app->db);
+
+    clear_form_fields(app);
+    set_status_message(app, "File loaded successfully");
+    show_success_dialog(app, "Load Successful", "Student records loaded successfully!");
+}
+
+// Exporting: the worker writes the records as they were when the user chose the file
+typedef struct {
+    AppData *app;
+    char *filename;
+    Snapshot *snapshot;
+} ExportJob;
+
+static void free_export_job(gpointer data) {
+    ExportJob *export_job = (ExportJob*)data;
+    close_student_snapshot(export_job->app->db, export_job->snapshot);
+    g_free(export_job->filename);
+    g_free(export_job);
+}
+
+static bool run_export_job(Job *job, void *data) {
+    ExportJob *export_job = (ExportJob*)data;
+
+    return export_snapshot_to_csv(export_job->app->db, export_job->snapshot,
+                                  export_job->filename, report_job_progress, job);
+}
+
+static void finish_export_job(Job *job, JobOutcome outcome, void *data) {
+    ExportJob *export_job = (ExportJob*)data;
+    AppData *app = export_job->app;
+
+    if (outcome != JOB_SUCCEEDED) {
+        report_job_failure(app, job, outcome, "Export Failed",
+                           "Failed to export file. Please check file permissions.");
+        return;
+    }
+
+    set_status_message(app, "Exported to CSV successfully");
+    show_success_dialog(app, "Export Successful", "Student records exported to CSV successfully!");
+}
+
+// Statistics: one pass on the worker, labels filled in here
+typedef struct {
+    AppData *app;
+    StatisticsSummary summary;
+} StatisticsJob;
+
+static void free_statistics_job(gpointer data) {
+    StatisticsJob *stats = (StatisticsJob*)data;
+    stats->app->exclusive_jobs--;
+    g_free(stats);
+}
+
+static bool run_statistics_job(Job *job, void *data) {
+    StatisticsJob *stats = (StatisticsJob*)data;
+
+    read_lock_database(stats->app->db);
+    stats->summary = compute_statistics_summary(stats->app->db);
+    read_unlock_database(stats->app->db);
+
+    return job_report_progress(job, 1.0);
+}
+
+static void finish_statistics_job(Job *job, JobOutcome outcome, void *data) {
+    StatisticsJob *stats = (StatisticsJob*)data;
+    AppData *app = stats->app;
+
+    if (outcome != JOB_SUCCEEDED) {
+        report_job_failure(app, job, outcome, "Statistics Failed", "Statistics could not be calculated.");
+        return;
+    }
+
+    show_statistics_summary(app, &stats->summary);
+
+    // Switch to statistics tab
+    gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 1);
+    set_status_message(app, "Statistics calculated and displayed");
 }
 
 /**
- * Sort by marks descending - FIXED
+ * Cancel button next to the progress bar clicked
+ * @param button Button widget
+ * @param data Application data
  */
-void on_sort_by_marks_desc_activate(GtkMenuItem *menuitem, gpointer data) {
+void on_cancel_job_clicked(GtkButton *button, gpointer data) {
     AppData *app = (AppData*)data;
+    job_queue_cancel_all(app->jobs);
+}
+
+/* ============================================================================
+ * ENHANCED SORTING EVENT HANDLERS - NOW FIXED
+ * ============================================================================ */
 
-    show_progress(app, "Sorting by marks (descending)...");
-    sort_students(app->db, SORT_BY_MARKS_DESC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by marks (descending)");
+/**
+ * Sort by marks ascending - FIXED
+ */
+void on_sort_by_marks_asc_activate(GtkMenuItem *menuitem, gpointer data) {
+    start_sort_job((AppData*)data, SORT_BY_MARKS_ASC, "marks (ascending)");
+}
 
-    printf("Sort by marks descending completed\n");
+/**
+ * Sort by marks descending - FIXED
+ */
+void on_sort_by_marks_desc_activate(GtkMenuItem *menuitem, gpointer data) {
+    start_sort_job((AppData*)data, SORT_BY_MARKS_DESC, "marks (descending)");
 }
 
 /**
  * Sort by name ascending - FIXED
  */
 void on_sort_by_name_asc_activate(GtkMenuItem *menuitem, gpointer data) {
-    AppData *app = (AppData*)data;
-
-    show_progress(app, "Sorting by name (A-Z)...");
-    sort_students(app->db, SORT_BY_NAME_ASC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by name (A-Z)");
-
-    printf("Sort by name ascending completed\n");
+    start_sort_job((AppData*)data, SORT_BY_NAME_ASC, "name (A-Z)");
 }
 
 /**
  * Sort by name descending - FIXED
  */
 void on_sort_by_name_desc_activate(GtkMenuItem *menuitem, gpointer data) {
-    AppData *app = (AppData*)data;
-
-    show_progress(app, "Sorting by name (Z-A)...");
-    sort_students(app->db, SORT_BY_NAME_DESC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by name (Z-A)");
-
-    printf("Sort by name descending completed\n");
+    start_sort_job((AppData*)data, SORT_BY_NAME_DESC, "name (Z-A)");
 }
 
 /**
  * Sort by roll number ascending - FIXED
  */
 void on_sort_by_roll_asc_activate(GtkMenuItem *menuitem, gpointer data) {
-    AppData *app = (AppData*)data;
-
-    show_progress(app, "Sorting by roll number (ascending)...");
-    sort_students(app->db, SORT_BY_ROLL_NUMBER_ASC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by roll number (ascending)");
-
-    printf("Sort by roll number ascending completed\n");
+    start_sort_job((AppData*)data, SORT_BY_ROLL_NUMBER_ASC, "roll number (ascending)");
 }
 
 /**
  * Sort by roll number descending - FIXED
  */
 void on_sort_by_roll_desc_activate(GtkMenuItem *menuitem, gpointer data) {
-    AppData *app = (AppData*)data;
-
-    show_progress(app, "Sorting by roll number (descending)...");
-    sort_students(app->db, SORT_BY_ROLL_NUMBER_DESC);
-    refresh_student_list(app);
-    hide_progress(app);
-    set_status_message(app, "Students sorted by roll number (descending)");
-
-    printf("Sort by roll number descending completed\n");
+    start_sort_job((AppData*)data, SORT_BY_ROLL_NUMBER_DESC, "roll number (descending)");
 }
 
 /* ============================================================================
  * WINDOW EVENT HANDLERS
  * ============================================================================ */
 
+/**
+ * SIGINT/SIGTERM arrived (dispatched on the main loop by GLib)
+ * @param data Application data
+ * @return G_SOURCE_REMOVE
+ */
+gboolean on_quit_signal(gpointer data) {
+    LOG_INFO("Quit signal received");
+    on_window_destroy(NULL, data);
+    return G_SOURCE_REMOVE;
+}
+
 /**
  * Window destroy handler
  * @param widget Window widget
@@ -1208,7 +1744,7 @@ void on_window_destroy(GtkWidget *widget, gpointer data) {
     // Auto-save before exit
     if (app && app->db) {
         if (has_unsaved_changes(app->db)) {
-            printf("Auto-saving before exit...\n");
+            LOG_INFO("Auto-saving before exit...");
             save_to_file(app->db, get_default_filename());
         }
     }
@@ -1325,20 +1861,11 @@ void on_load_file_activate(GtkMenuItem *menuitem, gpointer data) {
     if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
         char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
 
-        show_progress(app, "Loading file...");
-        if (load_from_file(app->db, filename)) {
-            refresh_student_list(app);
-            update_statistics_display(app);
-            clear_form_fields(app);
-            hide_progress(app);
-            set_status_message(app, "File loaded successfully");
-            show_success_dialog(app, "Load Successful", "Student records loaded successfully!");
-        } else {
-            hide_progress(app);
-            show_error_dialog(app, "Load Failed", "Failed to load file. Please check if the file exists and is readable.");
-        }
-
-        g_free(filename);
+        LoadJob *load = g_new0(LoadJob, 1);
+        load->app = app;
+        load->filename = filename;
+        app->exclusive_jobs++;
+        job_queue_submit(app->jobs, "Loading file", run_load_job, finish_load_job, load, free_load_job);
     }
 
     gtk_widget_destroy(dialog);
@@ -1364,17 +1891,12 @@ void on_export_csv_activate(GtkMenuItem *menuitem, gpointer data) {
     if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
         char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
 
-        show_progress(app, "Exporting to CSV...");
-        if (export_to_csv(app->db, filename)) {
-            hide_progress(app);
-            set_status_message(app, "Exported to CSV successfully");
-            show_success_dialog(app, "Export Successful", "Student records exported to CSV successfully!");
-        } else {
-            hide_progress(app);
-            show_error_dialog(app, "Export Failed", "Failed to export file. Please check file permissions.");
-        }
-
-        g_free(filename);
+        ExportJob *export_job = g_new0(ExportJob, 1);
+        export_job->app = app;
+        export_job->filename = filename;
+        export_job->snapshot = open_student_snapshot(app->db);
+        job_queue_submit(app->jobs, "Exporting to CSV", run_export_job, finish_export_job,
+                         export_job, free_export_job);
     }
 
     gtk_widget_destroy(dialog);
@@ -1388,13 +1910,11 @@ void on_export_csv_activate(GtkMenuItem *menuitem, gpointer data) {
 void on_calculate_stats_activate(GtkMenuItem *menuitem, gpointer data) {
     AppData *app = (AppData*)data;
 
-    show_progress(app, "Calculating statistics...");
-    update_statistics_display(app);
-    hide_progress(app);
-
-    // Switch to statistics tab
-    gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 1);
-    set_status_message(app, "Statistics calculated and displayed");
+    StatisticsJob *stats = g_new0(StatisticsJob, 1);
+    stats->app = app;
+    app->exclusive_jobs++;
+    job_queue_submit(app->jobs, "Calculating statistics", run_statistics_job, finish_statistics_job,
+                     stats, free_statistics_job);
 }
 
 /**
@@ -1439,30 +1959,14 @@ void on_about_activate(GtkMenuItem *menuitem, gpointer data) {
  * @param app Application data
  */
 void refresh_student_list(AppData *app) {
-    if (!app || !app->list_store || !app->db) {
+    if (!app || !app->student_model || !app->db) {
         return;
     }
 
-    // Clear existing data
-    gtk_list_store_clear(app->list_store);
-
-    // Add all students to the list
-    for (int i = 0; i < app->db->count; i++) {
-        if (app->db->students[i].is_active) {
-            GtkTreeIter iter;
-            gtk_list_store_append(app->list_store, &iter);
-            gtk_list_store_set(app->list_store, &iter,
-                              COL_ROLL_NUMBER, app->db->students[i].roll_number,
-                              COL_NAME, app->db->students[i].name,
-                              COL_MARKS, app->db->students[i].marks,
-                              COL_STATUS, app->db->students[i].status,
-                              COL_COURSES, app->db->students[i].course_count,
-                              COL_GPA, app->db->students[i].gpa,
-                              -1);
-        }
-    }
+    // Rows are read lazily, so this only resets the model
+    show_student_rows(app, NULL, 0);
 
-    printf("Student list refreshed with %d active students\n", app->db->count);
+    LOG_DEBUG("Student list refreshed with %d active students", app->db->count);
 }
 
 /**
@@ -1488,7 +1992,7 @@ void clear_form_fields(AppData *app) {
     app->selected_student = NULL;
     app->is_editing_mode = false;
 
-    printf("Form fields cleared\n");
+    LOG_DEBUG("Form fields cleared");
 }
 
 /**
@@ -1514,7 +2018,7 @@ void populate_form_fields(AppData *app, Student *student) {
     gtk_widget_set_sensitive(app->delete_button, TRUE);
     gtk_widget_set_sensitive(app->toolbar_remove_button, TRUE);
 
-    printf("Form populated with student: %s (Roll: %d)\n", student->name, student->roll_number);
+    LOG_DEBUG("Form populated with student: %s (Roll: %d)", student->name, student->roll_number);
 }
 
 float calculate_average_gpa(StudentDatabase * db);
@@ -1526,8 +2030,19 @@ float calculate_average_gpa(StudentDatabase * db);
 void update_statistics_display(AppData *app) {
     if (!app || !app->db) return;
 
-    Statistics stats = calculate_statistics(app->db);
-    float avg_gpa = calculate_average_gpa(app->db);
+    // One fused pass feeds every label
+    StatisticsSummary summary = compute_statistics_summary(app->db);
+    show_statistics_summary(app, &summary);
+}
+
+/**
+ * Fill the statistics labels from a summary
+ * @param app Application data
+ * @param summary Summary of the current records
+ */
+void show_statistics_summary(AppData *app, const StatisticsSummary *summary) {
+    Statistics stats = statistics_from_summary(summary);
+    float avg_gpa = summary_average_gpa(summary);
 
     char total_text[100];
     char average_text[100];
@@ -1548,7 +2063,7 @@ void update_statistics_display(AppData *app) {
     gtk_label_set_text(GTK_LABEL(app->failed_label), failed_text);
     gtk_label_set_text(GTK_LABEL(app->gpa_label), gpa_text);
 
-    printf("Statistics display updated\n");
+    LOG_DEBUG("Statistics display updated");
 }
 
 /**
@@ -1564,7 +2079,7 @@ void update_welcome_display(AppData *app) {
 
     gtk_label_set_text(GTK_LABEL(app->welcome_label), welcome_text);
 
-    printf("Welcome display updated for user: %s\n", app->user_name);
+    LOG_DEBUG("Welcome display updated for user: %s", app->user_name);
 }
 
 /* ============================================================================
@@ -1790,7 +2305,7 @@ void show_welcome_dialog(AppData *app) {
 
     app->welcome_shown = true;
 
-    printf("Welcome dialog completed for user: %s\n", app->user_name);
+    LOG_DEBUG("Welcome dialog completed for user: %s", app->user_name);
 }
 
 /**
@@ -1950,7 +2465,7 @@ void start_input_loop(AppData *app) {
     app->students_added_in_session = 0;
 
     set_status_message(app, "Input loop started - you can add multiple students consecutively");
-    printf("Input loop started\n");
+    LOG_INFO("Input loop started");
 }
 
 /**
@@ -1968,7 +2483,7 @@ void stop_input_loop(AppData *app) {
             app->students_added_in_session);
     set_status_message(app, final_msg);
 
-    printf("Input loop stopped - %d students added\n", app->students_added_in_session);
+    LOG_INFO("Input loop stopped - %d students added", app->students_added_in_session);
 }
 
 /**
@@ -2053,7 +2568,7 @@ void enable_auto_save(AppData *app) {
     // Set up auto-save timer (every 30 seconds)
     g_timeout_add_seconds(AUTO_SAVE_INTERVAL_SECONDS, auto_save_timer_callback, app);
 
-    printf("Auto-save enabled (interval: %d seconds)\n", AUTO_SAVE_INTERVAL_SECONDS);
+    LOG_INFO("Auto-save enabled (interval: %d seconds)", AUTO_SAVE_INTERVAL_SECONDS);
 }
 
 /**
@@ -2064,7 +2579,7 @@ void disable_auto_save(AppData *app) {
     if (!app) return;
 
     app->auto_save_enabled = false;
-    printf("Auto-save disabled\n");
+    LOG_INFO("Auto-save disabled");
 }
 
 /**
@@ -2080,12 +2595,12 @@ gboolean auto_save_timer_callback(gpointer data) {
     }
 
     if (has_unsaved_changes(app->db)) {
-        printf("Auto-saving changes...\n");
+        LOG_DEBUG("Auto-saving changes...");
         if (save_to_file(app->db, get_default_filename())) {
             mark_database_saved(app->db);
-            printf("Auto-save completed successfully\n");
+            LOG_DEBUG("Auto-save completed successfully");
         } else {
-            printf("Auto-save failed\n");
+            LOG_ERROR("Auto-save failed");
         }
     }
 
@@ -2123,15 +2638,10 @@ void format_gpa_display(float gpa, char *buffer, size_t buffer_size) {
 /**
  * Get formatted grade letter for display
  * @param score Score value
- * @return Grade letter string
+ * @return Grade letter string (constant, from the active grading scheme)
  */
 const char* format_grade_letter(float score) {
-    if (score >= 90.0f) return "A";
-    else if (score >= 80.0f) return "B";
-    else if (score >= 70.0f) return "C";
-    else if (score >= 60.0f) return "D";
-    else if (score >= 40.0f) return "E";
-    else return "F";
+    return grade_letter_for_marks(score);
 }
 
 /* ============================================================================
@@ -2147,7 +2657,7 @@ void refresh_course_list(AppData *app, Student *student) {
     if (!app || !student) return;
 
     // This is a placeholder for future course management implementation
-    printf("Course list refresh requested for student: %s\n", student->name);
+    LOG_DEBUG("Course list refresh requested for student: %s", student->name);
 }
 
 /**
@@ -2158,7 +2668,7 @@ void clear_course_form_fields(AppData *app) {
     if (!app) return;
 
     // This is a placeholder for future course management implementation
-    printf("Course form fields cleared\n");
+    LOG_DEBUG("Course form fields cleared");
 }
 
 /**
@@ -2194,7 +2704,7 @@ void on_course_selected(GtkTreeSelection *selection, gpointer data) {
     AppData *app = (AppData*)data;
 
     // Placeholder for course selection handling
-    printf("Course selection changed\n");
+    LOG_DEBUG("Course selection changed");
 }
 
 /* ============================================================================
@@ -2227,7 +2737,7 @@ void apply_theme(AppData *app) {
 
     g_object_unref(css_provider);
 
-    printf("Theme applied successfully\n");
+    LOG_DEBUG("Theme applied successfully");
 }
 
 /**
@@ -2243,7 +2753,7 @@ void set_widget_styles(AppData *app) {
         gtk_style_context_add_class(context, "welcome-label");
     }
 
-    printf("Widget styles applied\n");
+    LOG_DEBUG("Widget styles applied");
 }
 
 /* ============================================================================
@@ -2261,10 +2771,8 @@ void display_advanced_statistics(AppData *app) {
                        "Advanced statistics features including charts and detailed reports will be available soon!");
 }
 
-void get_grade_distribution(StudentDatabase * db, int * arr);
-
 /**
- * Show grade distribution chart (placeholder)
+ * Show the grade distribution chart on the statistics tab
  * @param app Application data
  */
 void show_grade_distribution_chart(AppData *app) {
@@ -2273,24 +2781,19 @@ void show_grade_distribution_chart(AppData *app) {
     int distribution[6];
     get_grade_distribution(app->db, distribution);
 
-    char message[512];
+    char message[MAX_STATUS_MESSAGE_LENGTH];
     snprintf(message, sizeof(message),
-            "Grade Distribution:\n\n"
-            "A (90-100): %d students\n"
-            "B (80-89):  %d students\n"
-            "C (70-79):  %d students\n"
-            "D (60-69):  %d students\n"
-            "E (40-59):  %d students\n"
-            "F (0-39):   %d students\n\n"
-            "Visual charts coming in next update!",
+            "Grade distribution: A %d | B %d | C %d | D %d | E %d | F %d",
             distribution[0], distribution[1], distribution[2],
             distribution[3], distribution[4], distribution[5]);
+    set_status_message(app, message);
 
-    show_message_dialog(app->window, GTK_MESSAGE_INFO, "Grade Distribution", message);
+    grade_chart_queue_update(app->grade_chart_area);
+    gtk_notebook_set_current_page(GTK_NOTEBOOK(app->notebook), 1);
 }
 
 /**
- * Create grade distribution window (placeholder)
+ * Create grade distribution window
  * @param app Application data
  */
 void create_grade_distribution_window(AppData *app) {
@@ -2302,7 +2805,9 @@ void create_grade_distribution_window(AppData *app) {
  * ============================================================================ */
 
 /**
- * Search entry changed handler
+ * Search entry changed handler - live search. Name text is queried on the
+ * search worker once typing pauses; each keystroke supersedes the last
+ * query, so the entry never waits on the database.
  * @param entry Search entry widget
  * @param data Application data
  */
@@ -2312,11 +2817,25 @@ void on_search_entry_changed(GtkEntry *entry, gpointer data) {
     const char *text = gtk_entry_get_text(entry);
 
     if (strlen(text) == 0) {
-        set_status_message(app, "Enter roll number to search");
-    } else {
+        live_search_cancel(app->live_search);
+
+        // Bring back the full list after a name search
+        if (app->showing_search_results) {
+            refresh_student_list(app);
+        }
+        set_status_message(app, "Enter roll number or name to search");
+    } else if (is_roll_number_query(text)) {
+        live_search_cancel(app->live_search);
+
         char status_msg[100];
         snprintf(status_msg, sizeof(status_msg), "Press Enter or click Search to find roll number %s", text);
         set_status_message(app, status_msg);
+    } else {
+        live_search_update(app->live_search, text);
+
+        char status_msg[100];
+        snprintf(status_msg, sizeof(status_msg), "Searching names matching %s...", text);
+        set_status_message(app, status_msg);
     }
 }
 
@@ -2329,6 +2848,9 @@ void on_search_clear_clicked(GtkButton *button, gpointer data) {
     AppData *app = (AppData*)data;
 
     gtk_entry_set_text(GTK_ENTRY(app->search_entry), "");
+    if (app->showing_search_results) {
+        refresh_student_list(app);
+    }
     clear_form_fields(app);
     set_status_message(app, "Search cleared");
 }
@@ -2345,12 +2867,8 @@ void on_search_clear_clicked(GtkButton *button, gpointer data) {
 void update_progress(AppData *app, double fraction) {
     if (!app || !app->progress_bar) return;
 
+    // Called from the main loop as jobs report progress, so no nested iteration
     gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(app->progress_bar), fraction);
-
-    // Force GUI update
-    while (gtk_events_pending()) {
-        gtk_main_iteration();
-    }
 }
 
 /**
@@ -2395,7 +2913,7 @@ static void setup_keyboard_shortcuts(AppData *app) {
     // Future implementation could include:
     // Ctrl+S for save, Ctrl+O for open, Ctrl+N for new student, etc.
 
-    printf("Keyboard shortcuts setup (placeholder)\n");
+    LOG_DEBUG("Keyboard shortcuts setup (placeholder)");
 }
 
 /* ============================================================================
@@ -2440,7 +2958,7 @@ void on_create_backup_activate(GtkMenuItem *menuitem, gpointer data) {
 }
 
 /**
- * Show grade distribution menu item (placeholder)
+ * Show grade distribution menu item
  * @param menuitem Menu item
  * @param data Application data
  */
@@ -2511,7 +3029,7 @@ bool validate_course_input_fields(AppData *app) {
 void populate_course_form_fields(AppData *app, Course *course) {
     // Placeholder for course form population
     if (app && course) {
-        printf("Course form population requested for: %s\n", course->course_name);
+        LOG_DEBUG("Course form population requested for: %s", course->course_name);
     }
 }
 
@@ -2525,7 +3043,7 @@ void populate_course_form_fields(AppData *app, Course *course) {
  */
 void setup_course_management_panel(AppData *app) {
     // Placeholder for future course management UI
-    printf("Course management panel setup (placeholder)\n");
+    LOG_DEBUG("Course management panel setup (placeholder)");
 }
 
 /**
@@ -2534,7 +3052,7 @@ void setup_course_management_panel(AppData *app) {
  */
 void create_student_details_dialog(AppData *app) {
     // This is already implemented in show_student_details_dialog
-    printf("Student details dialog structure ready\n");
+    LOG_DEBUG("Student details dialog structure ready");
 }
 
 /**
@@ -2545,7 +3063,7 @@ void create_student_details_dialog(AppData *app) {
 void populate_student_details(AppData *app, Student *student) {
     // Already implemented in show_student_details_dialog
     if (app && student) {
-        printf("Student details populated for: %s\n", student->name);
+        LOG_DEBUG("Student details populated for: %s", student->name);
     }
 }
 
@@ -2558,7 +3076,7 @@ void populate_student_details(AppData *app, Student *student) {
  */
 __attribute__((constructor))
 void gui_module_loaded(void) {
-    printf("GUI module loaded successfully - all functions implemented\n");
+    LOG_DEBUG("GUI module loaded successfully - all functions implemented");
 }
 
 /**
@@ -2566,7 +3084,7 @@ void gui_module_loaded(void) {
  */
 __attribute__((destructor))
 void gui_module_unloaded(void) {
-    printf("GUI module unloaded - cleanup completed\n");
+    LOG_DEBUG("GUI module unloaded - cleanup completed");
 }
 
 /*
@@ -0,0 +1,261 @@
+/*
+ * File: src/job_queue.c
+ * Path: SchoolRecordSystem/src/job_queue.c
+ * Description: Background jobs with progress, cancellation and main-loop completion
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "job_queue.h"
+#include <string.h>
+
+// Progress is stored as an integer so workers can publish it atomically
+#define JOB_PROGRESS_SCALE 10000
+
+struct Job {
+    JobQueue *queue;
+    char name[JOB_NAME_LENGTH];
+    JobRunFunc run;
+    JobDoneFunc done;
+    void *data;
+    GDestroyNotify free_data;
+    gint cancelled;
+    gint progress;                       // Parts per JOB_PROGRESS_SCALE
+    JobOutcome outcome;                  // Set by the worker before completion
+};
+
+struct JobQueue {
+    JobStatusFunc on_status;
+    void *user_data;
+    GThreadPool *pool;                   // Single worker; jobs never overlap
+    GQueue pending;                      // Jobs not yet handed to the worker
+    Job *running;                        // Handed to the worker, done callback not yet run
+    gint progress_queued;                // A progress idle is already scheduled
+    gint ref_count;                      // Owner plus queued idles
+    gint closed;
+};
+
+static void run_job(gpointer data, gpointer user_data);
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+/**
+ * Create a job queue with its worker thread
+ * @param on_status Receives progress on the main loop (may be NULL)
+ * @param user_data Passed to on_status
+ * @return New job queue
+ */
+JobQueue* job_queue_new(JobStatusFunc on_status, void *user_data) {
+    JobQueue *queue = g_new0(JobQueue, 1);
+    queue->on_status = on_status;
+    queue->user_data = user_data;
+    queue->ref_count = 1;
+    g_queue_init(&queue->pending);
+
+    queue->pool = g_thread_pool_new(run_job, queue, 1, FALSE, NULL);
+    return queue;
+}
+
+static void job_queue_unref(JobQueue *queue) {
+    if (!g_atomic_int_dec_and_test(&queue->ref_count)) return;
+    g_free(queue);
+}
+
+static void job_free(Job *job) {
+    if (job->free_data) {
+        job->free_data(job->data);
+    }
+    g_free(job);
+}
+
+/**
+ * Cancel every job, wait for the running one to return and release the
+ * queue. A completion still queued on the main loop is discarded.
+ * @param queue Job queue to free
+ */
+void job_queue_free(JobQueue *queue) {
+    if (!queue) return;
+
+    g_atomic_int_set(&queue->closed, 1);
+    if (queue->running) {
+        g_atomic_int_set(&queue->running->cancelled, 1);
+    }
+
+    Job *job;
+    while ((job = g_queue_pop_head(&queue->pending)) != NULL) {
+        job_free(job);
+    }
+
+    g_thread_pool_free(queue->pool, FALSE, TRUE);
+    job_queue_unref(queue);
+}
+
+/* ============================================================================
+ * MAIN LOOP SIDE
+ * ============================================================================ */
+
+static void report_status(JobQueue *queue) {
+    if (queue->on_status) {
+        queue->on_status(queue->running, queue->user_data);
+    }
+}
+
+static void start_next_job(JobQueue *queue) {
+    queue->running = g_queue_pop_head(&queue->pending);
+    report_status(queue);
+
+    if (queue->running) {
+        g_thread_pool_push(queue->pool, queue->running, NULL);
+    }
+}
+
+static gboolean finish_job(gpointer data) {
+    Job *job = (Job*)data;
+    JobQueue *queue = job->queue;
+
+    if (!g_atomic_int_get(&queue->closed)) {
+        if (job->done) {
+            job->done(job, job->outcome, job->data);
+        }
+        queue->running = NULL;
+        start_next_job(queue);
+    }
+
+    job_free(job);
+    job_queue_unref(queue);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean deliver_progress(gpointer data) {
+    JobQueue *queue = (JobQueue*)data;
+
+    g_atomic_int_set(&queue->progress_queued, 0);
+    if (!g_atomic_int_get(&queue->closed) && queue->running) {
+        report_status(queue);
+    }
+
+    job_queue_unref(queue);
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * Queue a job behind any running or waiting ones
+ * @param queue Job queue
+ * @param name Short description shown while the job runs
+ * @param run Work done on the worker thread
+ * @param done Completion on the main loop (may be NULL)
+ * @param data Passed to run and done
+ * @param free_data Releases data after done (may be NULL)
+ * @return The queued job
+ */
+Job* job_queue_submit(JobQueue *queue, const char *name, JobRunFunc run, JobDoneFunc done,
+                      void *data, GDestroyNotify free_data) {
+    Job *job = g_new0(Job, 1);
+    job->queue = queue;
+    g_strlcpy(job->name, name ? name : "", sizeof(job->name));
+    job->run = run;
+    job->done = done;
+    job->data = data;
+    job->free_data = free_data;
+
+    g_queue_push_tail(&queue->pending, job);
+    if (!queue->running) {
+        start_next_job(queue);
+    }
+    return job;
+}
+
+/**
+ * Cancel the running job and every queued one. Queued jobs get their
+ * done callback at once; the running job gets it when it next checks.
+ * @param queue Job queue
+ */
+void job_queue_cancel_all(JobQueue *queue) {
+    if (!queue) return;
+
+    if (queue->running) {
+        g_atomic_int_set(&queue->running->cancelled, 1);
+    }
+
+    Job *job;
+    while ((job = g_queue_pop_head(&queue->pending)) != NULL) {
+        if (job->done) {
+            job->done(job, JOB_CANCELLED, job->data);
+        }
+        job_free(job);
+    }
+}
+
+/**
+ * Check whether any job is unfinished
+ * @param queue Job queue
+ * @return true while a job runs, waits, or awaits its done callback
+ */
+bool job_queue_busy(const JobQueue *queue) {
+    return queue && (queue->running || !g_queue_is_empty(&queue->pending));
+}
+
+/* ============================================================================
+ * JOB ACCESS
+ * ============================================================================ */
+
+const char* job_name(const Job *job) {
+    return job ? job->name : "";
+}
+
+double job_progress(const Job *job) {
+    if (!job) return 0.0;
+    return (double)g_atomic_int_get(&((Job*)job)->progress) / JOB_PROGRESS_SCALE;
+}
+
+bool job_is_cancelled(const Job *job) {
+    return job && g_atomic_int_get(&((Job*)job)->cancelled);
+}
+
+/**
+ * Publish progress from the worker. Updates are coalesced: the main loop
+ * sees at most one pending refresh, carrying the latest fraction.
+ * @param job Running job
+ * @param fraction Share of the work done (clamped to 0.0 - 1.0)
+ * @return false once the job has been cancelled, so loops can stop
+ */
+bool job_report_progress(Job *job, double fraction) {
+    if (fraction < 0.0) fraction = 0.0;
+    if (fraction > 1.0) fraction = 1.0;
+
+    g_atomic_int_set(&job->progress, (gint)(fraction * JOB_PROGRESS_SCALE));
+
+    JobQueue *queue = job->queue;
+    if (g_atomic_int_compare_and_exchange(&queue->progress_queued, 0, 1)) {
+        g_atomic_int_inc(&queue->ref_count);
+        g_idle_add(deliver_progress, queue);
+    }
+
+    return !job_is_cancelled(job);
+}
+
+/* ============================================================================
+ * WORKER SIDE
+ * ============================================================================ */
+
+static void run_job(gpointer data, gpointer user_data) {
+    Job *job = (Job*)data;
+    JobQueue *queue = (JobQueue*)user_data;
+
+    bool succeeded = false;
+    if (!job_is_cancelled(job)) {
+        succeeded = job->run(job, job->data);
+    }
+
+    if (job_is_cancelled(job)) {
+        job->outcome = JOB_CANCELLED;
+    } else {
+        job->outcome = succeeded ? JOB_SUCCEEDED : JOB_FAILED;
+    }
+
+    g_atomic_int_inc(&queue->ref_count);
+    g_idle_add(finish_job, job);
+}
@@ -0,0 +1,441 @@
+/*
+ * File: src/live_search.c
+ * Path: SchoolRecordSystem/src/live_search.c
+ * Description: Debounced, cancellable background name search for the search box
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "live_search.h"
+#include "name_index.h"
+#include "trigram_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Closest spellings shown when no name contains the query
+#define LIVE_SEARCH_CLOSEST_RESULTS 20
+
+// Stale-query checks while filtering cached results
+#define LIVE_SEARCH_CANCEL_STRIDE 4096
+
+// Roll numbers plus a copy of each normalized name
+typedef struct {
+    int *roll_numbers;
+    uint32_t *key_offsets;               // Start of each name in 'keys'
+    int count;
+    int capacity;
+    char *keys;
+    size_t keys_length;
+    size_t keys_capacity;
+    bool truncated;
+} ResultSet;
+
+// Last complete substring result set, owned by the worker thread
+typedef struct {
+    bool valid;
+    char key[NAME_INDEX_KEY_MAX];
+    int names_version;
+    ResultSet results;
+} ResultCache;
+
+struct LiveSearch {
+    StudentDatabase *db;
+    GMutex *index_lock;
+    LiveSearchPageFunc on_page;
+    void *user_data;
+    GThreadPool *pool;                   // Single worker, so queries run in order
+    guint debounce_source;
+    char pending_text[NAME_INDEX_KEY_MAX];
+    gint generation;                     // Bumped by every update; older work is stale
+    gint names_version;                  // Bumped whenever student names change
+    gint ref_count;                      // Owner plus undelivered result streams
+    gint closed;
+    ResultCache cache;
+};
+
+// A query handed to the worker
+typedef struct {
+    int generation;
+    char text[NAME_INDEX_KEY_MAX];
+    char key[NAME_INDEX_KEY_MAX];
+    size_t key_length;
+} QueryJob;
+
+// A finished result set being streamed into the main loop
+typedef struct {
+    LiveSearch *search;
+    int generation;
+    int *roll_numbers;
+    int count;
+    int position;
+    bool truncated;
+    LiveSearchKind kind;
+    char query[NAME_INDEX_KEY_MAX];
+} Delivery;
+
+static void run_query(gpointer data, gpointer user_data);
+
+/* ============================================================================
+ * RESULT SETS
+ * ============================================================================ */
+
+static void result_set_init(ResultSet *set) {
+    memset(set, 0, sizeof(*set));
+}
+
+static void result_set_free(ResultSet *set) {
+    g_free(set->roll_numbers);
+    g_free(set->key_offsets);
+    g_free(set->keys);
+    result_set_init(set);
+}
+
+static void result_set_append(ResultSet *set, int roll_number, const char *key) {
+    if (set->count == set->capacity) {
+        set->capacity = set->capacity > 0 ? set->capacity * 2 : 256;
+        set->roll_numbers = g_renew(int, set->roll_numbers, set->capacity);
+        set->key_offsets = g_renew(uint32_t, set->key_offsets, set->capacity);
+    }
+
+    size_t length = strlen(key) + 1;
+    if (set->keys_length + length > set->keys_capacity) {
+        size_t new_capacity = set->keys_capacity > 0 ? set->keys_capacity * 2 : 4096;
+        while (new_capacity < set->keys_length + length) {
+            new_capacity *= 2;
+        }
+        set->keys = g_renew(char, set->keys, new_capacity);
+        set->keys_capacity = new_capacity;
+    }
+
+    memcpy(set->keys + set->keys_length, key, length);
+    set->roll_numbers[set->count] = roll_number;
+    set->key_offsets[set->count] = (uint32_t)set->keys_length;
+    set->keys_length += length;
+    set->count++;
+}
+
+static const char* result_key(const ResultSet *set, int i) {
+    return set->keys + set->key_offsets[i];
+}
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+/**
+ * Create a live search over a database's name indexes
+ * @param db Database to search
+ * @param index_lock Lock guarding the name indexes against concurrent changes
+ * @param on_page Receives result pages on the main loop
+ * @param user_data Passed to on_page
+ * @return New live search
+ */
+LiveSearch* live_search_new(StudentDatabase *db, GMutex *index_lock,
+                            LiveSearchPageFunc on_page, void *user_data) {
+    LiveSearch *search = g_new0(LiveSearch, 1);
+    search->db = db;
+    search->index_lock = index_lock;
+    search->on_page = on_page;
+    search->user_data = user_data;
+    search->ref_count = 1;
+    result_set_init(&search->cache.results);
+
+    search->pool = g_thread_pool_new(run_query, search, 1, FALSE, NULL);
+    return search;
+}
+
+static void live_search_unref(LiveSearch *search) {
+    if (!g_atomic_int_dec_and_test(&search->ref_count)) return;
+
+    result_set_free(&search->cache.results);
+    g_free(search);
+}
+
+/**
+ * Stop all queries and release the live search. Result streams still
+ * queued on the main loop are discarded when they next run.
+ * @param search Live search to free
+ */
+void live_search_free(LiveSearch *search) {
+    if (!search) return;
+
+    g_atomic_int_set(&search->closed, 1);
+    live_search_cancel(search);
+
+    // Queued jobs are stale by now and return at once
+    g_thread_pool_free(search->pool, FALSE, TRUE);
+    live_search_unref(search);
+}
+
+static bool is_stale(LiveSearch *search, int generation) {
+    return g_atomic_int_get(&search->generation) != generation;
+}
+
+/* ============================================================================
+ * MAIN LOOP SIDE
+ * ============================================================================ */
+
+static gboolean start_query(gpointer data) {
+    LiveSearch *search = (LiveSearch*)data;
+    search->debounce_source = 0;
+
+    QueryJob *job = g_new0(QueryJob, 1);
+    job->generation = g_atomic_int_get(&search->generation);
+    g_strlcpy(job->text, search->pending_text, sizeof(job->text));
+    job->key_length = normalize_name_key(job->text, job->key, sizeof(job->key));
+
+    g_thread_pool_push(search->pool, job, NULL);
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * Schedule a query for new search text. Nothing runs until the text has
+ * been stable for LIVE_SEARCH_DEBOUNCE_MS; any older query stops at its
+ * next check and its results are never shown.
+ * @param search Live search
+ * @param text Current search text (empty = cancel only)
+ */
+void live_search_update(LiveSearch *search, const char *text) {
+    if (!search) return;
+
+    live_search_cancel(search);
+    if (!text || text[0] == '\0') return;
+
+    g_strlcpy(search->pending_text, text, sizeof(search->pending_text));
+    search->debounce_source = g_timeout_add(LIVE_SEARCH_DEBOUNCE_MS, start_query, search);
+}
+
+/**
+ * Drop any pending, running or streaming query
+ * @param search Live search
+ */
+void live_search_cancel(LiveSearch *search) {
+    if (!search) return;
+
+    g_atomic_int_inc(&search->generation);
+    if (search->debounce_source != 0) {
+        g_source_remove(search->debounce_source);
+        search->debounce_source = 0;
+    }
+}
+
+/**
+ * Forget cached results; call with the index lock held after names change
+ * @param search Live search
+ */
+void live_search_invalidate(LiveSearch *search) {
+    if (!search) return;
+    g_atomic_int_inc(&search->names_version);
+}
+
+static void delivery_free(Delivery *delivery) {
+    live_search_unref(delivery->search);
+    g_free(delivery->roll_numbers);
+    g_free(delivery);
+}
+
+// Hand one page to the view; runs at idle priority so input always comes first
+static gboolean deliver_page(gpointer data) {
+    Delivery *delivery = (Delivery*)data;
+    LiveSearch *search = delivery->search;
+
+    if (g_atomic_int_get(&search->closed) || is_stale(search, delivery->generation)) {
+        delivery_free(delivery);
+        return G_SOURCE_REMOVE;
+    }
+
+    int remaining = delivery->count - delivery->position;
+    int count = remaining < LIVE_SEARCH_PAGE_SIZE ? remaining : LIVE_SEARCH_PAGE_SIZE;
+
+    LiveSearchPage page = {
+        .roll_numbers = delivery->roll_numbers + delivery->position,
+        .count = count,
+        .first_page = delivery->position == 0,
+        .last_page = delivery->position + count >= delivery->count,
+        .total = delivery->count,
+        .truncated = delivery->truncated,
+        .kind = delivery->kind,
+        .query = delivery->query
+    };
+    search->on_page(&page, search->user_data);
+
+    delivery->position += count;
+    if (page.last_page) {
+        delivery_free(delivery);
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+/* ============================================================================
+ * WORKER SIDE
+ * ============================================================================ */
+
+typedef struct {
+    LiveSearch *search;
+    int generation;
+    const NameIndex *index;
+    ResultSet *results;
+} CollectContext;
+
+static bool collect_match(int roll_number, void *context) {
+    CollectContext *collect = (CollectContext*)context;
+
+    if (is_stale(collect->search, collect->generation)) return false;
+    if (collect->results->count == LIVE_SEARCH_MAX_RESULTS) {
+        collect->results->truncated = true;
+        return false;
+    }
+
+    const char *key = name_index_key(collect->index, roll_number);
+    result_set_append(collect->results, roll_number, key ? key : "");
+    return true;
+}
+
+// A filtered match: cached position plus where the query occurs in its name
+typedef struct {
+    int position;
+    const char *match;
+} RefinedMatch;
+
+// Names sorted from the match onward, as the suffix array orders them
+static int compare_refined(const void *a, const void *b) {
+    const RefinedMatch *x = (const RefinedMatch*)a;
+    const RefinedMatch *y = (const RefinedMatch*)b;
+    int order = strcmp(x->match, y->match);
+    if (order != 0) return order;
+    return (x->position > y->position) - (x->position < y->position);
+}
+
+/**
+ * Answer a refined query from the previous result set: every name that
+ * contains the new text also contains the old text it extends, so the
+ * old matches are filtered instead of searching the index again
+ * @param search Live search (cache is worker-owned)
+ * @param job Query to answer
+ * @param results Receives the matches, prefix matches first
+ * @return false if the cache cannot answer this query or leaves no match
+ *         (the index then looks for the closest spellings)
+ */
+static bool refine_cached(LiveSearch *search, const QueryJob *job, ResultSet *results) {
+    const ResultCache *cache = &search->cache;
+    if (!cache->valid || cache->names_version != g_atomic_int_get(&search->names_version) ||
+        strstr(job->key, cache->key) == NULL) {
+        return false;
+    }
+
+    const ResultSet *previous = &cache->results;
+    size_t slots = previous->count > 0 ? (size_t)previous->count : 1;
+    RefinedMatch *prefixed = g_new(RefinedMatch, slots);
+    RefinedMatch *contained = g_new(RefinedMatch, slots);
+    int prefixed_count = 0, contained_count = 0;
+
+    for (int i = 0; i < previous->count; i++) {
+        if (i % LIVE_SEARCH_CANCEL_STRIDE == 0 && is_stale(search, job->generation)) break;
+
+        const char *key = result_key(previous, i);
+        const char *hit = strstr(key, job->key);
+        if (hit == key) {
+            prefixed[prefixed_count++] = (RefinedMatch){i, key};
+        } else if (hit) {
+            contained[contained_count++] = (RefinedMatch){i, hit};
+        }
+    }
+
+    // Same order the index reports: prefix matches by name, then the rest
+    // by the text from their first match onward
+    qsort(prefixed, (size_t)prefixed_count, sizeof(RefinedMatch), compare_refined);
+    qsort(contained, (size_t)contained_count, sizeof(RefinedMatch), compare_refined);
+
+    for (int i = 0; i < prefixed_count; i++) {
+        int position = prefixed[i].position;
+        result_set_append(results, previous->roll_numbers[position], result_key(previous, position));
+    }
+    for (int i = 0; i < contained_count; i++) {
+        int position = contained[i].position;
+        result_set_append(results, previous->roll_numbers[position], result_key(previous, position));
+    }
+
+    g_free(prefixed);
+    g_free(contained);
+    return prefixed_count + contained_count > 0;
+}
+
+/**
+ * Run one query on the worker thread and stream its results
+ * @param data QueryJob (freed here)
+ * @param user_data Live search
+ */
+static void run_query(gpointer data, gpointer user_data) {
+    LiveSearch *search = (LiveSearch*)user_data;
+    QueryJob *job = (QueryJob*)data;
+
+    if (is_stale(search, job->generation) || job->key_length == 0) {
+        g_free(job);
+        return;
+    }
+
+    ResultSet results;
+    result_set_init(&results);
+    LiveSearchKind kind = LIVE_SEARCH_MATCHES;
+    int names_version;
+
+    if (refine_cached(search, job, &results)) {
+        names_version = search->cache.names_version;
+    } else {
+        g_mutex_lock(search->index_lock);
+        names_version = g_atomic_int_get(&search->names_version);
+        pthread_mutex_lock(&search->db->search_lock);
+
+        CollectContext collect = {search, job->generation, &search->db->name_index, &results};
+        name_index_search(&search->db->name_index, job->key, NAME_SEARCH_SUBSTRING,
+                          LIVE_SEARCH_MAX_RESULTS + 1, collect_match, &collect);
+
+        // Nothing contains the text - offer the closest spellings instead
+        if (results.count == 0 && !is_stale(search, job->generation)) {
+            TrigramMatch closest[LIVE_SEARCH_CLOSEST_RESULTS];
+            int found = trigram_index_search(&search->db->trigram_index, job->text, -1,
+                                             closest, LIVE_SEARCH_CLOSEST_RESULTS);
+            for (int i = 0; i < found; i++) {
+                result_set_append(&results, closest[i].roll_number, "");
+            }
+            kind = LIVE_SEARCH_CLOSEST;
+        }
+        pthread_mutex_unlock(&search->db->search_lock);
+        g_mutex_unlock(search->index_lock);
+    }
+
+    if (is_stale(search, job->generation)) {
+        result_set_free(&results);
+        g_free(job);
+        return;
+    }
+
+    Delivery *delivery = g_new0(Delivery, 1);
+    delivery->search = search;
+    delivery->generation = job->generation;
+    delivery->count = results.count;
+    delivery->roll_numbers = g_new(int, results.count > 0 ? results.count : 1);
+    if (results.count > 0) {
+        memcpy(delivery->roll_numbers, results.roll_numbers, (size_t)results.count * sizeof(int));
+    }
+    delivery->truncated = results.truncated;
+    delivery->kind = kind;
+    g_strlcpy(delivery->query, job->text, sizeof(delivery->query));
+
+    // Keep complete substring results so the next, longer query can refine them
+    if (kind == LIVE_SEARCH_MATCHES && !results.truncated) {
+        result_set_free(&search->cache.results);
+        search->cache.results = results;
+        search->cache.valid = true;
+        search->cache.names_version = names_version;
+        g_strlcpy(search->cache.key, job->key, sizeof(search->cache.key));
+    } else {
+        result_set_free(&results);
+    }
+
+    g_atomic_int_inc(&search->ref_count);
+    g_idle_add(deliver_page, delivery);
+    g_free(job);
+}
@@ -0,0 +1,378 @@
+/*
+ * File: src/logger.c
+ * Path: SchoolRecordSystem/src/logger.c
+ * Description: Leveled diagnostics through a lock-free ring buffer and a flushing thread
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "logger.h"
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+// Bounded multi-producer queue: a slot is free for position p when its
+// sequence equals p, and holds a message for p when it equals p + 1
+typedef struct {
+    atomic_size_t sequence;
+    LogLevel level;
+    long long time_ms;
+    char text[LOG_MESSAGE_LENGTH];
+} LogSlot;
+
+atomic_int log_runtime_level = LOG_DEFAULT_LEVEL;
+
+static LogSlot ring[LOG_RING_SLOTS];
+static atomic_size_t enqueue_pos;
+static size_t dequeue_pos;                   // Flusher thread only
+
+static atomic_bool running;                  // Flusher owns the output
+static atomic_bool stopping;
+static atomic_int active_writers;            // Between checking 'running' and publishing
+static atomic_long dropped;                  // Since the last notice
+static atomic_long dropped_total;
+static _Atomic(FILE*) output;
+
+static pthread_t flusher;
+static pthread_mutex_t wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+static atomic_bool exit_handler_registered;
+
+static const char *level_names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+
+/* ============================================================================
+ * FORMATTING AND OUTPUT
+ * ============================================================================ */
+
+static long long now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static FILE* output_stream(void) {
+    FILE *stream = atomic_load(&output);
+    return stream ? stream : stderr;
+}
+
+// One fputs per line keeps lines whole between threads
+static void emit_line(FILE *stream, LogLevel level, long long time_ms, const char *text) {
+    char line[LOG_MESSAGE_LENGTH + 32];
+    time_t seconds = (time_t)(time_ms / 1000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+
+    snprintf(line, sizeof(line), "%02d:%02d:%02d.%03d %-5s %s\n",
+             local.tm_hour, local.tm_min, local.tm_sec, (int)(time_ms % 1000),
+             level_names[level], text);
+    fputs(line, stream);
+}
+
+// Drop trailing newlines carried over from printf-style messages
+static void trim_newlines(char *text) {
+    size_t length = strlen(text);
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) {
+        text[--length] = '\0';
+    }
+}
+
+/* ============================================================================
+ * RING BUFFER
+ * ============================================================================ */
+
+/**
+ * Claim the next free slot without locking
+ * @return Slot to fill, or NULL when the ring is full
+ */
+static LogSlot* claim_slot(size_t *position) {
+    size_t pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        LogSlot *slot = &ring[pos & (LOG_RING_SLOTS - 1)];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)pos;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *position = pos;
+                return slot;
+            }
+        } else if (difference < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static void publish_slot(LogSlot *slot, size_t position) {
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+}
+
+/**
+ * Write every published message (flusher thread, or after it stopped)
+ * @return Number of messages written
+ */
+static int drain_ring(FILE *stream) {
+    int written = 0;
+
+    for (;;) {
+        LogSlot *slot = &ring[dequeue_pos & (LOG_RING_SLOTS - 1)];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence != dequeue_pos + 1) break;
+
+        emit_line(stream, slot->level, slot->time_ms, slot->text);
+        atomic_store_explicit(&slot->sequence, dequeue_pos + LOG_RING_SLOTS, memory_order_release);
+        dequeue_pos++;
+        written++;
+    }
+
+    long lost = atomic_exchange(&dropped, 0);
+    if (lost > 0) {
+        char text[64];
+        snprintf(text, sizeof(text), "%ld log messages dropped (ring buffer full)", lost);
+        emit_line(stream, LOG_LEVEL_WARN, now_ms(), text);
+        written++;
+    }
+
+    if (written > 0) {
+        fflush(stream);
+    }
+    return written;
+}
+
+static void wake_flusher(void) {
+    pthread_cond_signal(&wake_cond);
+}
+
+static void* flusher_main(void *unused) {
+    (void)unused;
+
+    // Leave signals to the threads that handle them (e.g. the server's signalfd)
+    sigset_t all_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_BLOCK, &all_signals, NULL);
+
+    pthread_mutex_lock(&wake_lock);
+    while (!atomic_load(&stopping)) {
+        pthread_mutex_unlock(&wake_lock);
+        drain_ring(output_stream());
+        pthread_mutex_lock(&wake_lock);
+
+        if (atomic_load(&stopping)) break;
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += LOG_FLUSH_INTERVAL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&wake_cond, &wake_lock, &deadline);
+    }
+    pthread_mutex_unlock(&wake_lock);
+
+    drain_ring(output_stream());
+    return NULL;
+}
+
+/* ============================================================================
+ * RATE LIMITING
+ * ============================================================================ */
+
+/**
+ * Allow at most LOG_SITE_BURST messages per call site per second
+ * @param site Call site state
+ * @param suppressed Receives the count dropped in earlier seconds
+ * @return true if the message should be written
+ */
+static bool site_allows(LogSite *site, long long time_ms, int *suppressed) {
+    long long start = atomic_load_explicit(&site->window_start, memory_order_relaxed);
+    *suppressed = 0;
+
+    if (time_ms - start >= 1000 &&
+        atomic_compare_exchange_strong(&site->window_start, &start, time_ms)) {
+        atomic_store(&site->count, 0);
+        *suppressed = atomic_exchange(&site->suppressed, 0);
+    }
+
+    if (atomic_fetch_add_explicit(&site->count, 1, memory_order_relaxed) >= LOG_SITE_BURST) {
+        atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * PUBLIC INTERFACE
+ * ============================================================================ */
+
+/**
+ * Format and queue one message. Never blocks: when the ring is full the
+ * message is counted as dropped, except errors, which are written at once.
+ * @param level Severity (already checked against both levels)
+ * @param site Rate limit state of the call site (may be NULL)
+ * @param format printf-style format
+ */
+void log_write(LogLevel level, LogSite *site, const char *format, ...) {
+    long long time_ms = now_ms();
+    int suppressed = 0;
+
+    if (site && !site_allows(site, time_ms, &suppressed)) {
+        return;
+    }
+
+    va_list args;
+    char local_text[LOG_MESSAGE_LENGTH];
+    size_t position = 0;
+
+    // Counted before 'running' is read, so log_shutdown() either sees this
+    // writer and waits for its slot, or the writer sees the shutdown
+    atomic_fetch_add(&active_writers, 1);
+    LogSlot *slot = atomic_load(&running) ? claim_slot(&position) : NULL;
+    if (!slot) {
+        atomic_fetch_sub(&active_writers, 1);
+    }
+    char *text = slot ? slot->text : local_text;
+
+    va_start(args, format);
+    vsnprintf(text, LOG_MESSAGE_LENGTH, format, args);
+    va_end(args);
+    trim_newlines(text);
+
+    if (suppressed > 0) {
+        size_t length = strlen(text);
+        snprintf(text + length, LOG_MESSAGE_LENGTH - length,
+                 " (%d similar message%s suppressed)", suppressed, suppressed == 1 ? "" : "s");
+    }
+
+    if (slot) {
+        slot->level = level;
+        slot->time_ms = time_ms;
+        publish_slot(slot, position);
+        atomic_fetch_sub(&active_writers, 1);
+        // Warnings go out promptly; bursts wake the flusher every half ring
+        if (level >= LOG_LEVEL_WARN || position % (LOG_RING_SLOTS / 2) == 0) {
+            wake_flusher();
+        }
+        return;
+    }
+
+    if (atomic_load(&running) && level < LOG_LEVEL_ERROR) {
+        atomic_fetch_add(&dropped, 1);
+        atomic_fetch_add(&dropped_total, 1);
+        return;
+    }
+
+    FILE *stream = output_stream();
+    emit_line(stream, level, time_ms, text);
+    fflush(stream);
+}
+
+/**
+ * Start asynchronous logging. Also registers log_shutdown() with atexit()
+ * so queued messages are written when the program exits.
+ * @return true if the flushing thread is running
+ */
+bool log_init(void) {
+    if (atomic_load(&running)) return true;
+
+    const char *env_level = getenv(LOG_LEVEL_ENV);
+    LogLevel level;
+    if (env_level && log_level_from_string(env_level, &level)) {
+        log_set_level(level);
+    }
+
+    for (size_t i = 0; i < LOG_RING_SLOTS; i++) {
+        atomic_store_explicit(&ring[i].sequence, i, memory_order_relaxed);
+    }
+    atomic_store(&enqueue_pos, 0);
+    dequeue_pos = 0;
+    atomic_store(&stopping, false);
+
+    if (pthread_create(&flusher, NULL, flusher_main, NULL) != 0) {
+        return false;
+    }
+    atomic_store(&running, true);
+
+    if (!atomic_exchange(&exit_handler_registered, true)) {
+        atexit(log_shutdown);
+    }
+    return true;
+}
+
+/**
+ * Flush queued messages and stop the flushing thread. Later messages are
+ * written synchronously. Safe to call more than once.
+ */
+void log_shutdown(void) {
+    if (!atomic_exchange(&running, false)) return;
+
+    // A writer that claimed a slot before 'running' was cleared publishes
+    // it before the flusher's final drain
+    while (atomic_load(&active_writers) > 0) {
+        sched_yield();
+    }
+
+    pthread_mutex_lock(&wake_lock);
+    atomic_store(&stopping, true);
+    pthread_cond_signal(&wake_cond);
+    pthread_mutex_unlock(&wake_lock);
+
+    pthread_join(flusher, NULL);
+}
+
+void log_set_level(LogLevel level) {
+    if (level < LOG_LEVEL_TRACE || level > LOG_LEVEL_OFF) return;
+    atomic_store(&log_runtime_level, (int)level);
+}
+
+LogLevel log_get_level(void) {
+    return (LogLevel)atomic_load(&log_runtime_level);
+}
+
+/**
+ * Parse a level name ("debug", "WARN", ...) or number (0-5)
+ * @param text Level text
+ * @param level Receives the level
+ * @return true if the text named a level
+ */
+bool log_level_from_string(const char *text, LogLevel *level) {
+    if (!text || !level) return false;
+
+    for (int i = LOG_LEVEL_TRACE; i <= LOG_LEVEL_OFF; i++) {
+        if (strcasecmp(text, level_names[i]) == 0) {
+            *level = (LogLevel)i;
+            return true;
+        }
+    }
+    if (strcasecmp(text, "warning") == 0) {
+        *level = LOG_LEVEL_WARN;
+        return true;
+    }
+    if (text[0] >= '0' && text[0] <= '5' && text[1] == '\0') {
+        *level = (LogLevel)(text[0] - '0');
+        return true;
+    }
+    return false;
+}
+
+const char* log_level_name(LogLevel level) {
+    if (level < LOG_LEVEL_TRACE || level > LOG_LEVEL_OFF) return "UNKNOWN";
+    return level_names[level];
+}
+
+void log_set_output(FILE *stream) {
+    atomic_store(&output, stream);
+}
+
+long log_dropped_count(void) {
+    return atomic_load(&dropped_total);
+}
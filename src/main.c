@@ -1,37 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <signal.h>
+#include "batch.h"
+#include "console.h"
 #include "gui.h"
 #include "student.h"
 #include "file_operations.h"
 #include "calculations.h"
 #include "memory_manager.h"
-
-// Global variables for cleanup
-static StudentDatabase *g_database = NULL;
-
-// Signal handler for graceful shutdown
-void signal_handler(int signal) {
-    printf("\nReceived signal %d. Saving data and exiting...\n", signal);
-
-    if (g_database) {
-        save_to_file(g_database, get_default_filename());
-        destroy_database(g_database);
-    }
-
-    exit(0);
-}
-
-// Setup signal handlers
-void setup_signal_handlers(void) {
-    signal(SIGINT, signal_handler);   // Ctrl+C
-    signal(SIGTERM, signal_handler);  // Termination signal
-
-#ifdef SIGQUIT
-    signal(SIGQUIT, signal_handler);  // Quit signal (Unix)
-#endif
-}
+#include "logger.h"
+#include "server.h"
+#include "startup_options.h"
 
 // Print program banner
 void print_banner(void) {
@@ -52,7 +31,13 @@ void print_help(const char *program_name) {
     printf("  -h, --help     Display this help message\n");
     printf("  -v, --version  Display version information\n");
     printf("  --console      Run in console mode (text-based interface)\n");
+    printf("  --exec SCRIPT  Run commands from SCRIPT ('-' for stdin), one JSON result\n");
+    printf("                 line per command on stdout; nonzero exit if any failed\n");
+    printf("  --serve        Keep the data file loaded and answer the same commands\n");
+    printf("                 on a Unix socket until SIGINT/SIGTERM (see srs_client)\n");
+    printf("  --socket PATH  Socket for --serve (default: %s)\n", SERVER_DEFAULT_SOCKET);
     printf("  --data FILE    Specify custom data file (default: data/students.txt)\n");
+    print_startup_options_help();
     printf("\nFeatures:\n");
     printf("  • Add, modify, and delete student records\n");
     printf("  • Search students by roll number\n");
@@ -64,6 +49,7 @@ void print_help(const char *program_name) {
     printf("  %s                    # Start GUI application\n", program_name);
     printf("  %s --console          # Run in console mode\n", program_name);
     printf("  %s --data mydata.txt  # Use custom data file\n", program_name);
+    printf("  %s --exec jobs.txt    # Run a batch script\n", program_name);
     printf("\n");
 }
 
@@ -74,158 +60,6 @@ void print_version(void) {
     printf("Copyright (c) 2025 - Educational Project\n");
 }
 
-// Console mode for testing without GUI
-void console_mode(const char *data_file) {
-    printf("Starting in console mode...\n");
-    printf("Data file: %s\n\n", data_file);
-
-    StudentDatabase *db = create_database();
-    if (!db) {
-        fprintf(stderr, "Failed to create database\n");
-        return;
-    }
-
-    g_database = db;
-
-    // Load existing data
-    if (load_from_file(db, data_file)) {
-        printf("Loaded existing data from %s\n", data_file);
-    } else {
-        printf("Starting with empty database\n");
-    }
-
-    char input[256];
-    int choice;
-
-    while (1) {
-        printf("\n=== Student Record Management System ===\n");
-        printf("1. Display all students\n");
-        printf("2. Add student\n");
-        printf("3. Search student\n");
-        printf("4. Calculate statistics\n");
-        printf("5. Sort students by marks\n");
-        printf("6. Save to file\n");
-        printf("7. Exit\n");
-        printf("Enter your choice (1-7): ");
-
-        if (fgets(input, sizeof(input), stdin) == NULL) {
-            break;
-        }
-
-        choice = atoi(input);
-
-        switch (choice) {
-            case 1:
-                display_all_students(db);
-                break;
-
-            case 2: {
-                char name[MAX_NAME_LENGTH];
-                int roll;
-                float marks;
-
-                printf("Enter student name: ");
-                fgets(name, sizeof(name), stdin);
-                name[strcspn(name, "\n")] = '\0';
-
-                printf("Enter roll number: ");
-                fgets(input, sizeof(input), stdin);
-                roll = atoi(input);
-
-                printf("Enter marks: ");
-                fgets(input, sizeof(input), stdin);
-                marks = atof(input);
-
-                if (add_student(db, name, roll, marks)) {
-                    printf("Student added successfully!\n");
-                } else {
-                    printf("Failed to add student. Roll number may already exist.\n");
-                }
-                break;
-            }
-
-           // Continuation of main.c - Console mode and main function
-
-            case 3: {
-                printf("Enter roll number to search: ");
-                fgets(input, sizeof(input), stdin);
-                int roll = atoi(input);
-
-                Student *student = find_student(db, roll);
-                if (student) {
-                    printf("\nStudent Found:\n");
-                    printf("Name: %s\n", student->name);
-                    printf("Roll Number: %d\n", student->roll_number);
-                    printf("Marks: %.2f\n", student->marks);
-                    printf("Status: %s\n", student->status);
-                } else {
-                    printf("Student with roll number %d not found.\n", roll);
-                }
-                break;
-            }
-
-            case 4: {
-                Statistics stats = calculate_statistics(db);
-                printf("\n=== Statistics ===\n");
-                printf("Total Students: %d\n", stats.total_students);
-                printf("Average Marks: %.2f\n", stats.average_marks);
-                printf("Highest Marks: %.2f\n", stats.highest_marks);
-                printf("Lowest Marks: %.2f\n", stats.lowest_marks);
-                printf("Passed Students: %d\n", stats.passed_students);
-                printf("Failed Students: %d\n", stats.failed_students);
-                printf("Pass Percentage: %.1f%%\n", stats.pass_percentage);
-
-                Student *top_student = find_highest_scorer(db);
-                if (top_student) {
-                    printf("Top Scorer: %s (Roll: %d, Marks: %.2f)\n",
-                           top_student->name, top_student->roll_number, top_student->marks);
-                }
-                break;
-            }
-
-            case 5: {
-                printf("Sort by: 1) Marks Ascending 2) Marks Descending\n");
-                printf("Enter choice (1-2): ");
-                fgets(input, sizeof(input), stdin);
-                int sort_choice = atoi(input);
-
-                if (sort_choice == 1) {
-                    sort_students(db, SORT_BY_MARKS_ASC);
-                    printf("Students sorted by marks (ascending)\n");
-                } else if (sort_choice == 2) {
-                    sort_students(db, SORT_BY_MARKS_DESC);
-                    printf("Students sorted by marks (descending)\n");
-                } else {
-                    printf("Invalid choice\n");
-                }
-                break;
-            }
-
-            case 6:
-                if (save_to_file(db, data_file)) {
-                    printf("Data saved successfully to %s\n", data_file);
-                } else {
-                    printf("Failed to save data\n");
-                }
-                break;
-
-            case 7:
-                printf("Saving data and exiting...\n");
-                save_to_file(db, data_file);
-                destroy_database(db);
-                g_database = NULL;
-                return;
-
-            default:
-                printf("Invalid choice. Please enter 1-7.\n");
-                break;
-        }
-    }
-
-    destroy_database(db);
-    g_database = NULL;
-}
-
 // Check system requirements
 bool check_system_requirements(void) {
     printf("Checking system requirements...\n");
@@ -272,9 +106,10 @@ int main(int argc, char *argv[]) {
     bool show_help = false;
     bool show_version = false;
     char *data_file = NULL;
-
-    // Print banner
-    print_banner();
+    StartupOptions startup_options = {NULL, NULL};
+    const char *batch_script = NULL;
+    const char *socket_path = SERVER_DEFAULT_SOCKET;
+    bool serve_mode = false;
 
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -284,15 +119,26 @@ int main(int argc, char *argv[]) {
             show_version = true;
         } else if (strcmp(argv[i], "--console") == 0) {
             console_mode_flag = true;
+        } else if (strcmp(argv[i], "--exec") == 0 && i + 1 < argc) {
+            batch_script = argv[++i];
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            serve_mode = true;
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
         } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
             data_file = argv[++i];
-        } else {
+        } else if (!parse_startup_option(&startup_options, argc, argv, &i)) {
             printf("Unknown option: %s\n", argv[i]);
             printf("Use --help for usage information.\n");
             return 1;
         }
     }
 
+    // Batch output must stay machine-readable, and a daemon has no audience
+    if (!batch_script && !serve_mode) {
+        print_banner();
+    }
+
     // Handle help and version flags
     if (show_help) {
         print_help(argv[0]);
@@ -304,6 +150,25 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // Diagnostics go through the asynchronous logger from here on
+    if (!apply_startup_options(&startup_options)) {
+        return 1;
+    }
+
+    if (batch_script) {
+        create_data_directory();
+        int status = run_batch_file(batch_script);
+        log_shutdown();
+        return status;
+    }
+
+    if (serve_mode) {
+        create_data_directory();
+        int status = run_server(socket_path, data_file ? data_file : get_default_filename());
+        log_shutdown();
+        return status;
+    }
+
     // Set default data file if not specified
     if (!data_file) {
         data_file = get_default_filename();
@@ -327,23 +192,6 @@ int main(int argc, char *argv[]) {
     }
 
     printf("Thank you for using Student Record Management System!\n");
+    log_shutdown();
     return 0;
 }
-
-// Additional utility functions for main
-
-// Cleanup function called at exit
-void cleanup_at_exit(void) {
-    if (g_database) {
-        printf("Performing cleanup...\n");
-        save_to_file(g_database, get_default_filename());
-        destroy_database(g_database);
-        g_database = NULL;
-    }
-}
-
-// Register cleanup function
-__attribute__((constructor))
-void register_cleanup(void) {
-    atexit(cleanup_at_exit);
-}
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include "memory_manager.h"
+#include "logger.h"
 #include <stdio.h>
 
 // Safe malloc with error checking
 void* safe_malloc(size_t size) {
     void *ptr = malloc(size);
     if (!ptr && size > 0) {
-        fprintf(stderr, "Memory allocation failed for size %zu\n", size);
+        LOG_ERROR("Memory allocation failed for size %zu", size);
         exit(EXIT_FAILURE);
     }
     return ptr;
@@ -15,7 +16,7 @@ void* safe_malloc(size_t size) {
 void* safe_realloc(void *ptr, size_t size) {
     void *new_ptr = realloc(ptr, size);
     if (!new_ptr && size > 0) {
-        fprintf(stderr, "Memory reallocation failed for size %zu\n", size);
+        LOG_ERROR("Memory reallocation failed for size %zu", size);
         free(ptr); // Free the original pointer
         exit(EXIT_FAILURE);
     }
@@ -43,6 +44,15 @@ bool resize_database(StudentDatabase *db, int new_capacity) {
     }
     
     db->students = new_students;
+
+    // The marks column always mirrors the students array capacity
+    float *new_column = (float*)safe_realloc(db->marks_column,
+                                             new_capacity * sizeof(float));
+    if (!new_column) {
+        return false;
+    }
+
+    db->marks_column = new_column;
     db->capacity = new_capacity;
     return true;
 }
@@ -66,6 +76,17 @@ void cleanup_resources(StudentDatabase *db) {
             free(db->students);
             db->students = NULL;
         }
+        if (db->marks_column) {
+            free(db->marks_column);
+            db->marks_column = NULL;
+        }
+        rank_tree_free(&db->marks_tree);
+        rank_tree_free(&db->gpa_tree);
+        roll_index_free(&db->roll_index);
+        bitmap_index_free(&db->bitmap_index);
+        name_index_free(&db->name_index);
+        trigram_index_free(&db->trigram_index);
+        memset(&db->aggregates, 0, sizeof(db->aggregates));
         db->count = 0;
         db->capacity = 0;
     }
@@ -0,0 +1,579 @@
+/*
+ * File: src/name_index.c
+ * Path: SchoolRecordSystem/src/name_index.c
+ * Description: Prefix and substring search over normalized student names
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Names are case-folded and whitespace-collapsed into one text arena
+ * - A sorted suffix array answers substring queries with two binary
+ *   searches; a sorted list of name starts answers prefix queries
+ * - Changes go to an unsorted tail that searches scan linearly; the
+ *   arrays are rebuilt lazily once the tail (or dead space) grows too big
+ */
+
+#include "name_index.h"
+#include "memory_manager.h"
+#include <ctype.h>
+
+#define NAME_INDEX_TAIL_MIN 1024         // Tail entries tolerated before re-sorting
+#define NAME_INDEX_INSERTION_SORT 16     // Partition size handled by insertion sort
+
+/* ============================================================================
+ * NORMALIZATION
+ * ============================================================================ */
+
+/**
+ * Build the search key for a name: ASCII case-folded, leading/trailing
+ * whitespace dropped and inner runs collapsed to a single space
+ * @param name Name to normalize
+ * @param out Output buffer
+ * @param out_size Size of the output buffer
+ * @return Length of the normalized key
+ */
+size_t normalize_name_key(const char *name, char *out, size_t out_size) {
+    if (!out || out_size == 0) return 0;
+
+    size_t length = 0;
+    bool pending_space = false;
+
+    for (const unsigned char *p = (const unsigned char*)(name ? name : ""); *p; p++) {
+        if (isspace(*p)) {
+            pending_space = true;
+            continue;
+        }
+        if (pending_space && length > 0 && length + 1 < out_size) {
+            out[length++] = ' ';
+        }
+        pending_space = false;
+        if (length + 1 >= out_size) break;
+        out[length++] = (char)tolower(*p);
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+/* ============================================================================
+ * LIFECYCLE AND MAINTENANCE
+ * ============================================================================ */
+
+/**
+ * Initialize an empty index
+ * @param index Index to initialize
+ */
+void name_index_init(NameIndex *index) {
+    if (!index) return;
+
+    memset(index, 0, sizeof(*index));
+    roll_index_init(&index->entry_of_roll);
+}
+
+/**
+ * Release all memory held by the index
+ * @param index Index to free
+ */
+void name_index_free(NameIndex *index) {
+    if (!index) return;
+
+    free(index->text);
+    free(index->entries);
+    free(index->suffixes);
+    free(index->name_order);
+    roll_index_free(&index->entry_of_roll);
+    name_index_init(index);
+}
+
+/**
+ * Remove every name, keeping allocated buffers for reuse
+ * @param index Index to clear
+ */
+void name_index_clear(NameIndex *index) {
+    if (!index) return;
+
+    index->text_length = 0;
+    index->entry_count = 0;
+    index->live_count = 0;
+    index->suffix_count = 0;
+    index->name_order_count = 0;
+    index->indexed_count = 0;
+    roll_index_clear(&index->entry_of_roll);
+}
+
+/**
+ * Index a student's name, replacing any name already stored for the roll number
+ * @param index Index to update
+ * @param roll_number Student's roll number
+ * @param name Student's display name
+ * @return true on success
+ */
+bool name_index_add(NameIndex *index, int roll_number, const char *name) {
+    if (!index || !name || roll_number <= 0) return false;
+
+    name_index_remove(index, roll_number);
+
+    char key[NAME_INDEX_KEY_MAX];
+    size_t length = normalize_name_key(name, key, sizeof(key));
+
+    if (index->text_length + length + 1 > index->text_capacity) {
+        size_t new_capacity = index->text_capacity > 0 ? index->text_capacity * 2 : 4096;
+        while (new_capacity < index->text_length + length + 1) {
+            new_capacity *= 2;
+        }
+        index->text = (char*)safe_realloc(index->text, new_capacity);
+        index->text_capacity = new_capacity;
+    }
+
+    if (index->entry_count >= index->entry_capacity) {
+        int new_capacity = index->entry_capacity > 0 ? index->entry_capacity * 2 : 64;
+        index->entries = (NameEntry*)safe_realloc(index->entries,
+                                                  (size_t)new_capacity * sizeof(NameEntry));
+        index->entry_capacity = new_capacity;
+    }
+
+    NameEntry *entry = &index->entries[index->entry_count];
+    entry->roll_number = roll_number;
+    entry->offset = (uint32_t)index->text_length;
+    entry->length = (uint16_t)length;
+    entry->live = true;
+
+    memcpy(index->text + index->text_length, key, length + 1);
+    index->text_length += length + 1;
+
+    roll_index_put(&index->entry_of_roll, roll_number, index->entry_count);
+    index->entry_count++;
+    index->live_count++;
+    return true;
+}
+
+/**
+ * Drop the name stored for a roll number (no-op if there is none)
+ * @param index Index to update
+ * @param roll_number Student's roll number
+ */
+void name_index_remove(NameIndex *index, int roll_number) {
+    if (!index) return;
+
+    int entry = roll_index_get(&index->entry_of_roll, roll_number);
+    if (entry < 0) return;
+
+    index->entries[entry].live = false;
+    index->live_count--;
+    roll_index_remove(&index->entry_of_roll, roll_number);
+}
+
+/**
+ * Normalized name currently stored for a roll number
+ * @param index Index to read
+ * @param roll_number Student's roll number
+ * @return Key text owned by the index (valid until the next change), or NULL
+ */
+const char* name_index_key(const NameIndex *index, int roll_number) {
+    if (!index) return NULL;
+
+    int entry = roll_index_get(&index->entry_of_roll, roll_number);
+    if (entry < 0) return NULL;
+
+    return index->text + index->entries[entry].offset;
+}
+
+/* ============================================================================
+ * SUFFIX SORTING
+ * ============================================================================ */
+
+static void swap_offsets(uint32_t *a, uint32_t *b) {
+    uint32_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+/**
+ * Sort '\0'-terminated strings of a shared text by content (multikey
+ * quicksort). All strings share their first 'depth' bytes on entry.
+ * @param text Text the offsets point into
+ * @param offsets Offsets to sort
+ * @param n Number of offsets
+ * @param depth Length of the common prefix
+ */
+static void sort_text_offsets(const char *text, uint32_t *offsets, size_t n, size_t depth) {
+    while (n > NAME_INDEX_INSERTION_SORT) {
+        unsigned char a = (unsigned char)text[offsets[0] + depth];
+        unsigned char b = (unsigned char)text[offsets[n / 2] + depth];
+        unsigned char c = (unsigned char)text[offsets[n - 1] + depth];
+        unsigned char pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a))
+                                      : ((a < c) ? a : (b < c ? c : b));
+
+        // Three-way partition on the byte at 'depth'
+        size_t lt = 0, i = 0, gt = n;
+        while (i < gt) {
+            unsigned char ch = (unsigned char)text[offsets[i] + depth];
+            if (ch < pivot) {
+                swap_offsets(&offsets[lt++], &offsets[i++]);
+            } else if (ch > pivot) {
+                swap_offsets(&offsets[i], &offsets[--gt]);
+            } else {
+                i++;
+            }
+        }
+
+        sort_text_offsets(text, offsets, lt, depth);
+        sort_text_offsets(text, offsets + gt, n - gt, depth);
+
+        // Equal strings that already ended are fully sorted
+        if (pivot == '\0') return;
+
+        offsets += lt;
+        n = gt - lt;
+        depth++;
+    }
+
+    for (size_t i = 1; i < n; i++) {
+        uint32_t value = offsets[i];
+        size_t j = i;
+        while (j > 0 && strcmp(text + offsets[j - 1] + depth, text + value + depth) > 0) {
+            offsets[j] = offsets[j - 1];
+            j--;
+        }
+        offsets[j] = value;
+    }
+}
+
+/**
+ * Sort a large set of offsets: one counting-sort pass on the first two
+ * bytes (sequential memory traffic), then multikey quicksort per bucket
+ */
+static void sort_text_offsets_bucketed(const char *text, uint32_t *offsets, size_t n) {
+    if (n <= 65536) {
+        sort_text_offsets(text, offsets, n, 0);
+        return;
+    }
+
+    size_t *bucket_start = (size_t*)safe_malloc(65537 * sizeof(size_t));
+    uint32_t *scratch = (uint32_t*)safe_malloc(n * sizeof(uint32_t));
+    memset(bucket_start, 0, 65537 * sizeof(size_t));
+
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char *p = (const unsigned char*)text + offsets[i];
+        bucket_start[((size_t)p[0] << 8 | (p[0] ? p[1] : 0)) + 1]++;
+    }
+    for (size_t b = 1; b <= 65536; b++) {
+        bucket_start[b] += bucket_start[b - 1];
+    }
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char *p = (const unsigned char*)text + offsets[i];
+        scratch[bucket_start[(size_t)p[0] << 8 | (p[0] ? p[1] : 0)]++] = offsets[i];
+    }
+    memcpy(offsets, scratch, n * sizeof(uint32_t));
+
+    // bucket_start[b] now holds the end of bucket b
+    size_t begin = 0;
+    for (size_t b = 0; b < 65536; b++) {
+        size_t end = bucket_start[b];
+        if ((b & 0xFF) != 0 && end - begin > 1) {
+            sort_text_offsets(text, offsets + begin, end - begin, 2);
+        }
+        begin = end;
+    }
+
+    free(scratch);
+    free(bucket_start);
+}
+
+/**
+ * Drop superseded names from the arena and entry list. Offsets change,
+ * so the sorted arrays are emptied and everything becomes tail.
+ * @param index Index to compact
+ */
+static void compact_entries(NameIndex *index) {
+    size_t text_length = 0;
+    int count = 0;
+    roll_index_clear(&index->entry_of_roll);
+
+    // Both the arena and the entry list only shrink, so compact in place
+    for (int i = 0; i < index->entry_count; i++) {
+        NameEntry entry = index->entries[i];
+        if (!entry.live) continue;
+
+        memmove(index->text + text_length, index->text + entry.offset, (size_t)entry.length + 1);
+        entry.offset = (uint32_t)text_length;
+        index->entries[count] = entry;
+        roll_index_put(&index->entry_of_roll, entry.roll_number, count);
+
+        text_length += (size_t)entry.length + 1;
+        count++;
+    }
+
+    index->text_length = text_length;
+    index->entry_count = count;
+    index->live_count = count;
+    index->suffix_count = 0;
+    index->name_order_count = 0;
+    index->indexed_count = 0;
+}
+
+/**
+ * Lower bound of a string among sorted offsets (full comparison)
+ */
+static size_t find_insertion_point(const char *text, const uint32_t *offsets, size_t n, const char *key) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(text + offsets[mid], key) < 0) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Merge sorted tail offsets into a sorted array: each tail item is placed
+ * by binary search and the runs between them are block-copied, so the
+ * cost is O(n + t log n) rather than a full re-sort
+ * @return Newly allocated merged array of n + t offsets
+ */
+static uint32_t* merge_sorted_offsets(const char *text, const uint32_t *sorted, size_t n,
+                                      const uint32_t *tail, size_t t) {
+    uint32_t *merged = (uint32_t*)safe_malloc((n + t > 0 ? n + t : 1) * sizeof(uint32_t));
+    size_t copied = 0, out = 0;
+
+    // The first merge has no sorted array yet (sorted is NULL)
+    if (n == 0) {
+        if (t > 0) memcpy(merged, tail, t * sizeof(uint32_t));
+        return merged;
+    }
+
+    for (size_t i = 0; i < t; i++) {
+        size_t position = copied + find_insertion_point(text, sorted + copied, n - copied, text + tail[i]);
+        if (position > copied) {
+            memcpy(merged + out, sorted + copied, (position - copied) * sizeof(uint32_t));
+            out += position - copied;
+            copied = position;
+        }
+        merged[out++] = tail[i];
+    }
+    if (n > copied) {
+        memcpy(merged + out, sorted + copied, (n - copied) * sizeof(uint32_t));
+    }
+    return merged;
+}
+
+/**
+ * Fold the unsorted tail into the suffix array and name order. Superseded
+ * names stay indexed (searches skip them) until compaction.
+ * @param index Index to update
+ */
+static void merge_tail(NameIndex *index) {
+    int first = index->indexed_count;
+    size_t tail_suffixes = 0;
+    size_t tail_names = 0;
+
+    for (int i = first; i < index->entry_count; i++) {
+        if (index->entries[i].live) {
+            tail_suffixes += index->entries[i].length;
+            tail_names++;
+        }
+    }
+
+    // Every position inside a live tail name starts a suffix
+    uint32_t *suffixes = (uint32_t*)safe_malloc((tail_suffixes > 0 ? tail_suffixes : 1) * sizeof(uint32_t));
+    uint32_t *starts = (uint32_t*)safe_malloc((tail_names > 0 ? tail_names : 1) * sizeof(uint32_t));
+    size_t s = 0, w = 0;
+    for (int i = first; i < index->entry_count; i++) {
+        const NameEntry *entry = &index->entries[i];
+        if (!entry->live) continue;
+
+        for (uint32_t k = 0; k < entry->length; k++) {
+            suffixes[s++] = entry->offset + k;
+        }
+        starts[w++] = entry->offset;
+    }
+
+    sort_text_offsets_bucketed(index->text, suffixes, tail_suffixes);
+    sort_text_offsets_bucketed(index->text, starts, tail_names);
+
+    uint32_t *merged = merge_sorted_offsets(index->text, index->suffixes, index->suffix_count,
+                                            suffixes, tail_suffixes);
+    free(index->suffixes);
+    index->suffixes = merged;
+    index->suffix_count += tail_suffixes;
+
+    // The name order holds entry ids; translate to offsets, merge, translate back
+    size_t named = (size_t)index->name_order_count;
+    uint32_t *name_offsets = (uint32_t*)safe_malloc((named > 0 ? named : 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < named; i++) {
+        name_offsets[i] = index->entries[index->name_order[i]].offset;
+    }
+    merged = merge_sorted_offsets(index->text, name_offsets, named, starts, tail_names);
+
+    free(index->name_order);
+    index->name_order = (int*)safe_malloc((named + tail_names > 0 ? named + tail_names : 1) * sizeof(int));
+    for (size_t i = 0; i < named + tail_names; i++) {
+        int lo = 0, hi = index->entry_count - 1;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (index->entries[mid].offset < merged[i]) lo = mid + 1; else hi = mid;
+        }
+        index->name_order[i] = lo;
+    }
+    index->name_order_count = (int)(named + tail_names);
+    index->indexed_count = index->entry_count;
+
+    free(merged);
+    free(name_offsets);
+    free(starts);
+    free(suffixes);
+}
+
+/**
+ * Bring the sorted arrays up to date if the tail or the dead space has
+ * outgrown its budget
+ * @param index Index to refresh
+ */
+static void refresh_sorted_arrays(NameIndex *index) {
+    int tail = index->entry_count - index->indexed_count;
+    int dead = index->entry_count - index->live_count;
+
+    if (dead > NAME_INDEX_TAIL_MIN + index->live_count) {
+        compact_entries(index);
+        merge_tail(index);
+    } else if (tail > NAME_INDEX_TAIL_MIN + index->indexed_count / 32) {
+        merge_tail(index);
+    }
+}
+
+/* ============================================================================
+ * SEARCH
+ * ============================================================================ */
+
+// Result delivery state shared by both search passes
+typedef struct {
+    NameVisitor visitor;
+    void *context;
+    int max_results;
+    int visited;
+    bool stopped;
+} SearchCursor;
+
+static bool emit_result(SearchCursor *cursor, int roll_number) {
+    if (cursor->stopped) return false;
+
+    cursor->visited++;
+    if (!cursor->visitor(roll_number, cursor->context) || cursor->visited >= cursor->max_results) {
+        cursor->stopped = true;
+    }
+    return !cursor->stopped;
+}
+
+/**
+ * Entry containing a text offset among the sorted entries
+ */
+static const NameEntry* entry_at_offset(const NameIndex *index, uint32_t offset) {
+    int lo = 0, hi = index->indexed_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (index->entries[mid].offset <= offset) lo = mid; else hi = mid - 1;
+    }
+    return &index->entries[lo];
+}
+
+/**
+ * First position in a sorted offset array whose string compares >= key
+ * over the first key_length bytes (or > key when 'upper' is set)
+ */
+static size_t bound_offsets(const char *text, const uint32_t *offsets, size_t n,
+                            const char *key, size_t key_length, bool upper) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strncmp(text + offsets[mid], key, key_length);
+        if (cmp < 0 || (upper && cmp == 0)) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Same as bound_offsets for the name order (entry ids)
+ */
+static int bound_names(const NameIndex *index, const char *key, size_t key_length, bool upper) {
+    int lo = 0, hi = index->name_order_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int cmp = strncmp(index->text + index->entries[index->name_order[mid]].offset, key, key_length);
+        if (cmp < 0 || (upper && cmp == 0)) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Visit the students whose normalized name matches a query. Prefix
+ * matches come first in name order; in substring mode they are followed
+ * by names containing the query elsewhere, each student at most once.
+ * Cost is O(|query| log n + results) plus a scan of the recent-change tail.
+ * @param index Index to search (re-sorted first if the tail is too long)
+ * @param query Raw query text (normalized like the names)
+ * @param mode Prefix or substring matching
+ * @param max_results Maximum number of students to visit
+ * @param visitor Callback receiving each matching roll number
+ * @param context Opaque pointer passed to the visitor
+ * @return Number of students visited
+ */
+int name_index_search(NameIndex *index, const char *query, NameSearchMode mode,
+                      int max_results, NameVisitor visitor, void *context) {
+    if (!index || !query || !visitor || max_results <= 0) return 0;
+
+    char key[NAME_INDEX_KEY_MAX];
+    size_t key_length = normalize_name_key(query, key, sizeof(key));
+    if (key_length == 0 || key_length + 1 >= sizeof(key)) {
+        return 0;
+    }
+
+    refresh_sorted_arrays(index);
+
+    SearchCursor cursor = {visitor, context, max_results, 0, false};
+
+    // Pass 1: prefix matches
+    int first = bound_names(index, key, key_length, false);
+    int last = bound_names(index, key, key_length, true);
+    for (int i = first; i < last && !cursor.stopped; i++) {
+        const NameEntry *entry = &index->entries[index->name_order[i]];
+        if (entry->live) {
+            emit_result(&cursor, entry->roll_number);
+        }
+    }
+    for (int i = index->indexed_count; i < index->entry_count && !cursor.stopped; i++) {
+        const NameEntry *entry = &index->entries[i];
+        if (entry->live && strncmp(index->text + entry->offset, key, key_length) == 0) {
+            emit_result(&cursor, entry->roll_number);
+        }
+    }
+
+    if (mode != NAME_SEARCH_SUBSTRING) {
+        return cursor.visited;
+    }
+
+    // Pass 2: matches inside the name, reported at their first occurrence
+    size_t lo = bound_offsets(index->text, index->suffixes, index->suffix_count, key, key_length, false);
+    size_t hi = bound_offsets(index->text, index->suffixes, index->suffix_count, key, key_length, true);
+    for (size_t i = lo; i < hi && !cursor.stopped; i++) {
+        uint32_t offset = index->suffixes[i];
+        const NameEntry *entry = entry_at_offset(index, offset);
+        if (!entry->live || offset == entry->offset) continue;
+
+        const char *name = index->text + entry->offset;
+        if (strstr(name, key) == index->text + offset) {
+            emit_result(&cursor, entry->roll_number);
+        }
+    }
+    for (int i = index->indexed_count; i < index->entry_count && !cursor.stopped; i++) {
+        const NameEntry *entry = &index->entries[i];
+        if (!entry->live) continue;
+
+        const char *name = index->text + entry->offset;
+        const char *match = strstr(name, key);
+        if (match && match != name) {
+            emit_result(&cursor, entry->roll_number);
+        }
+    }
+
+    return cursor.visited;
+}
@@ -0,0 +1,472 @@
+/*
+ * File: src/rank_tree.c
+ * Path: SchoolRecordSystem/src/rank_tree.c
+ * Description: Order-statistic tree (size-augmented AVL) over (value, roll number)
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Every node carries its subtree size, so rank and k-th element queries
+ *   run in O(log n) next to the usual O(log n) insert/remove
+ * - Nodes live in a growable pool and link by index, never by pointer
+ */
+
+#include "rank_tree.h"
+#include "memory_manager.h"
+
+#define RANK_TREE_INITIAL_CAPACITY 16
+
+/* ============================================================================
+ * NODE HELPERS
+ * ============================================================================ */
+
+static int node_height(const RankTree *tree, int node) {
+    return (node == RANK_TREE_NIL) ? 0 : tree->nodes[node].height;
+}
+
+static int node_size(const RankTree *tree, int node) {
+    return (node == RANK_TREE_NIL) ? 0 : tree->nodes[node].size;
+}
+
+/**
+ * Compare (key, id) pairs
+ * @return Negative, zero or positive like strcmp
+ */
+static int compare_entries(float key_a, int id_a, float key_b, int id_b) {
+    if (key_a < key_b) return -1;
+    if (key_a > key_b) return 1;
+    if (id_a < id_b) return -1;
+    if (id_a > id_b) return 1;
+    return 0;
+}
+
+/**
+ * Recompute height and size of a node from its children
+ */
+static void update_node(RankTree *tree, int node) {
+    RankTreeNode *n = &tree->nodes[node];
+    int left_height = node_height(tree, n->left);
+    int right_height = node_height(tree, n->right);
+    n->height = 1 + (left_height > right_height ? left_height : right_height);
+    n->size = 1 + node_size(tree, n->left) + node_size(tree, n->right);
+}
+
+static int rotate_right(RankTree *tree, int node) {
+    int pivot = tree->nodes[node].left;
+    tree->nodes[node].left = tree->nodes[pivot].right;
+    tree->nodes[pivot].right = node;
+    update_node(tree, node);
+    update_node(tree, pivot);
+    return pivot;
+}
+
+static int rotate_left(RankTree *tree, int node) {
+    int pivot = tree->nodes[node].right;
+    tree->nodes[node].right = tree->nodes[pivot].left;
+    tree->nodes[pivot].left = node;
+    update_node(tree, node);
+    update_node(tree, pivot);
+    return pivot;
+}
+
+/**
+ * Restore the AVL invariant at a node after one of its subtrees changed
+ * @return New subtree root
+ */
+static int rebalance(RankTree *tree, int node) {
+    update_node(tree, node);
+    RankTreeNode *n = &tree->nodes[node];
+    int balance = node_height(tree, n->left) - node_height(tree, n->right);
+
+    if (balance > 1) {
+        int left = n->left;
+        if (node_height(tree, tree->nodes[left].left) < node_height(tree, tree->nodes[left].right)) {
+            n->left = rotate_left(tree, left);
+        }
+        return rotate_right(tree, node);
+    }
+
+    if (balance < -1) {
+        int right = n->right;
+        if (node_height(tree, tree->nodes[right].right) < node_height(tree, tree->nodes[right].left)) {
+            n->right = rotate_right(tree, right);
+        }
+        return rotate_left(tree, node);
+    }
+
+    return node;
+}
+
+/**
+ * Take a node slot from the free list or the pool, growing it if needed
+ * @return Slot index or RANK_TREE_NIL on allocation failure
+ */
+static int allocate_node(RankTree *tree) {
+    if (tree->free_list != RANK_TREE_NIL) {
+        int node = tree->free_list;
+        tree->free_list = tree->nodes[node].left;
+        return node;
+    }
+
+    if (tree->used >= tree->capacity) {
+        int new_capacity = tree->capacity > 0 ? tree->capacity * 2 : RANK_TREE_INITIAL_CAPACITY;
+        RankTreeNode *grown = (RankTreeNode*)safe_realloc(tree->nodes,
+                                                         (size_t)new_capacity * sizeof(RankTreeNode));
+        if (!grown) {
+            return RANK_TREE_NIL;
+        }
+        tree->nodes = grown;
+        tree->capacity = new_capacity;
+    }
+
+    return tree->used++;
+}
+
+static void release_node(RankTree *tree, int node) {
+    tree->nodes[node].left = tree->free_list;
+    tree->free_list = node;
+}
+
+/* ============================================================================
+ * RECURSIVE UPDATES
+ * ============================================================================ */
+
+static int insert_node(RankTree *tree, int node, int fresh) {
+    if (node == RANK_TREE_NIL) {
+        return fresh;
+    }
+
+    const RankTreeNode *f = &tree->nodes[fresh];
+    const RankTreeNode *n = &tree->nodes[node];
+    if (compare_entries(f->key, f->id, n->key, n->id) < 0) {
+        int child = insert_node(tree, n->left, fresh);
+        tree->nodes[node].left = child;
+    } else {
+        int child = insert_node(tree, n->right, fresh);
+        tree->nodes[node].right = child;
+    }
+    return rebalance(tree, node);
+}
+
+/**
+ * Unlink the minimum of a subtree
+ * @param minimum Receives the unlinked node
+ * @return New subtree root
+ */
+static int detach_minimum(RankTree *tree, int node, int *minimum) {
+    if (tree->nodes[node].left == RANK_TREE_NIL) {
+        *minimum = node;
+        return tree->nodes[node].right;
+    }
+    int child = detach_minimum(tree, tree->nodes[node].left, minimum);
+    tree->nodes[node].left = child;
+    return rebalance(tree, node);
+}
+
+static int remove_node(RankTree *tree, int node, float key, int id, bool *removed) {
+    if (node == RANK_TREE_NIL) {
+        return RANK_TREE_NIL;
+    }
+
+    RankTreeNode *n = &tree->nodes[node];
+    int order = compare_entries(key, id, n->key, n->id);
+
+    if (order < 0) {
+        int child = remove_node(tree, n->left, key, id, removed);
+        tree->nodes[node].left = child;
+    } else if (order > 0) {
+        int child = remove_node(tree, n->right, key, id, removed);
+        tree->nodes[node].right = child;
+    } else {
+        *removed = true;
+        int left = n->left;
+        int right = n->right;
+        release_node(tree, node);
+
+        if (left == RANK_TREE_NIL) return right;
+        if (right == RANK_TREE_NIL) return left;
+
+        // Replace with the in-order successor
+        int successor = RANK_TREE_NIL;
+        int rest = detach_minimum(tree, right, &successor);
+        tree->nodes[successor].left = left;
+        tree->nodes[successor].right = rest;
+        return rebalance(tree, successor);
+    }
+
+    return rebalance(tree, node);
+}
+
+/* ============================================================================
+ * PUBLIC INTERFACE
+ * ============================================================================ */
+
+/**
+ * Initialize an empty tree (no allocation until the first insert)
+ * @param tree Tree to initialize
+ */
+void rank_tree_init(RankTree *tree) {
+    if (!tree) return;
+
+    tree->nodes = NULL;
+    tree->capacity = 0;
+    tree->used = 0;
+    tree->free_list = RANK_TREE_NIL;
+    tree->root = RANK_TREE_NIL;
+}
+
+/**
+ * Release the node pool
+ * @param tree Tree to free
+ */
+void rank_tree_free(RankTree *tree) {
+    if (!tree) return;
+
+    free(tree->nodes);
+    rank_tree_init(tree);
+}
+
+/**
+ * Remove all entries but keep the pool for reuse
+ * @param tree Tree to clear
+ */
+void rank_tree_clear(RankTree *tree) {
+    if (!tree) return;
+
+    tree->used = 0;
+    tree->free_list = RANK_TREE_NIL;
+    tree->root = RANK_TREE_NIL;
+}
+
+/**
+ * Insert an entry
+ * @param tree Tree to update
+ * @param key Ordered value
+ * @param id Roll number (tie-breaker)
+ * @return true on success, false on allocation failure
+ */
+bool rank_tree_insert(RankTree *tree, float key, int id) {
+    if (!tree) return false;
+
+    int fresh = allocate_node(tree);
+    if (fresh == RANK_TREE_NIL) {
+        return false;
+    }
+
+    RankTreeNode *n = &tree->nodes[fresh];
+    n->key = key;
+    n->id = id;
+    n->left = RANK_TREE_NIL;
+    n->right = RANK_TREE_NIL;
+    n->height = 1;
+    n->size = 1;
+
+    tree->root = insert_node(tree, tree->root, fresh);
+    return true;
+}
+
+/**
+ * Remove an entry
+ * @param tree Tree to update
+ * @param key Ordered value the entry was inserted with
+ * @param id Roll number the entry was inserted with
+ * @return true if the entry existed
+ */
+bool rank_tree_remove(RankTree *tree, float key, int id) {
+    if (!tree) return false;
+
+    bool removed = false;
+    tree->root = remove_node(tree, tree->root, key, id, &removed);
+    return removed;
+}
+
+/**
+ * Number of entries in the tree
+ * @param tree Tree to query
+ * @return Entry count
+ */
+int rank_tree_size(const RankTree *tree) {
+    return tree ? node_size(tree, tree->root) : 0;
+}
+
+/**
+ * Find the k-th smallest entry (zero-based)
+ * @param tree Tree to query
+ * @param k Rank in ascending order
+ * @param key Receives the entry's key (may be NULL)
+ * @param id Receives the entry's id (may be NULL)
+ * @return false if k is out of range
+ */
+bool rank_tree_select(const RankTree *tree, int k, float *key, int *id) {
+    if (!tree || k < 0 || k >= rank_tree_size(tree)) {
+        return false;
+    }
+
+    int node = tree->root;
+    while (node != RANK_TREE_NIL) {
+        const RankTreeNode *n = &tree->nodes[node];
+        int left_size = node_size(tree, n->left);
+
+        if (k < left_size) {
+            node = n->left;
+        } else if (k == left_size) {
+            if (key) *key = n->key;
+            if (id) *id = n->id;
+            return true;
+        } else {
+            k -= left_size + 1;
+            node = n->right;
+        }
+    }
+    return false;
+}
+
+/**
+ * Count entries whose key is strictly below a value
+ * @param tree Tree to query
+ * @param key Value to compare against
+ * @return Number of entries with entry.key < key
+ */
+int rank_tree_count_less(const RankTree *tree, float key) {
+    if (!tree) return 0;
+
+    int count = 0;
+    int node = tree->root;
+    while (node != RANK_TREE_NIL) {
+        const RankTreeNode *n = &tree->nodes[node];
+        if (n->key < key) {
+            count += node_size(tree, n->left) + 1;
+            node = n->right;
+        } else {
+            node = n->left;
+        }
+    }
+    return count;
+}
+
+/**
+ * Count entries whose key is strictly above a value
+ * @param tree Tree to query
+ * @param key Value to compare against
+ * @return Number of entries with entry.key > key
+ */
+int rank_tree_count_greater(const RankTree *tree, float key) {
+    if (!tree) return 0;
+
+    int count = 0;
+    int node = tree->root;
+    while (node != RANK_TREE_NIL) {
+        const RankTreeNode *n = &tree->nodes[node];
+        if (n->key > key) {
+            count += node_size(tree, n->right) + 1;
+            node = n->left;
+        } else {
+            node = n->right;
+        }
+    }
+    return count;
+}
+
+/* ============================================================================
+ * TRAVERSAL
+ * ============================================================================ */
+
+/**
+ * Visit entries from the largest down, stopping after 'limit' entries.
+ * Costs O(limit + log n) thanks to an explicit stack of the right spine.
+ * @param tree Tree to walk
+ * @param limit Maximum number of entries to visit (negative = all)
+ * @param visitor Callback per entry; return false to stop
+ * @param context Opaque pointer passed to the visitor
+ * @return Number of entries visited
+ */
+int rank_tree_visit_descending(const RankTree *tree, int limit,
+                               RankTreeVisitor visitor, void *context) {
+    if (!tree || !visitor || limit == 0) return 0;
+
+    int stack[RANK_TREE_MAX_DEPTH];
+    int depth = 0;
+    int visited = 0;
+    int node = tree->root;
+
+    while (node != RANK_TREE_NIL || depth > 0) {
+        while (node != RANK_TREE_NIL) {
+            stack[depth++] = node;
+            node = tree->nodes[node].right;
+        }
+
+        node = stack[--depth];
+        const RankTreeNode *n = &tree->nodes[node];
+        visited++;
+        if (!visitor(n->key, n->id, context) || visited == limit) {
+            break;
+        }
+        node = n->left;
+    }
+
+    return visited;
+}
+
+/**
+ * Visit entries with min_key <= key <= max_key in ascending order.
+ * Costs O(log n + k) for k visited entries.
+ * @param tree Tree to walk
+ * @param min_key Inclusive lower bound
+ * @param max_key Inclusive upper bound
+ * @param visitor Callback per entry; return false to stop
+ * @param context Opaque pointer passed to the visitor
+ * @return Number of entries visited
+ */
+int rank_tree_visit_range(const RankTree *tree, float min_key, float max_key,
+                          RankTreeVisitor visitor, void *context) {
+    if (!tree || !visitor || min_key > max_key) return 0;
+
+    int stack[RANK_TREE_MAX_DEPTH];
+    int depth = 0;
+    int visited = 0;
+    int node = tree->root;
+
+    while (node != RANK_TREE_NIL || depth > 0) {
+        // Descend towards the first entry >= min_key, skipping smaller subtrees
+        while (node != RANK_TREE_NIL) {
+            if (tree->nodes[node].key < min_key) {
+                node = tree->nodes[node].right;
+            } else {
+                stack[depth++] = node;
+                node = tree->nodes[node].left;
+            }
+        }
+        if (depth == 0) {
+            break;
+        }
+
+        node = stack[--depth];
+        const RankTreeNode *n = &tree->nodes[node];
+        if (n->key > max_key) {
+            break;
+        }
+
+        visited++;
+        if (!visitor(n->key, n->id, context)) {
+            break;
+        }
+        node = n->right;
+    }
+
+    return visited;
+}
+
+/**
+ * Count entries with min_key <= key <= max_key in O(log n)
+ * @param tree Tree to query
+ * @param min_key Inclusive lower bound
+ * @param max_key Inclusive upper bound
+ * @return Number of entries in range
+ */
+int rank_tree_count_range(const RankTree *tree, float min_key, float max_key) {
+    if (!tree || min_key > max_key) return 0;
+
+    return rank_tree_size(tree) - rank_tree_count_less(tree, min_key)
+           - rank_tree_count_greater(tree, max_key);
+}
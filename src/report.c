@@ -0,0 +1,573 @@
+/*
+ * File: src/report.c
+ * Path: SchoolRecordSystem/src/report.c
+ * Description: Statistics reports built by a parallel scan over a snapshot
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Stages: snapshot -> range scans on worker threads -> merge in range
+ *   order -> formatter -> buffered writer
+ * - Each worker keeps private totals, so the scan shares nothing but the
+ *   snapshot; merging in range order keeps the output independent of the
+ *   thread count
+ * - Quartiles come from merged counts per hundredth of a mark, so the
+ *   scan never has to keep the marks themselves
+ */
+
+#include "report.h"
+#include "calculations.h"
+#include "memory_manager.h"
+#include "logger.h"
+#include <pthread.h>
+#include <strings.h>
+#include <unistd.h>
+
+/* ============================================================================
+ * SCAN AND MERGE
+ * ============================================================================ */
+
+static void totals_init(ReportTotals *totals) {
+    memset(totals, 0, sizeof(*totals));
+    breakdown_init(&totals->overall);
+    for (int g = 0; g < GRADE_COUNT; g++) {
+        breakdown_init(&totals->grades[g]);
+    }
+    course_table_init(&totals->courses);
+    totals->marks_counts = (int*)safe_malloc(MARKS_FIXED_POINT_BUCKETS * sizeof(int));
+    memset(totals->marks_counts, 0, MARKS_FIXED_POINT_BUCKETS * sizeof(int));
+}
+
+void free_report_totals(ReportTotals *totals) {
+    if (!totals) return;
+    free(totals->marks_counts);
+    totals->marks_counts = NULL;
+    course_table_free(&totals->courses);
+}
+
+static void scan_student(ReportTotals *totals, const Student *student, int position) {
+    float marks = student->marks;
+
+    breakdown_add(&totals->overall, marks, position);
+    breakdown_add(&totals->grades[grade_index_for_marks(marks)], marks, position);
+    if (totals->overall.highest_position == position) totals->highest = *student;
+    if (totals->overall.lowest_position == position) totals->lowest = *student;
+
+    long bucket = lroundf(marks * MARKS_FIXED_POINT_SCALE);
+    if (bucket < 0) bucket = 0;
+    if (bucket >= MARKS_FIXED_POINT_BUCKETS) bucket = MARKS_FIXED_POINT_BUCKETS - 1;
+    totals->marks_counts[bucket]++;
+
+    if (student->course_count > 0) {
+        totals->sum_gpa += student->gpa;
+        totals->students_with_courses++;
+    }
+    group_student_courses(&totals->courses, student, position);
+}
+
+/**
+ * Fold a later range's totals into an earlier range's
+ */
+static void merge_totals(ReportTotals *into, const ReportTotals *from) {
+    breakdown_merge(&into->overall, &from->overall);
+    if (from->overall.count > 0) {
+        // Positions are unique across ranges, so a match means the extreme came from 'from'
+        if (into->overall.highest_position == from->overall.highest_position) into->highest = from->highest;
+        if (into->overall.lowest_position == from->overall.lowest_position) into->lowest = from->lowest;
+    }
+
+    for (int g = 0; g < GRADE_COUNT; g++) {
+        breakdown_merge(&into->grades[g], &from->grades[g]);
+    }
+    for (int b = 0; b < MARKS_FIXED_POINT_BUCKETS; b++) {
+        into->marks_counts[b] += from->marks_counts[b];
+    }
+    into->sum_gpa += from->sum_gpa;
+    into->students_with_courses += from->students_with_courses;
+    course_table_merge(&into->courses, &from->courses);
+}
+
+// One scan thread's share of the snapshot
+typedef struct {
+    StudentDatabase *db;
+    const Snapshot *snapshot;
+    int first;
+    int last;                            // One past the final position
+    ReportTotals totals;
+} ReportWorker;
+
+static void* scan_range(void *argument) {
+    ReportWorker *worker = (ReportWorker*)argument;
+    Student *chunk = (Student*)safe_malloc(SNAPSHOT_CHUNK_RECORDS * sizeof(Student));
+
+    int position = worker->first;
+    while (position < worker->last) {
+        int wanted = worker->last - position;
+        if (wanted > SNAPSHOT_CHUNK_RECORDS) wanted = SNAPSHOT_CHUNK_RECORDS;
+
+        int copied = read_student_snapshot(worker->db, worker->snapshot, position, chunk, wanted);
+        if (copied <= 0) break;
+        for (int i = 0; i < copied; i++) {
+            scan_student(&worker->totals, &chunk[i], position + i);
+        }
+        position += copied;
+    }
+
+    free(chunk);
+    return NULL;
+}
+
+static int scan_thread_count(int requested, int records) {
+    int threads = requested;
+    if (threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (int)online : 1;
+    }
+    if (threads > REPORT_MAX_THREADS) threads = REPORT_MAX_THREADS;
+
+    int useful = (records + REPORT_MIN_RECORDS_PER_THREAD - 1) / REPORT_MIN_RECORDS_PER_THREAD;
+    if (threads > useful) threads = useful;
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * Gather report totals from a snapshot, scanning chunk-aligned ranges on
+ * up to 'threads' threads (a range whose thread cannot start is scanned
+ * by the caller)
+ * @param db Database the snapshot was opened on
+ * @param snapshot Open snapshot
+ * @param threads Scan threads (0: one per online CPU)
+ * @param totals Receives the totals (free with free_report_totals)
+ * @return true on success
+ */
+bool collect_report_totals(StudentDatabase *db, const Snapshot *snapshot, int threads,
+                           ReportTotals *totals) {
+    if (!db || !snapshot || !totals) return false;
+
+    int records = snapshot->count;
+    int thread_count = scan_thread_count(threads, records);
+
+    // Whole chunks per range, so no chunk is copied by two threads
+    int chunks = (records + SNAPSHOT_CHUNK_RECORDS - 1) / SNAPSHOT_CHUNK_RECORDS;
+    int chunks_per_thread = (chunks + thread_count - 1) / thread_count;
+    int range = chunks_per_thread * SNAPSHOT_CHUNK_RECORDS;
+
+    ReportWorker workers[REPORT_MAX_THREADS];
+    pthread_t handles[REPORT_MAX_THREADS];
+    bool started[REPORT_MAX_THREADS];
+
+    for (int t = 0; t < thread_count; t++) {
+        ReportWorker *worker = &workers[t];
+        worker->db = db;
+        worker->snapshot = snapshot;
+        worker->first = t * range < records ? t * range : records;
+        worker->last = worker->first + range < records ? worker->first + range : records;
+        totals_init(&worker->totals);
+
+        // The caller scans the first range itself
+        started[t] = t > 0 && pthread_create(&handles[t], NULL, scan_range, worker) == 0;
+    }
+
+    for (int t = 0; t < thread_count; t++) {
+        if (!started[t]) {
+            scan_range(&workers[t]);
+        }
+    }
+    for (int t = 0; t < thread_count; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        }
+    }
+
+    // Range order: ties between ranges go to the earlier one
+    *totals = workers[0].totals;
+    for (int t = 1; t < thread_count; t++) {
+        merge_totals(totals, &workers[t].totals);
+        free_report_totals(&workers[t].totals);
+    }
+
+    LOG_DEBUG("Report scan of %d students on %d threads found %d courses",
+              records, thread_count, totals->courses.count);
+    return true;
+}
+
+/* ============================================================================
+ * FORMATTERS
+ * ============================================================================ */
+
+static void quartiles_of(const ReportTotals *totals, float quartiles[3]) {
+    static const float requested[3] = {25.0f, 50.0f, 75.0f};
+    quartiles[0] = quartiles[1] = quartiles[2] = 0.0f;
+    if (totals->overall.count > 0) {
+        calculate_quantiles_from_counts(totals->marks_counts, totals->overall.count,
+                                        requested, quartiles, 3);
+    }
+}
+
+static float average_gpa_of(const ReportTotals *totals) {
+    return totals->students_with_courses > 0 ?
+           (float)(totals->sum_gpa / totals->students_with_courses) : 0.0f;
+}
+
+// Formatter state for the streamed student listing
+typedef struct {
+    FILE *out;
+    bool first;
+} ListingWriter;
+
+/* ---------------------------------------------------------------- text --- */
+
+static void write_text_breakdown(FILE *out, const char *label, const MarksBreakdown *breakdown) {
+    fprintf(out, "%-24.24s %8d %8.2f %7.2f %7.2f %7.2f %8d %6.1f%%",
+            label, breakdown->count, breakdown_mean(breakdown),
+            breakdown_standard_deviation(breakdown),
+            breakdown->count > 0 ? breakdown->lowest : 0.0f,
+            breakdown->count > 0 ? breakdown->highest : 0.0f,
+            breakdown->passed, breakdown_pass_rate(breakdown));
+    for (int g = 0; g < GRADE_COUNT; g++) {
+        fprintf(out, " %6d", breakdown->grade_counts[g]);
+    }
+    fputc('\n', out);
+}
+
+static void write_text_breakdown_header(FILE *out, const char *label) {
+    fprintf(out, "%-24s %8s %8s %7s %7s %7s %8s %7s %6s %6s %6s %6s %6s %6s\n",
+            label, "Students", "Average", "StdDev", "Lowest", "Highest", "Passed", "Pass",
+            "A", "B", "C", "D", "E", "F");
+}
+
+static bool write_text_student(const Student *student, int position, void *context) {
+    ListingWriter *writer = (ListingWriter*)context;
+    fprintf(writer->out, "%-8d %-30.30s %7.2f    %c    %5.2f  %s\n",
+            student->roll_number, student->name, student->marks,
+            grade_letter(grade_index_for_marks(student->marks)), student->gpa, student->status);
+    return true;
+}
+
+static void write_text_report(StudentDatabase *db, const Snapshot *snapshot,
+                              const ReportTotals *totals, int sections, FILE *out) {
+    const MarksBreakdown *overall = &totals->overall;
+
+    fprintf(out, "Student Statistics Report\n");
+    fprintf(out, "=========================\n");
+
+    if (sections & REPORT_SECTION_SUMMARY) {
+        float quartiles[3];
+        quartiles_of(totals, quartiles);
+
+        fprintf(out, "\nStudents:            %d\n", overall->count);
+        if (overall->count > 0) {
+            fprintf(out, "Average marks:       %.2f\n", breakdown_mean(overall));
+            fprintf(out, "Standard deviation:  %.2f\n", breakdown_standard_deviation(overall));
+            fprintf(out, "Quartiles:           %.2f / %.2f / %.2f\n",
+                    quartiles[0], quartiles[1], quartiles[2]);
+            fprintf(out, "Highest marks:       %.2f (%s, roll %d)\n",
+                    totals->highest.marks, totals->highest.name, totals->highest.roll_number);
+            fprintf(out, "Lowest marks:        %.2f (%s, roll %d)\n",
+                    totals->lowest.marks, totals->lowest.name, totals->lowest.roll_number);
+            fprintf(out, "Passed:              %d (%.2f%%)\n", overall->passed,
+                    PERCENTAGE_OF_TOTAL(overall->passed, overall->count));
+            fprintf(out, "Failed:              %d (%.2f%%)\n", overall->count - overall->passed,
+                    PERCENTAGE_OF_TOTAL(overall->count - overall->passed, overall->count));
+            fprintf(out, "Average GPA:         %.2f (%d students with courses)\n",
+                    average_gpa_of(totals), totals->students_with_courses);
+        }
+    }
+
+    if (sections & REPORT_SECTION_GRADES) {
+        fprintf(out, "\nGrade Distribution\n");
+        fprintf(out, "------------------\n");
+        fprintf(out, "%-5s %7s %8s %8s %8s %7s %7s\n",
+                "Grade", "From", "Students", "Share", "Average", "Lowest", "Highest");
+        for (int g = 0; g < GRADE_COUNT; g++) {
+            const MarksBreakdown *grade = &totals->grades[g];
+            fprintf(out, "%-5c %7.2f %8d %7.2f%% %8.2f %7.2f %7.2f\n",
+                    grade_letter(g), grade_minimum_marks(g), grade->count,
+                    PERCENTAGE_OF_TOTAL(grade->count, overall->count), breakdown_mean(grade),
+                    grade->count > 0 ? grade->lowest : 0.0f,
+                    grade->count > 0 ? grade->highest : 0.0f);
+        }
+    }
+
+    if (sections & REPORT_SECTION_COURSES) {
+        fprintf(out, "\nCourses\n");
+        fprintf(out, "-------\n");
+        write_text_breakdown_header(out, "Course");
+        CourseBreakdown *courses = course_table_sorted(&totals->courses);
+        for (int i = 0; i < totals->courses.count; i++) {
+            write_text_breakdown(out, courses[i].course_name, &courses[i].scores);
+        }
+        free(courses);
+    }
+
+    if (sections & REPORT_SECTION_STUDENTS) {
+        fprintf(out, "\nStudents\n");
+        fprintf(out, "--------\n");
+        fprintf(out, "%-8s %-30s %7s  %s  %5s  %s\n", "Roll", "Name", "Marks", "Grade", "GPA", "Status");
+        ListingWriter writer = {out, true};
+        visit_student_snapshot(db, snapshot, write_text_student, &writer);
+    }
+}
+
+/* ----------------------------------------------------------------- CSV --- */
+
+static void write_csv_text(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const char *c = text; *c; c++) {
+        if (*c == '"') fputc('"', out);
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static void write_csv_breakdown(FILE *out, const char *group, const char *name,
+                                const MarksBreakdown *breakdown) {
+    fprintf(out, "%s,", group);
+    write_csv_text(out, name);
+    fprintf(out, ",%d,%.2f,%.2f,%.2f,%.2f,%d,%.2f",
+            breakdown->count, breakdown_mean(breakdown), breakdown_standard_deviation(breakdown),
+            breakdown->count > 0 ? breakdown->lowest : 0.0f,
+            breakdown->count > 0 ? breakdown->highest : 0.0f,
+            breakdown->passed, breakdown_pass_rate(breakdown));
+    for (int g = 0; g < GRADE_COUNT; g++) {
+        fprintf(out, ",%d", breakdown->grade_counts[g]);
+    }
+    fputc('\n', out);
+}
+
+/**
+ * One row per breakdown: the whole class, each grade and each course.
+ * The student listing is left to export_to_csv().
+ */
+static void write_csv_report(const ReportTotals *totals, int sections, FILE *out) {
+    fprintf(out, "Group,Name,Students,Average,Std Dev,Lowest,Highest,Passed,Pass Rate,A,B,C,D,E,F\n");
+
+    if (sections & REPORT_SECTION_SUMMARY) {
+        write_csv_breakdown(out, "overall", "All students", &totals->overall);
+    }
+    if (sections & REPORT_SECTION_GRADES) {
+        for (int g = 0; g < GRADE_COUNT; g++) {
+            char letter[2] = {grade_letter(g), '\0'};
+            write_csv_breakdown(out, "grade", letter, &totals->grades[g]);
+        }
+    }
+    if (sections & REPORT_SECTION_COURSES) {
+        CourseBreakdown *courses = course_table_sorted(&totals->courses);
+        for (int i = 0; i < totals->courses.count; i++) {
+            write_csv_breakdown(out, "course", courses[i].course_name, &courses[i].scores);
+        }
+        free(courses);
+    }
+}
+
+/* ---------------------------------------------------------------- JSON --- */
+
+/**
+ * Write a string as a quoted JSON string, escaping quotes, backslashes
+ * and control characters (shared with the batch results)
+ * @param out Output stream
+ * @param text String to write
+ */
+void write_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char*)text; *c; c++) {
+        switch (*c) {
+            case '"': fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\r': fputs("\\r", out); break;
+            case '\t': fputs("\\t", out); break;
+            default:
+                if (*c < 0x20) {
+                    fprintf(out, "\\u%04x", *c);
+                } else {
+                    fputc(*c, out);
+                }
+                break;
+        }
+    }
+    fputc('"', out);
+}
+
+static void write_json_breakdown(FILE *out, const MarksBreakdown *breakdown) {
+    fprintf(out, "\"students\": %d, \"average\": %.2f, \"std_dev\": %.2f, "
+            "\"lowest\": %.2f, \"highest\": %.2f, \"passed\": %d, \"pass_rate\": %.2f, "
+            "\"grades\": [%d, %d, %d, %d, %d, %d]",
+            breakdown->count, breakdown_mean(breakdown), breakdown_standard_deviation(breakdown),
+            breakdown->count > 0 ? breakdown->lowest : 0.0f,
+            breakdown->count > 0 ? breakdown->highest : 0.0f,
+            breakdown->passed, breakdown_pass_rate(breakdown),
+            breakdown->grade_counts[0], breakdown->grade_counts[1], breakdown->grade_counts[2],
+            breakdown->grade_counts[3], breakdown->grade_counts[4], breakdown->grade_counts[5]);
+}
+
+static void write_json_student_ref(FILE *out, const char *key, const Student *student) {
+    fprintf(out, ",\n  \"%s\": {\"roll_number\": %d, \"name\": ", key, student->roll_number);
+    write_json_string(out, student->name);
+    fprintf(out, ", \"marks\": %.2f}", student->marks);
+}
+
+static bool write_json_student(const Student *student, int position, void *context) {
+    ListingWriter *writer = (ListingWriter*)context;
+    fprintf(writer->out, "%s\n    {\"roll_number\": %d, \"name\": ",
+            writer->first ? "" : ",", student->roll_number);
+    write_json_string(writer->out, student->name);
+    fprintf(writer->out, ", \"marks\": %.2f, \"grade\": \"%c\", \"gpa\": %.2f, \"courses\": %d, \"status\": ",
+            student->marks, grade_letter(grade_index_for_marks(student->marks)),
+            student->gpa, student->course_count);
+    write_json_string(writer->out, student->status);
+    fputc('}', writer->out);
+    writer->first = false;
+    return true;
+}
+
+static void write_json_report(StudentDatabase *db, const Snapshot *snapshot,
+                              const ReportTotals *totals, int sections, FILE *out) {
+    fprintf(out, "{\n  \"students\": %d", totals->overall.count);
+
+    if (sections & REPORT_SECTION_SUMMARY) {
+        float quartiles[3];
+        quartiles_of(totals, quartiles);
+
+        fprintf(out, ",\n  \"overall\": {");
+        write_json_breakdown(out, &totals->overall);
+        fprintf(out, "},\n  \"quartiles\": {\"p25\": %.2f, \"p50\": %.2f, \"p75\": %.2f}",
+                quartiles[0], quartiles[1], quartiles[2]);
+        if (totals->overall.count > 0) {
+            write_json_student_ref(out, "highest", &totals->highest);
+            write_json_student_ref(out, "lowest", &totals->lowest);
+        }
+        fprintf(out, ",\n  \"average_gpa\": %.2f,\n  \"students_with_courses\": %d",
+                average_gpa_of(totals), totals->students_with_courses);
+    }
+
+    if (sections & REPORT_SECTION_GRADES) {
+        fprintf(out, ",\n  \"grade_distribution\": [");
+        for (int g = 0; g < GRADE_COUNT; g++) {
+            fprintf(out, "%s\n    {\"grade\": \"%c\", \"from\": %.2f, \"share\": %.2f, ",
+                    g > 0 ? "," : "", grade_letter(g), grade_minimum_marks(g),
+                    PERCENTAGE_OF_TOTAL(totals->grades[g].count, totals->overall.count));
+            write_json_breakdown(out, &totals->grades[g]);
+            fputc('}', out);
+        }
+        fprintf(out, "\n  ]");
+    }
+
+    if (sections & REPORT_SECTION_COURSES) {
+        fprintf(out, ",\n  \"courses\": [");
+        CourseBreakdown *courses = course_table_sorted(&totals->courses);
+        for (int i = 0; i < totals->courses.count; i++) {
+            fprintf(out, "%s\n    {\"course\": ", i > 0 ? "," : "");
+            write_json_string(out, courses[i].course_name);
+            fprintf(out, ", ");
+            write_json_breakdown(out, &courses[i].scores);
+            fputc('}', out);
+        }
+        free(courses);
+        fprintf(out, "\n  ]");
+    }
+
+    if (sections & REPORT_SECTION_STUDENTS) {
+        fprintf(out, ",\n  \"student_records\": [");
+        ListingWriter writer = {out, true};
+        visit_student_snapshot(db, snapshot, write_json_student, &writer);
+        fprintf(out, "\n  ]");
+    }
+
+    fprintf(out, "\n}\n");
+}
+
+/* ============================================================================
+ * REPORTS
+ * ============================================================================ */
+
+/**
+ * Write a report of the database as it is now
+ * @param db Student database
+ * @param options Format, sections and scan threads
+ * @param output Stream to write to
+ * @return true if the report was written
+ */
+bool write_report(StudentDatabase *db, const ReportOptions *options, FILE *output) {
+    if (!db || !options || !output) return false;
+
+    Snapshot *snapshot = open_student_snapshot(db);
+    ReportTotals totals;
+    if (!collect_report_totals(db, snapshot, options->threads, &totals)) {
+        close_student_snapshot(db, snapshot);
+        return false;
+    }
+
+    switch (options->format) {
+        case REPORT_FORMAT_CSV:
+            write_csv_report(&totals, options->sections, output);
+            break;
+        case REPORT_FORMAT_JSON:
+            write_json_report(db, snapshot, &totals, options->sections, output);
+            break;
+        default:
+            write_text_report(db, snapshot, &totals, options->sections, output);
+            break;
+    }
+
+    free_report_totals(&totals);
+    close_student_snapshot(db, snapshot);
+    return !ferror(output);
+}
+
+/**
+ * Write a report to a file through a large output buffer
+ * @param db Student database
+ * @param options Format, sections and scan threads
+ * @param filename File to create
+ * @return true if the report was written
+ */
+bool write_report_file(StudentDatabase *db, const ReportOptions *options, const char *filename) {
+    if (!db || !options || !filename) return false;
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        LOG_ERROR("Error opening file for report: %s", filename);
+        return false;
+    }
+
+    char *buffer = (char*)safe_malloc(REPORT_WRITE_BUFFER);
+    setvbuf(file, buffer, _IOFBF, REPORT_WRITE_BUFFER);
+
+    bool written = write_report(db, options, file);
+    if (fclose(file) != 0) {
+        written = false;
+    }
+    free(buffer);
+
+    if (!written) {
+        LOG_ERROR("Error writing report: %s", filename);
+        remove(filename);
+    }
+    return written;
+}
+
+ReportFormat report_format_for_file(const char *filename) {
+    const char *extension = filename ? strrchr(filename, '.') : NULL;
+    ReportFormat format = REPORT_FORMAT_TEXT;
+    if (extension) {
+        report_format_from_string(extension + 1, &format);
+    }
+    return format;
+}
+
+bool report_format_from_string(const char *name, ReportFormat *format) {
+    static const char *names[] = {"text", "csv", "json"};
+    for (int i = 0; i < 3; i++) {
+        if (strcasecmp(name, names[i]) == 0) {
+            *format = (ReportFormat)i;
+            return true;
+        }
+    }
+    if (strcasecmp(name, "txt") == 0) {
+        *format = REPORT_FORMAT_TEXT;
+        return true;
+    }
+    return false;
+}
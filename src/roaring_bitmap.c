@@ -0,0 +1,643 @@
+/*
+ * File: src/roaring_bitmap.c
+ * Path: SchoolRecordSystem/src/roaring_bitmap.c
+ * Description: Compressed (roaring-style) bitmap over 32-bit values
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Values are split into a 16-bit container key and a 16-bit low part
+ * - Sparse containers hold a sorted uint16_t array, dense ones 1024 words
+ * - Set operations on dense containers run a 64-bit word at a time
+ */
+
+#include "roaring_bitmap.h"
+#include "memory_manager.h"
+
+typedef enum {
+    ROARING_OP_AND,
+    ROARING_OP_OR,
+    ROARING_OP_ANDNOT
+} RoaringOp;
+
+/* ============================================================================
+ * CONTAINER HELPERS
+ * ============================================================================ */
+
+static void container_free(RoaringContainer *c) {
+    free(c->array);
+    free(c->words);
+    c->array = NULL;
+    c->words = NULL;
+    c->cardinality = 0;
+    c->capacity = 0;
+}
+
+static void container_init(RoaringContainer *c, uint16_t key) {
+    c->key = key;
+    c->is_bitmap = false;
+    c->cardinality = 0;
+    c->capacity = 0;
+    c->array = NULL;
+    c->words = NULL;
+}
+
+/**
+ * Binary search the low part in an array container
+ * @return Index if found, otherwise -(insertion point) - 1
+ */
+static int array_find(const RoaringContainer *c, uint16_t low) {
+    int lo = 0;
+    int hi = c->cardinality - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        if (c->array[mid] < low) {
+            lo = mid + 1;
+        } else if (c->array[mid] > low) {
+            hi = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+    return -(lo + 1);
+}
+
+static void container_to_bitmap(RoaringContainer *c) {
+    uint64_t *words = (uint64_t*)safe_malloc(ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+    memset(words, 0, ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+    for (int i = 0; i < c->cardinality; i++) {
+        words[c->array[i] >> 6] |= (uint64_t)1 << (c->array[i] & 63);
+    }
+
+    free(c->array);
+    c->array = NULL;
+    c->capacity = 0;
+    c->words = words;
+    c->is_bitmap = true;
+}
+
+static void container_to_array(RoaringContainer *c) {
+    int capacity = c->cardinality > 0 ? c->cardinality : 1;
+    uint16_t *array = (uint16_t*)safe_malloc((size_t)capacity * sizeof(uint16_t));
+    int n = 0;
+    for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) {
+        uint64_t word = c->words[w];
+        while (word) {
+            array[n++] = (uint16_t)(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+
+    free(c->words);
+    c->words = NULL;
+    c->array = array;
+    c->capacity = capacity;
+    c->is_bitmap = false;
+}
+
+/**
+ * Build a container from dense words, picking the cheaper representation
+ * @param words Words to take over (ownership passes to the container)
+ */
+static void container_adopt_words(RoaringContainer *c, uint64_t *words) {
+    int cardinality = 0;
+    for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) {
+        cardinality += __builtin_popcountll(words[w]);
+    }
+
+    c->words = words;
+    c->is_bitmap = true;
+    c->cardinality = cardinality;
+    if (cardinality <= ROARING_ARRAY_MAX) {
+        container_to_array(c);
+    }
+}
+
+/**
+ * Expand any container into a dense word buffer
+ */
+static void container_expand(const RoaringContainer *c, uint64_t *words) {
+    if (c->is_bitmap) {
+        memcpy(words, c->words, ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+        return;
+    }
+
+    memset(words, 0, ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+    for (int i = 0; i < c->cardinality; i++) {
+        words[c->array[i] >> 6] |= (uint64_t)1 << (c->array[i] & 63);
+    }
+}
+
+static bool container_test(const RoaringContainer *c, uint16_t low) {
+    if (c->is_bitmap) {
+        return (c->words[low >> 6] >> (low & 63)) & 1;
+    }
+    return array_find(c, low) >= 0;
+}
+
+static void container_copy(RoaringContainer *dest, const RoaringContainer *src) {
+    container_init(dest, src->key);
+    dest->cardinality = src->cardinality;
+    dest->is_bitmap = src->is_bitmap;
+
+    if (src->is_bitmap) {
+        dest->words = (uint64_t*)safe_malloc(ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+        memcpy(dest->words, src->words, ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+    } else {
+        dest->capacity = src->cardinality > 0 ? src->cardinality : 1;
+        dest->array = (uint16_t*)safe_malloc((size_t)dest->capacity * sizeof(uint16_t));
+        memcpy(dest->array, src->array, (size_t)src->cardinality * sizeof(uint16_t));
+    }
+}
+
+/**
+ * Combine two containers with the same key
+ * @param out Receives the result (cardinality may be 0)
+ */
+static void container_combine(const RoaringContainer *a, const RoaringContainer *b,
+                              RoaringOp op, RoaringContainer *out) {
+    container_init(out, a->key);
+
+    // Sparse inputs: merge the sorted arrays
+    if (!a->is_bitmap && !b->is_bitmap) {
+        int capacity = (op == ROARING_OP_OR) ? a->cardinality + b->cardinality : a->cardinality;
+        uint16_t *merged = (uint16_t*)safe_malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(uint16_t));
+        int i = 0, j = 0, n = 0;
+
+        while (i < a->cardinality && j < b->cardinality) {
+            if (a->array[i] < b->array[j]) {
+                if (op != ROARING_OP_AND) merged[n++] = a->array[i];
+                i++;
+            } else if (a->array[i] > b->array[j]) {
+                if (op == ROARING_OP_OR) merged[n++] = b->array[j];
+                j++;
+            } else {
+                if (op != ROARING_OP_ANDNOT) merged[n++] = a->array[i];
+                i++;
+                j++;
+            }
+        }
+        if (op != ROARING_OP_AND) {
+            while (i < a->cardinality) merged[n++] = a->array[i++];
+        }
+        if (op == ROARING_OP_OR) {
+            while (j < b->cardinality) merged[n++] = b->array[j++];
+        }
+
+        out->array = merged;
+        out->capacity = capacity > 0 ? capacity : 1;
+        out->cardinality = n;
+        if (n > ROARING_ARRAY_MAX) {
+            container_to_bitmap(out);
+        }
+        return;
+    }
+
+    // A sparse left side under AND/ANDNOT only needs membership tests
+    if (!a->is_bitmap && op != ROARING_OP_OR) {
+        uint16_t *filtered = (uint16_t*)safe_malloc((size_t)(a->cardinality > 0 ? a->cardinality : 1) * sizeof(uint16_t));
+        int n = 0;
+        for (int i = 0; i < a->cardinality; i++) {
+            bool in_b = container_test(b, a->array[i]);
+            if (in_b == (op == ROARING_OP_AND)) {
+                filtered[n++] = a->array[i];
+            }
+        }
+        out->array = filtered;
+        out->capacity = a->cardinality > 0 ? a->cardinality : 1;
+        out->cardinality = n;
+        return;
+    }
+
+    // Same for a sparse right side under AND
+    if (!b->is_bitmap && op == ROARING_OP_AND) {
+        container_combine(b, a, op, out);
+        out->key = a->key;
+        return;
+    }
+
+    // Dense path: word-level operations
+    uint64_t left[ROARING_CONTAINER_WORDS];
+    uint64_t right[ROARING_CONTAINER_WORDS];
+    const uint64_t *lw = a->words;
+    const uint64_t *rw = b->words;
+    if (!a->is_bitmap) {
+        container_expand(a, left);
+        lw = left;
+    }
+    if (!b->is_bitmap) {
+        container_expand(b, right);
+        rw = right;
+    }
+
+    uint64_t *words = (uint64_t*)safe_malloc(ROARING_CONTAINER_WORDS * sizeof(uint64_t));
+    switch (op) {
+        case ROARING_OP_AND:
+            for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) words[w] = lw[w] & rw[w];
+            break;
+        case ROARING_OP_OR:
+            for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) words[w] = lw[w] | rw[w];
+            break;
+        case ROARING_OP_ANDNOT:
+            for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) words[w] = lw[w] & ~rw[w];
+            break;
+    }
+    container_adopt_words(out, words);
+}
+
+/* ============================================================================
+ * CONTAINER LIST HELPERS
+ * ============================================================================ */
+
+/**
+ * Binary search a container key
+ * @return Index if found, otherwise -(insertion point) - 1
+ */
+static int find_container(const RoaringBitmap *bitmap, uint16_t key) {
+    int lo = 0;
+    int hi = bitmap->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        uint16_t mid_key = bitmap->containers[mid].key;
+        if (mid_key < key) {
+            lo = mid + 1;
+        } else if (mid_key > key) {
+            hi = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+    return -(lo + 1);
+}
+
+static void ensure_container_capacity(RoaringBitmap *bitmap) {
+    if (bitmap->count < bitmap->capacity) {
+        return;
+    }
+    int new_capacity = bitmap->capacity > 0 ? bitmap->capacity * 2 : 4;
+    bitmap->containers = (RoaringContainer*)safe_realloc(bitmap->containers,
+                                                         (size_t)new_capacity * sizeof(RoaringContainer));
+    bitmap->capacity = new_capacity;
+}
+
+static RoaringContainer* insert_container(RoaringBitmap *bitmap, int position, uint16_t key) {
+    ensure_container_capacity(bitmap);
+    memmove(&bitmap->containers[position + 1], &bitmap->containers[position],
+            (size_t)(bitmap->count - position) * sizeof(RoaringContainer));
+    bitmap->count++;
+    container_init(&bitmap->containers[position], key);
+    return &bitmap->containers[position];
+}
+
+static void remove_container(RoaringBitmap *bitmap, int position) {
+    container_free(&bitmap->containers[position]);
+    memmove(&bitmap->containers[position], &bitmap->containers[position + 1],
+            (size_t)(bitmap->count - position - 1) * sizeof(RoaringContainer));
+    bitmap->count--;
+}
+
+/**
+ * Append a result container (taking ownership) or drop it if empty
+ */
+static void push_container(RoaringBitmap *bitmap, RoaringContainer *c) {
+    if (c->cardinality == 0) {
+        container_free(c);
+        return;
+    }
+    ensure_container_capacity(bitmap);
+    bitmap->containers[bitmap->count++] = *c;
+}
+
+/* ============================================================================
+ * PUBLIC INTERFACE
+ * ============================================================================ */
+
+/**
+ * Initialize an empty bitmap
+ * @param bitmap Bitmap to initialize
+ */
+void roaring_init(RoaringBitmap *bitmap) {
+    if (!bitmap) return;
+
+    bitmap->containers = NULL;
+    bitmap->count = 0;
+    bitmap->capacity = 0;
+}
+
+/**
+ * Release all storage
+ * @param bitmap Bitmap to free
+ */
+void roaring_free(RoaringBitmap *bitmap) {
+    if (!bitmap) return;
+
+    roaring_clear(bitmap);
+    free(bitmap->containers);
+    roaring_init(bitmap);
+}
+
+/**
+ * Remove all values but keep the container list allocation
+ * @param bitmap Bitmap to clear
+ */
+void roaring_clear(RoaringBitmap *bitmap) {
+    if (!bitmap) return;
+
+    for (int i = 0; i < bitmap->count; i++) {
+        container_free(&bitmap->containers[i]);
+    }
+    bitmap->count = 0;
+}
+
+/**
+ * Replace dest with a deep copy of src
+ * @param dest Destination bitmap (initialized)
+ * @param src Source bitmap
+ * @return true on success
+ */
+bool roaring_copy(RoaringBitmap *dest, const RoaringBitmap *src) {
+    if (!dest || !src || dest == src) return false;
+
+    roaring_clear(dest);
+    for (int i = 0; i < src->count; i++) {
+        RoaringContainer copy;
+        container_copy(&copy, &src->containers[i]);
+        push_container(dest, &copy);
+    }
+    return true;
+}
+
+/**
+ * Add a value
+ * @param bitmap Bitmap to update
+ * @param value Value to add
+ * @return true if the value was not present before
+ */
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value) {
+    if (!bitmap) return false;
+
+    uint16_t key = (uint16_t)(value >> 16);
+    uint16_t low = (uint16_t)(value & 0xFFFF);
+
+    int position = find_container(bitmap, key);
+    RoaringContainer *c = (position >= 0) ? &bitmap->containers[position]
+                                          : insert_container(bitmap, -position - 1, key);
+
+    if (!c->is_bitmap) {
+        int slot = array_find(c, low);
+        if (slot >= 0) {
+            return false;
+        }
+        if (c->cardinality >= ROARING_ARRAY_MAX) {
+            container_to_bitmap(c);
+        } else {
+            slot = -slot - 1;
+            if (c->cardinality >= c->capacity) {
+                int new_capacity = c->capacity > 0 ? c->capacity * 2 : 4;
+                if (new_capacity > ROARING_ARRAY_MAX) new_capacity = ROARING_ARRAY_MAX;
+                c->array = (uint16_t*)safe_realloc(c->array, (size_t)new_capacity * sizeof(uint16_t));
+                c->capacity = new_capacity;
+            }
+            memmove(&c->array[slot + 1], &c->array[slot],
+                    (size_t)(c->cardinality - slot) * sizeof(uint16_t));
+            c->array[slot] = low;
+            c->cardinality++;
+            return true;
+        }
+    }
+
+    uint64_t mask = (uint64_t)1 << (low & 63);
+    if (c->words[low >> 6] & mask) {
+        return false;
+    }
+    c->words[low >> 6] |= mask;
+    c->cardinality++;
+    return true;
+}
+
+/**
+ * Remove a value
+ * @param bitmap Bitmap to update
+ * @param value Value to remove
+ * @return true if the value was present
+ */
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value) {
+    if (!bitmap) return false;
+
+    int position = find_container(bitmap, (uint16_t)(value >> 16));
+    if (position < 0) {
+        return false;
+    }
+
+    RoaringContainer *c = &bitmap->containers[position];
+    uint16_t low = (uint16_t)(value & 0xFFFF);
+
+    if (c->is_bitmap) {
+        uint64_t mask = (uint64_t)1 << (low & 63);
+        if (!(c->words[low >> 6] & mask)) {
+            return false;
+        }
+        c->words[low >> 6] &= ~mask;
+        c->cardinality--;
+        if (c->cardinality <= ROARING_ARRAY_MAX) {
+            container_to_array(c);
+        }
+    } else {
+        int slot = array_find(c, low);
+        if (slot < 0) {
+            return false;
+        }
+        memmove(&c->array[slot], &c->array[slot + 1],
+                (size_t)(c->cardinality - slot - 1) * sizeof(uint16_t));
+        c->cardinality--;
+    }
+
+    if (c->cardinality == 0) {
+        remove_container(bitmap, position);
+    }
+    return true;
+}
+
+/**
+ * Test membership
+ * @param bitmap Bitmap to query
+ * @param value Value to test
+ * @return true if present
+ */
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value) {
+    if (!bitmap) return false;
+
+    int position = find_container(bitmap, (uint16_t)(value >> 16));
+    if (position < 0) {
+        return false;
+    }
+    return container_test(&bitmap->containers[position], (uint16_t)(value & 0xFFFF));
+}
+
+/**
+ * Number of values in the bitmap
+ * @param bitmap Bitmap to query
+ * @return Cardinality
+ */
+int roaring_cardinality(const RoaringBitmap *bitmap) {
+    if (!bitmap) return 0;
+
+    int total = 0;
+    for (int i = 0; i < bitmap->count; i++) {
+        total += bitmap->containers[i].cardinality;
+    }
+    return total;
+}
+
+/**
+ * Shared driver for the binary set operations
+ */
+static bool roaring_combine(const RoaringBitmap *a, const RoaringBitmap *b,
+                            RoaringOp op, RoaringBitmap *out) {
+    if (!a || !b || !out || out == a || out == b) return false;
+
+    roaring_clear(out);
+    int i = 0, j = 0;
+
+    while (i < a->count || j < b->count) {
+        const RoaringContainer *ca = (i < a->count) ? &a->containers[i] : NULL;
+        const RoaringContainer *cb = (j < b->count) ? &b->containers[j] : NULL;
+        RoaringContainer result;
+
+        if (ca && cb && ca->key == cb->key) {
+            container_combine(ca, cb, op, &result);
+            push_container(out, &result);
+            i++;
+            j++;
+        } else if (ca && (!cb || ca->key < cb->key)) {
+            if (op != ROARING_OP_AND) {
+                container_copy(&result, ca);
+                push_container(out, &result);
+            }
+            i++;
+        } else {
+            if (op == ROARING_OP_OR) {
+                container_copy(&result, cb);
+                push_container(out, &result);
+            }
+            j++;
+        }
+
+        // Nothing left that AND/ANDNOT could still produce
+        if (op != ROARING_OP_OR && i >= a->count) {
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * out = a AND b
+ * @return true on success
+ */
+bool roaring_and(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return roaring_combine(a, b, ROARING_OP_AND, out);
+}
+
+/**
+ * out = a OR b
+ * @return true on success
+ */
+bool roaring_or(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return roaring_combine(a, b, ROARING_OP_OR, out);
+}
+
+/**
+ * out = a AND NOT b
+ * @return true on success
+ */
+bool roaring_andnot(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return roaring_combine(a, b, ROARING_OP_ANDNOT, out);
+}
+
+/**
+ * dest |= src. Dense destination containers are updated in place, so a
+ * long chain of unions costs O(total input) rather than re-copying dest.
+ * @param dest Bitmap to extend
+ * @param src Bitmap to merge in (must not alias dest)
+ * @return true on success
+ */
+bool roaring_or_inplace(RoaringBitmap *dest, const RoaringBitmap *src) {
+    if (!dest || !src || dest == src) return false;
+
+    for (int i = 0; i < src->count; i++) {
+        const RoaringContainer *sc = &src->containers[i];
+        int position = find_container(dest, sc->key);
+
+        if (position < 0) {
+            RoaringContainer *slot = insert_container(dest, -position - 1, sc->key);
+            container_copy(slot, sc);
+            continue;
+        }
+
+        RoaringContainer *dc = &dest->containers[position];
+        if (!dc->is_bitmap) {
+            RoaringContainer merged;
+            container_combine(dc, sc, ROARING_OP_OR, &merged);
+            container_free(dc);
+            *dc = merged;
+            continue;
+        }
+
+        // Dense destination: OR in place and keep it dense
+        if (sc->is_bitmap) {
+            int cardinality = 0;
+            for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) {
+                dc->words[w] |= sc->words[w];
+                cardinality += __builtin_popcountll(dc->words[w]);
+            }
+            dc->cardinality = cardinality;
+        } else {
+            for (int k = 0; k < sc->cardinality; k++) {
+                uint16_t low = sc->array[k];
+                uint64_t mask = (uint64_t)1 << (low & 63);
+                if (!(dc->words[low >> 6] & mask)) {
+                    dc->words[low >> 6] |= mask;
+                    dc->cardinality++;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Visit every value in ascending order
+ * @param bitmap Bitmap to walk
+ * @param visitor Callback per value; return false to stop
+ * @param context Opaque pointer passed to the visitor
+ * @return Number of values visited
+ */
+int roaring_visit(const RoaringBitmap *bitmap, RoaringVisitor visitor, void *context) {
+    if (!bitmap || !visitor) return 0;
+
+    int visited = 0;
+    for (int i = 0; i < bitmap->count; i++) {
+        const RoaringContainer *c = &bitmap->containers[i];
+        uint32_t high = (uint32_t)c->key << 16;
+
+        if (c->is_bitmap) {
+            for (int w = 0; w < ROARING_CONTAINER_WORDS; w++) {
+                uint64_t word = c->words[w];
+                while (word) {
+                    uint32_t low = (uint32_t)(w * 64 + __builtin_ctzll(word));
+                    word &= word - 1;
+                    visited++;
+                    if (!visitor(high | low, context)) return visited;
+                }
+            }
+        } else {
+            for (int k = 0; k < c->cardinality; k++) {
+                visited++;
+                if (!visitor(high | c->array[k], context)) return visited;
+            }
+        }
+    }
+    return visited;
+}
@@ -0,0 +1,186 @@
+/*
+ * File: src/roll_index.c
+ * Path: SchoolRecordSystem/src/roll_index.c
+ * Description: Hash index from roll number to position in the students array
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Linear probing with backward-shift deletion (no tombstones)
+ * - The table is kept at most half full
+ */
+
+#include "roll_index.h"
+#include "memory_manager.h"
+
+#define ROLL_INDEX_INITIAL_CAPACITY 16
+
+/**
+ * Home slot for a roll number (Fibonacci hashing)
+ */
+static int home_slot(const RollIndex *index, int roll_number) {
+    unsigned int hash = (unsigned int)roll_number * 2654435769u;
+    return (int)(hash & (unsigned int)(index->capacity - 1));
+}
+
+/**
+ * Allocate a table with the given capacity and reinsert all entries
+ * @return true on success
+ */
+static bool resize_table(RollIndex *index, int new_capacity) {
+    int *old_keys = index->keys;
+    int *old_positions = index->positions;
+    int old_capacity = index->capacity;
+
+    index->keys = (int*)safe_malloc((size_t)new_capacity * sizeof(int));
+    index->positions = (int*)safe_malloc((size_t)new_capacity * sizeof(int));
+    if (!index->keys || !index->positions) {
+        free(index->keys);
+        free(index->positions);
+        index->keys = old_keys;
+        index->positions = old_positions;
+        return false;
+    }
+
+    memset(index->keys, 0, (size_t)new_capacity * sizeof(int));
+    index->capacity = new_capacity;
+    index->count = 0;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_keys[i] != 0) {
+            roll_index_put(index, old_keys[i], old_positions[i]);
+        }
+    }
+
+    free(old_keys);
+    free(old_positions);
+    return true;
+}
+
+/**
+ * Initialize an empty index (no allocation until the first insert)
+ * @param index Index to initialize
+ */
+void roll_index_init(RollIndex *index) {
+    if (!index) return;
+
+    index->keys = NULL;
+    index->positions = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
+
+/**
+ * Release the table
+ * @param index Index to free
+ */
+void roll_index_free(RollIndex *index) {
+    if (!index) return;
+
+    free(index->keys);
+    free(index->positions);
+    roll_index_init(index);
+}
+
+/**
+ * Remove all entries but keep the table
+ * @param index Index to clear
+ */
+void roll_index_clear(RollIndex *index) {
+    if (!index || !index->keys) return;
+
+    memset(index->keys, 0, (size_t)index->capacity * sizeof(int));
+    index->count = 0;
+}
+
+/**
+ * Insert or update the position for a roll number
+ * @param index Index to update
+ * @param roll_number Roll number (must be positive)
+ * @param position Position in the students array
+ * @return true on success
+ */
+bool roll_index_put(RollIndex *index, int roll_number, int position) {
+    if (!index || roll_number <= 0) return false;
+
+    if ((index->count + 1) * 2 > index->capacity) {
+        int new_capacity = index->capacity > 0 ? index->capacity * 2 : ROLL_INDEX_INITIAL_CAPACITY;
+        if (!resize_table(index, new_capacity)) {
+            return false;
+        }
+    }
+
+    int mask = index->capacity - 1;
+    int slot = home_slot(index, roll_number);
+    while (index->keys[slot] != 0) {
+        if (index->keys[slot] == roll_number) {
+            index->positions[slot] = position;
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    index->keys[slot] = roll_number;
+    index->positions[slot] = position;
+    index->count++;
+    return true;
+}
+
+/**
+ * Remove a roll number from the index
+ * @param index Index to update
+ * @param roll_number Roll number to remove
+ * @return true if it was present
+ */
+bool roll_index_remove(RollIndex *index, int roll_number) {
+    if (!index || !index->keys || roll_number <= 0) return false;
+
+    int mask = index->capacity - 1;
+    int slot = home_slot(index, roll_number);
+    while (index->keys[slot] != roll_number) {
+        if (index->keys[slot] == 0) {
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // Shift later members of the probe chain back into the hole
+    int hole = slot;
+    int next = (hole + 1) & mask;
+    while (index->keys[next] != 0) {
+        int home = home_slot(index, index->keys[next]);
+        bool movable = (hole <= next) ? (home <= hole || home > next)
+                                      : (home <= hole && home > next);
+        if (movable) {
+            index->keys[hole] = index->keys[next];
+            index->positions[hole] = index->positions[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    index->keys[hole] = 0;
+    index->count--;
+    return true;
+}
+
+/**
+ * Look up the position of a roll number
+ * @param index Index to query
+ * @param roll_number Roll number to find
+ * @return Position or -1 if not present
+ */
+int roll_index_get(const RollIndex *index, int roll_number) {
+    if (!index || !index->keys || roll_number <= 0) return -1;
+
+    int mask = index->capacity - 1;
+    int slot = home_slot(index, roll_number);
+    while (index->keys[slot] != 0) {
+        if (index->keys[slot] == roll_number) {
+            return index->positions[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
@@ -0,0 +1,497 @@
+/*
+ * File: src/server.c
+ * Path: SchoolRecordSystem/src/server.c
+ * Description: Resident query daemon over a Unix domain socket (epoll event loop)
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "server.h"
+#include "batch.h"
+#include "file_operations.h"
+#include "logger.h"
+#include "student.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#endif
+
+/**
+ * Fill a Unix socket address
+ * @return false if the path does not fit
+ */
+static bool make_address(const char *socket_path, struct sockaddr_un *address) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address->sun_path)) {
+        return false;
+    }
+    strcpy(address->sun_path, socket_path);
+    return true;
+}
+
+/**
+ * Connect to a running server
+ * @param socket_path Socket the server listens on
+ * @return Connected descriptor, or -1
+ */
+int server_connect(const char *socket_path) {
+    struct sockaddr_un address;
+    if (!socket_path || !make_address(socket_path, &address)) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+#ifdef __linux__
+
+typedef struct {
+    int fd;
+    char *input;                         // SERVER_INPUT_BUFFER bytes
+    size_t input_length;
+    bool discarding;                     // Skipping the rest of an overlong line
+    char *output;
+    size_t output_length;
+    size_t output_sent;
+    size_t output_capacity;
+    int line;                            // Requests received on this connection
+    bool closing;                        // Close once the output is sent
+    uint32_t events;                     // Current epoll interest
+} ServerClient;
+
+typedef struct {
+    StudentDatabase *db;
+    int epoll_fd;
+    int listen_fd;
+    int signal_fd;
+    ServerClient *clients[SERVER_MAX_CLIENTS];
+    int client_count;
+    long connections;
+    long requests;
+} Server;
+
+/* ============================================================================
+ * CONNECTIONS
+ * ============================================================================ */
+
+static void close_client(Server *server, ServerClient *client) {
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+
+    for (int i = 0; i < server->client_count; i++) {
+        if (server->clients[i] == client) {
+            server->clients[i] = server->clients[--server->client_count];
+            break;
+        }
+    }
+
+    LOG_DEBUG("Client %d disconnected after %d requests", client->fd, client->line);
+    free(client->input);
+    free(client->output);
+    free(client);
+}
+
+static void accept_clients(Server *server) {
+    for (;;) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOG_WARN("accept failed: %s", strerror(errno));
+            }
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+        if (server->client_count == SERVER_MAX_CLIENTS) {
+            LOG_WARN("Connection refused: %d clients already connected", SERVER_MAX_CLIENTS);
+            close(fd);
+            continue;
+        }
+
+        ServerClient *client = calloc(1, sizeof(ServerClient));
+        if (client) {
+            client->input = malloc(SERVER_INPUT_BUFFER);
+        }
+        if (!client || !client->input) {
+            LOG_ERROR("Memory allocation failed for a new connection");
+            if (client) free(client);
+            close(fd);
+            continue;
+        }
+
+        client->fd = fd;
+        client->events = EPOLLIN;
+        struct epoll_event event = {.events = client->events, .data.ptr = client};
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            LOG_ERROR("epoll_ctl failed: %s", strerror(errno));
+            free(client->input);
+            free(client);
+            close(fd);
+            continue;
+        }
+
+        server->clients[server->client_count++] = client;
+        server->connections++;
+        LOG_DEBUG("Client %d connected", fd);
+    }
+}
+
+static bool append_output(ServerClient *client, const char *data, size_t length) {
+    if (client->output_length + length > client->output_capacity) {
+        size_t capacity = client->output_capacity ? client->output_capacity : 4096;
+        while (capacity < client->output_length + length) {
+            capacity *= 2;
+        }
+        char *grown = realloc(client->output, capacity);
+        if (!grown) return false;
+        client->output = grown;
+        client->output_capacity = capacity;
+    }
+    memcpy(client->output + client->output_length, data, length);
+    client->output_length += length;
+    return true;
+}
+
+/**
+ * Send as much pending output as the socket takes
+ * @return false if the connection failed
+ */
+static bool flush_output(ServerClient *client) {
+    while (client->output_sent < client->output_length) {
+        ssize_t sent = send(client->fd, client->output + client->output_sent,
+                            client->output_length - client->output_sent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client->output_sent += (size_t)sent;
+    }
+    client->output_length = 0;
+    client->output_sent = 0;
+    return true;
+}
+
+/**
+ * Match the epoll interest to the connection state: stop reading while
+ * too much output is queued, watch writability while any is.
+ * @return false if the client was closed
+ */
+static bool update_interest(Server *server, ServerClient *client) {
+    size_t pending = client->output_length - client->output_sent;
+    if (client->closing && pending == 0) {
+        close_client(server, client);
+        return false;
+    }
+
+    uint32_t events = 0;
+    if (!client->closing && pending < SERVER_MAX_PENDING_OUTPUT) events |= EPOLLIN;
+    if (pending > 0) events |= EPOLLOUT;
+
+    if (events != client->events) {
+        struct epoll_event event = {.events = events, .data.ptr = client};
+        epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, client->fd, &event);
+        client->events = events;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * REQUESTS
+ * ============================================================================ */
+
+/**
+ * Run every complete request line in the input buffer. Results of the
+ * whole read are collected in one stream, so pipelined requests cost a
+ * single send.
+ * @param at_eof Treat a trailing partial line as complete
+ */
+static void process_input(Server *server, ServerClient *client, bool at_eof) {
+    char *results = NULL;
+    size_t results_length = 0;
+    FILE *out = open_memstream(&results, &results_length);
+    if (!out) {
+        LOG_ERROR("Cannot buffer results for client %d", client->fd);
+        client->closing = true;
+        return;
+    }
+
+    char *line = client->input;
+    char *end = client->input + client->input_length;
+    while (line < end && !client->closing) {
+        char *newline = memchr(line, '\n', (size_t)(end - line));
+        if (!newline && !at_eof) break;
+        char *line_end = newline ? newline : end;
+
+        size_t length = (size_t)(line_end - line);
+        if (length > 0 && line[length - 1] == '\r') length--;
+        line[length] = '\0';
+
+        if (client->discarding) {
+            client->discarding = false;
+        } else if (length >= BATCH_MAX_LINE) {
+            batch_report_overlong_line(++client->line, out);
+        } else {
+            bool quit = false;
+            batch_execute_line(server->db, line, ++client->line, out, &quit);
+            client->closing = quit;
+            server->requests++;
+        }
+        line = newline ? newline + 1 : end;
+    }
+
+    size_t remaining = client->closing ? 0 : (size_t)(end - line);
+    if (remaining >= BATCH_MAX_LINE && !client->discarding) {
+        batch_report_overlong_line(++client->line, out);
+        client->discarding = true;
+    }
+    if (client->discarding) {
+        remaining = 0;
+    }
+    memmove(client->input, line, remaining);
+    client->input_length = remaining;
+
+    fclose(out);
+    if (results_length > 0 && !append_output(client, results, results_length)) {
+        LOG_ERROR("Memory allocation failed for client %d results", client->fd);
+        client->closing = true;
+    }
+    free(results);
+}
+
+static void handle_readable(Server *server, ServerClient *client) {
+    ssize_t received = read(client->fd, client->input + client->input_length,
+                            SERVER_INPUT_BUFFER - client->input_length);
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+        client->output_length = client->output_sent = 0;
+        client->closing = true;
+        return;
+    }
+
+    if (received == 0) {
+        // Peer finished sending: answer what is left, then close
+        process_input(server, client, true);
+        client->closing = true;
+        return;
+    }
+
+    client->input_length += (size_t)received;
+    process_input(server, client, false);
+}
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+/**
+ * Bind the listening socket, replacing a stale socket file left by a
+ * server that did not shut down cleanly
+ * @return Listening descriptor, or -1
+ */
+static int open_listener(const char *socket_path) {
+    struct sockaddr_un address;
+    if (!make_address(socket_path, &address)) {
+        LOG_ERROR("Socket path too long: %s", socket_path);
+        return -1;
+    }
+
+    struct stat info;
+    if (lstat(socket_path, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            LOG_ERROR("%s exists and is not a socket", socket_path);
+            return -1;
+        }
+        int probe = server_connect(socket_path);
+        if (probe >= 0) {
+            close(probe);
+            LOG_ERROR("Another server is already listening on %s", socket_path);
+            return -1;
+        }
+        unlink(socket_path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_ERROR("socket failed: %s", strerror(errno));
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        LOG_ERROR("Cannot listen on %s: %s", socket_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    // Records are private to the owner
+    chmod(socket_path, 0600);
+    return fd;
+}
+
+static int open_signal_fd(void) {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    if (sigprocmask(SIG_BLOCK, &signals, NULL) != 0) {
+        return -1;
+    }
+    return signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+}
+
+static void serve(Server *server) {
+    struct epoll_event events[64];
+    bool running = true;
+
+    while (running) {
+        int ready = epoll_wait(server->epoll_fd, events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            void *source = events[i].data.ptr;
+            if (source == &server->listen_fd) {
+                accept_clients(server);
+                continue;
+            }
+            if (source == &server->signal_fd) {
+                running = false;
+                continue;
+            }
+
+            ServerClient *client = source;
+            if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) {
+                close_client(server, client);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                handle_readable(server, client);
+            }
+            if (!flush_output(client)) {
+                close_client(server, client);
+                continue;
+            }
+            update_interest(server, client);
+        }
+    }
+}
+
+/**
+ * Whether a data file holds anything besides its header line and blank
+ * lines, i.e. whether an empty load means the records could not be read
+ * @param filename Data file that exists
+ * @return true if it holds records or cannot be read at all
+ */
+static bool data_file_has_records(const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) return true;
+
+    char line[512];
+    bool first = true;
+    bool has_records = false;
+    while (!has_records && fgets(line, sizeof(line), file)) {
+        bool header = first && strstr(line, "Roll Number") != NULL;
+        first = false;
+        has_records = !header && line[strspn(line, " \t\r\n")] != '\0';
+    }
+    has_records = has_records || ferror(file);
+    fclose(file);
+    return has_records;
+}
+
+/**
+ * Keep the database resident and answer requests until SIGINT/SIGTERM.
+ * Unsaved changes are written back to 'data_file' on shutdown.
+ * @param socket_path Socket to listen on
+ * @param data_file Records to load at startup (may be NULL)
+ * @return EXIT_SUCCESS on a clean shutdown, EXIT_FAILURE if 'data_file'
+ *         exists but its records cannot be loaded
+ */
+int run_server(const char *socket_path, const char *data_file) {
+    Server server = {0};
+    server.epoll_fd = server.listen_fd = server.signal_fd = -1;
+
+    server.db = create_database();
+    if (!server.db) {
+        LOG_ERROR("Failed to create database");
+        return EXIT_FAILURE;
+    }
+    // Refuse to serve rather than save an empty database over unreadable records
+    if (data_file && file_exists(data_file) &&
+        !load_from_file(server.db, data_file) && data_file_has_records(data_file)) {
+        LOG_ERROR("Failed to load %s; not serving it", data_file);
+        destroy_database(server.db);
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_FAILURE;
+    server.listen_fd = open_listener(socket_path);
+    server.signal_fd = open_signal_fd();
+    server.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (server.listen_fd >= 0 && server.signal_fd >= 0 && server.epoll_fd >= 0) {
+        struct epoll_event listen_event = {.events = EPOLLIN, .data.ptr = &server.listen_fd};
+        struct epoll_event signal_event = {.events = EPOLLIN, .data.ptr = &server.signal_fd};
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listen_event);
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.signal_fd, &signal_event);
+
+        LOG_INFO("Serving %d students on %s", server.db->count, socket_path);
+        serve(&server);
+        LOG_INFO("Server stopping: %ld requests over %ld connections",
+                 server.requests, server.connections);
+        status = EXIT_SUCCESS;
+    } else {
+        LOG_ERROR("Server setup failed");
+    }
+
+    while (server.client_count > 0) {
+        close_client(&server, server.clients[0]);
+    }
+    if (server.listen_fd >= 0) {
+        close(server.listen_fd);
+        unlink(socket_path);
+    }
+    if (server.signal_fd >= 0) close(server.signal_fd);
+    if (server.epoll_fd >= 0) close(server.epoll_fd);
+
+    if (data_file && has_unsaved_changes(server.db)) {
+        save_to_file(server.db, data_file);
+    }
+    destroy_database(server.db);
+    return status;
+}
+
+#else
+
+int run_server(const char *socket_path, const char *data_file) {
+    (void)socket_path;
+    (void)data_file;
+    LOG_ERROR("Server mode needs epoll and is only available on Linux");
+    return EXIT_FAILURE;
+}
+
+#endif // __linux__
@@ -0,0 +1,531 @@
+/*
+ * File: src/simd_kernels.c
+ * Path: SchoolRecordSystem/src/simd_kernels.c
+ * Description: SSE2/AVX2 aggregate kernels with runtime dispatch and scalar fallback
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - The kernels operate on a plain float array (the database's marks column)
+ * - AVX2 code is compiled with target attributes, so no global -mavx2 is needed
+ * - Non-x86 builds only get the scalar versions
+ */
+
+#include "simd_kernels.h"
+#include <stddef.h>
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SRS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Active dispatch level, -1 until first use (readers may race to set it)
+static atomic_int g_active_level = -1;
+
+/* ============================================================================
+ * RUNTIME DISPATCH
+ * ============================================================================ */
+
+/**
+ * Detect the best instruction set supported by this CPU
+ * @return Highest usable SimdLevel
+ */
+SimdLevel simd_detect_level(void) {
+#ifdef SRS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_LEVEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SIMD_LEVEL_SSE2;
+    }
+#endif
+    return SIMD_LEVEL_SCALAR;
+}
+
+/**
+ * Get the level the kernels currently dispatch to
+ * @return Active SimdLevel
+ */
+SimdLevel simd_active_level(void) {
+    int level = atomic_load_explicit(&g_active_level, memory_order_relaxed);
+    if (level < 0) {
+        level = simd_detect_level();
+        atomic_store_explicit(&g_active_level, level, memory_order_relaxed);
+    }
+    return (SimdLevel)level;
+}
+
+/**
+ * Override the dispatch level (clamped to what the CPU supports).
+ * Used by benchmarks to compare implementations.
+ * @param level Requested level
+ */
+void simd_set_level(SimdLevel level) {
+    SimdLevel supported = simd_detect_level();
+    atomic_store(&g_active_level, (int)((level > supported) ? supported : level));
+}
+
+/**
+ * Get a printable name for a level
+ * @param level SimdLevel
+ * @return Level name
+ */
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_LEVEL_AVX2: return "avx2";
+        case SIMD_LEVEL_SSE2: return "sse2";
+        case SIMD_LEVEL_SCALAR:
+        default: return "scalar";
+    }
+}
+
+/* ============================================================================
+ * SCALAR IMPLEMENTATIONS
+ * ============================================================================ */
+
+/**
+ * Fold elements [start, n) into a reduction that already covers [0, start)
+ * @param marks Marks column
+ * @param start First index to fold
+ * @param n Number of elements
+ * @param thresholds Threshold values
+ * @param threshold_count Number of thresholds
+ * @param out Reduction to update
+ */
+static void scalar_reduce_tail(const float *marks, int start, int n, const float *thresholds,
+                               int threshold_count, MarksReduction *out) {
+    for (int i = start; i < n; i++) {
+        float value = marks[i];
+        out->sum += value;
+        out->sum_squares += (double)value * value;
+
+        if (out->min_index < 0 || value < out->min) {
+            out->min = value;
+            out->min_index = i;
+        }
+        if (out->max_index < 0 || value > out->max) {
+            out->max = value;
+            out->max_index = i;
+        }
+
+        for (int t = 0; t < threshold_count; t++) {
+            out->threshold_counts[t] += (value >= thresholds[t]);
+        }
+    }
+}
+
+/**
+ * Classify elements [start, n) by the number of thresholds they miss
+ */
+static void scalar_classify_tail(const float *marks, int start, int n, const float *thresholds,
+                                 int threshold_count, uint8_t *out) {
+    for (int i = start; i < n; i++) {
+        int met = 0;
+        for (int t = 0; t < threshold_count; t++) {
+            met += (marks[i] >= thresholds[t]);
+        }
+        out[i] = (uint8_t)(threshold_count - met);
+    }
+}
+
+/**
+ * Merge per-lane min/max candidates, preferring the lowest index on ties
+ * @param values Lane values
+ * @param indices Lane indices
+ * @param lanes Number of lanes
+ * @param want_max true to pick the maximum, false for the minimum
+ * @param best_value Output value
+ * @param best_index Output index
+ */
+static void merge_lanes(const float *values, const int32_t *indices, int lanes, bool want_max,
+                        float *best_value, int *best_index) {
+    float value = values[0];
+    int index = indices[0];
+    for (int l = 1; l < lanes; l++) {
+        bool better = want_max ? (values[l] > value) : (values[l] < value);
+        if (better || (values[l] == value && indices[l] < index)) {
+            value = values[l];
+            index = indices[l];
+        }
+    }
+    *best_value = value;
+    *best_index = index;
+}
+
+#ifdef SRS_X86_KERNELS
+
+/* ============================================================================
+ * SSE2 IMPLEMENTATIONS
+ * ============================================================================ */
+
+/**
+ * SSE2 fused reduction: 4 floats per iteration
+ * @return Number of elements processed (multiple of 4)
+ */
+__attribute__((target("sse2")))
+static int sse2_reduce(const float *marks, int n, const float *thresholds,
+                       int threshold_count, MarksReduction *out) {
+    int vector_end = n & ~3;
+    if (vector_end == 0) {
+        return 0;
+    }
+
+    __m128d sum_lo = _mm_setzero_pd();
+    __m128d sum_hi = _mm_setzero_pd();
+    __m128d sq_lo = _mm_setzero_pd();
+    __m128d sq_hi = _mm_setzero_pd();
+    __m128 vmin = _mm_set1_ps(marks[0]);
+    __m128 vmax = vmin;
+    __m128i min_idx = _mm_setzero_si128();
+    __m128i max_idx = _mm_setzero_si128();
+    __m128i cursor = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+
+    __m128 vthreshold[MAX_KERNEL_THRESHOLDS];
+    __m128i vcount[MAX_KERNEL_THRESHOLDS];
+    for (int t = 0; t < threshold_count; t++) {
+        vthreshold[t] = _mm_set1_ps(thresholds[t]);
+        vcount[t] = _mm_setzero_si128();
+    }
+
+    for (int i = 0; i < vector_end; i += 4) {
+        __m128 v = _mm_loadu_ps(marks + i);
+
+        __m128d lo = _mm_cvtps_pd(v);
+        __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        sum_lo = _mm_add_pd(sum_lo, lo);
+        sum_hi = _mm_add_pd(sum_hi, hi);
+        sq_lo = _mm_add_pd(sq_lo, _mm_mul_pd(lo, lo));
+        sq_hi = _mm_add_pd(sq_hi, _mm_mul_pd(hi, hi));
+
+        // Strict comparisons keep the first occurrence in every lane
+        __m128 lt = _mm_cmplt_ps(v, vmin);
+        vmin = _mm_or_ps(_mm_and_ps(lt, v), _mm_andnot_ps(lt, vmin));
+        min_idx = _mm_or_si128(_mm_and_si128(_mm_castps_si128(lt), cursor),
+                               _mm_andnot_si128(_mm_castps_si128(lt), min_idx));
+
+        __m128 gt = _mm_cmpgt_ps(v, vmax);
+        vmax = _mm_or_ps(_mm_and_ps(gt, v), _mm_andnot_ps(gt, vmax));
+        max_idx = _mm_or_si128(_mm_and_si128(_mm_castps_si128(gt), cursor),
+                               _mm_andnot_si128(_mm_castps_si128(gt), max_idx));
+
+        // Comparison masks are all-ones (-1), so subtracting counts hits
+        for (int t = 0; t < threshold_count; t++) {
+            vcount[t] = _mm_sub_epi32(vcount[t], _mm_castps_si128(_mm_cmpge_ps(v, vthreshold[t])));
+        }
+
+        cursor = _mm_add_epi32(cursor, step);
+    }
+
+    double sums[2], squares[2];
+    _mm_storeu_pd(sums, _mm_add_pd(sum_lo, sum_hi));
+    _mm_storeu_pd(squares, _mm_add_pd(sq_lo, sq_hi));
+    out->sum = sums[0] + sums[1];
+    out->sum_squares = squares[0] + squares[1];
+
+    float lane_values[4];
+    int32_t lane_indices[4];
+    _mm_storeu_ps(lane_values, vmin);
+    _mm_storeu_si128((__m128i*)lane_indices, min_idx);
+    merge_lanes(lane_values, lane_indices, 4, false, &out->min, &out->min_index);
+    _mm_storeu_ps(lane_values, vmax);
+    _mm_storeu_si128((__m128i*)lane_indices, max_idx);
+    merge_lanes(lane_values, lane_indices, 4, true, &out->max, &out->max_index);
+
+    for (int t = 0; t < threshold_count; t++) {
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, vcount[t]);
+        out->threshold_counts[t] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    return vector_end;
+}
+
+/**
+ * SSE2 classification: 16 floats per iteration packed into 16 bytes
+ * @return Number of elements processed (multiple of 16)
+ */
+__attribute__((target("sse2")))
+static int sse2_classify(const float *marks, int n, const float *thresholds,
+                         int threshold_count, uint8_t *out) {
+    int vector_end = n & ~15;
+    const __m128i base = _mm_set1_epi32(threshold_count);
+
+    __m128 vthreshold[MAX_KERNEL_THRESHOLDS];
+    for (int t = 0; t < threshold_count; t++) {
+        vthreshold[t] = _mm_set1_ps(thresholds[t]);
+    }
+
+    for (int i = 0; i < vector_end; i += 16) {
+        __m128i buckets[4];
+        for (int part = 0; part < 4; part++) {
+            __m128 v = _mm_loadu_ps(marks + i + part * 4);
+            __m128i bucket = base;
+            for (int t = 0; t < threshold_count; t++) {
+                bucket = _mm_add_epi32(bucket, _mm_castps_si128(_mm_cmpge_ps(v, vthreshold[t])));
+            }
+            buckets[part] = bucket;
+        }
+
+        __m128i low = _mm_packs_epi32(buckets[0], buckets[1]);
+        __m128i high = _mm_packs_epi32(buckets[2], buckets[3]);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(low, high));
+    }
+
+    return vector_end;
+}
+
+/* ============================================================================
+ * AVX2 IMPLEMENTATIONS
+ * ============================================================================ */
+
+/**
+ * AVX2 fused reduction: 8 floats per iteration
+ * @return Number of elements processed (multiple of 8)
+ */
+__attribute__((target("avx2")))
+static int avx2_reduce(const float *marks, int n, const float *thresholds,
+                       int threshold_count, MarksReduction *out) {
+    int vector_end = n & ~7;
+    if (vector_end == 0) {
+        return 0;
+    }
+
+    __m256d sum_lo = _mm256_setzero_pd();
+    __m256d sum_hi = _mm256_setzero_pd();
+    __m256d sq_lo = _mm256_setzero_pd();
+    __m256d sq_hi = _mm256_setzero_pd();
+    __m256 vmin = _mm256_set1_ps(marks[0]);
+    __m256 vmax = vmin;
+    __m256i min_idx = _mm256_setzero_si256();
+    __m256i max_idx = _mm256_setzero_si256();
+    __m256i cursor = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    __m256 vthreshold[MAX_KERNEL_THRESHOLDS];
+    __m256i vcount[MAX_KERNEL_THRESHOLDS];
+    for (int t = 0; t < threshold_count; t++) {
+        vthreshold[t] = _mm256_set1_ps(thresholds[t]);
+        vcount[t] = _mm256_setzero_si256();
+    }
+
+    for (int i = 0; i < vector_end; i += 8) {
+        __m256 v = _mm256_loadu_ps(marks + i);
+
+        __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        sum_lo = _mm256_add_pd(sum_lo, lo);
+        sum_hi = _mm256_add_pd(sum_hi, hi);
+        sq_lo = _mm256_add_pd(sq_lo, _mm256_mul_pd(lo, lo));
+        sq_hi = _mm256_add_pd(sq_hi, _mm256_mul_pd(hi, hi));
+
+        __m256 lt = _mm256_cmp_ps(v, vmin, _CMP_LT_OQ);
+        vmin = _mm256_blendv_ps(vmin, v, lt);
+        min_idx = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(min_idx),
+                                                       _mm256_castsi256_ps(cursor), lt));
+
+        __m256 gt = _mm256_cmp_ps(v, vmax, _CMP_GT_OQ);
+        vmax = _mm256_blendv_ps(vmax, v, gt);
+        max_idx = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(max_idx),
+                                                       _mm256_castsi256_ps(cursor), gt));
+
+        for (int t = 0; t < threshold_count; t++) {
+            __m256 ge = _mm256_cmp_ps(v, vthreshold[t], _CMP_GE_OQ);
+            vcount[t] = _mm256_sub_epi32(vcount[t], _mm256_castps_si256(ge));
+        }
+
+        cursor = _mm256_add_epi32(cursor, step);
+    }
+
+    double sums[4], squares[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sum_lo, sum_hi));
+    _mm256_storeu_pd(squares, _mm256_add_pd(sq_lo, sq_hi));
+    out->sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    out->sum_squares = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+
+    float lane_values[8];
+    int32_t lane_indices[8];
+    _mm256_storeu_ps(lane_values, vmin);
+    _mm256_storeu_si256((__m256i*)lane_indices, min_idx);
+    merge_lanes(lane_values, lane_indices, 8, false, &out->min, &out->min_index);
+    _mm256_storeu_ps(lane_values, vmax);
+    _mm256_storeu_si256((__m256i*)lane_indices, max_idx);
+    merge_lanes(lane_values, lane_indices, 8, true, &out->max, &out->max_index);
+
+    for (int t = 0; t < threshold_count; t++) {
+        int32_t lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, vcount[t]);
+        int total = 0;
+        for (int l = 0; l < 8; l++) {
+            total += lanes[l];
+        }
+        out->threshold_counts[t] = total;
+    }
+
+    return vector_end;
+}
+
+/**
+ * AVX2 classification: 32 floats per iteration packed into 32 bytes
+ * @return Number of elements processed (multiple of 32)
+ */
+__attribute__((target("avx2")))
+static int avx2_classify(const float *marks, int n, const float *thresholds,
+                         int threshold_count, uint8_t *out) {
+    int vector_end = n & ~31;
+    const __m256i base = _mm256_set1_epi32(threshold_count);
+    // Packing works per 128-bit lane; this restores element order
+    const __m256i lane_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    __m256 vthreshold[MAX_KERNEL_THRESHOLDS];
+    for (int t = 0; t < threshold_count; t++) {
+        vthreshold[t] = _mm256_set1_ps(thresholds[t]);
+    }
+
+    for (int i = 0; i < vector_end; i += 32) {
+        __m256i buckets[4];
+        for (int part = 0; part < 4; part++) {
+            __m256 v = _mm256_loadu_ps(marks + i + part * 8);
+            __m256i bucket = base;
+            for (int t = 0; t < threshold_count; t++) {
+                __m256 ge = _mm256_cmp_ps(v, vthreshold[t], _CMP_GE_OQ);
+                bucket = _mm256_add_epi32(bucket, _mm256_castps_si256(ge));
+            }
+            buckets[part] = bucket;
+        }
+
+        __m256i low = _mm256_packs_epi32(buckets[0], buckets[1]);
+        __m256i high = _mm256_packs_epi32(buckets[2], buckets[3]);
+        __m256i bytes = _mm256_packus_epi16(low, high);
+        bytes = _mm256_permutevar8x32_epi32(bytes, lane_order);
+        _mm256_storeu_si256((__m256i*)(out + i), bytes);
+    }
+
+    return vector_end;
+}
+
+#endif // SRS_X86_KERNELS
+
+/* ============================================================================
+ * PUBLIC KERNEL ENTRY POINTS
+ * ============================================================================ */
+
+/**
+ * Fused reduction over a marks column: sum, sum of squares, min/max with
+ * first indices and the number of elements at or above each threshold
+ * @param marks Marks column
+ * @param n Number of elements
+ * @param thresholds Threshold values (may be NULL if threshold_count is 0)
+ * @param threshold_count Number of thresholds (<= MAX_KERNEL_THRESHOLDS)
+ * @param out Reduction result
+ */
+void marks_reduce(const float *marks, int n, const float *thresholds,
+                  int threshold_count, MarksReduction *out) {
+    if (!out) return;
+
+    *out = (MarksReduction){0};
+    out->min_index = -1;
+    out->max_index = -1;
+
+    if (!marks || n <= 0) return;
+    if (threshold_count < 0) threshold_count = 0;
+    if (threshold_count > MAX_KERNEL_THRESHOLDS) threshold_count = MAX_KERNEL_THRESHOLDS;
+
+    out->count = n;
+    int done = 0;
+
+#ifdef SRS_X86_KERNELS
+    switch (simd_active_level()) {
+        case SIMD_LEVEL_AVX2:
+            done = avx2_reduce(marks, n, thresholds, threshold_count, out);
+            break;
+        case SIMD_LEVEL_SSE2:
+            done = sse2_reduce(marks, n, thresholds, threshold_count, out);
+            break;
+        default:
+            break;
+    }
+#endif
+
+    scalar_reduce_tail(marks, done, n, thresholds, threshold_count, out);
+}
+
+/**
+ * Classify every element by how many descending thresholds it misses.
+ * With grade thresholds {A, B, C, D, E} this yields 0 = A ... 5 = F.
+ * @param marks Marks column
+ * @param n Number of elements
+ * @param thresholds Thresholds in descending order
+ * @param threshold_count Number of thresholds (<= MAX_KERNEL_THRESHOLDS)
+ * @param out Output bucket per element
+ */
+void marks_classify(const float *marks, int n, const float *thresholds,
+                    int threshold_count, uint8_t *out) {
+    if (!marks || !out || n <= 0) return;
+    if (threshold_count < 0) threshold_count = 0;
+    if (threshold_count > MAX_KERNEL_THRESHOLDS) threshold_count = MAX_KERNEL_THRESHOLDS;
+
+    int done = 0;
+
+#ifdef SRS_X86_KERNELS
+    switch (simd_active_level()) {
+        case SIMD_LEVEL_AVX2:
+            done = avx2_classify(marks, n, thresholds, threshold_count, out);
+            break;
+        case SIMD_LEVEL_SSE2:
+            done = sse2_classify(marks, n, thresholds, threshold_count, out);
+            break;
+        default:
+            break;
+    }
+#endif
+
+    scalar_classify_tail(marks, done, n, thresholds, threshold_count, out);
+}
+
+/**
+ * Sum of a marks column (accumulated in double precision)
+ * @param marks Marks column
+ * @param n Number of elements
+ * @return Sum
+ */
+double marks_sum(const float *marks, int n) {
+    MarksReduction reduction;
+    marks_reduce(marks, n, NULL, 0, &reduction);
+    return reduction.sum;
+}
+
+/**
+ * Count elements at or above a threshold (e.g. PASSING_MARKS)
+ * @param marks Marks column
+ * @param n Number of elements
+ * @param threshold Threshold value
+ * @return Number of elements >= threshold
+ */
+int marks_count_at_least(const float *marks, int n, float threshold) {
+    MarksReduction reduction;
+    marks_reduce(marks, n, &threshold, 1, &reduction);
+    return reduction.threshold_counts[0];
+}
+
+/**
+ * Count elements at or above each of several thresholds in one pass
+ * @param marks Marks column
+ * @param n Number of elements
+ * @param thresholds Threshold values
+ * @param threshold_count Number of thresholds
+ * @param counts Output counts, one per threshold
+ */
+void marks_threshold_counts(const float *marks, int n, const float *thresholds,
+                            int threshold_count, int *counts) {
+    if (!counts) return;
+
+    MarksReduction reduction;
+    marks_reduce(marks, n, thresholds, threshold_count, &reduction);
+    for (int t = 0; t < threshold_count && t < MAX_KERNEL_THRESHOLDS; t++) {
+        counts[t] = reduction.threshold_counts[t];
+    }
+}
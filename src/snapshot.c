@@ -0,0 +1,218 @@
+/*
+ * File: src/snapshot.c
+ * Path: SchoolRecordSystem/src/snapshot.c
+ * Description: Copy-on-write chunk store behind point-in-time views of a record array
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Opening a snapshot only links it into the list and bumps the version
+ * - A chunk whose version is current has been saved for every open
+ *   snapshot already, so repeated writes to it cost one comparison
+ * - Saved chunks are reference counted: snapshots opened between two
+ *   changes to a chunk share one copy of it
+ */
+
+#include "snapshot.h"
+#include "memory_manager.h"
+
+/**
+ * Number of chunks covering a record count
+ */
+static int chunks_for(int record_count) {
+    return (record_count + SNAPSHOT_CHUNK_RECORDS - 1) / SNAPSHOT_CHUNK_RECORDS;
+}
+
+static void release_chunk(SnapshotStore *store, SnapshotChunk *chunk) {
+    if (--chunk->references == 0) {
+        free(chunk);
+        store->saved_chunks--;
+    }
+}
+
+/**
+ * Grow the per-chunk version table; new chunks start at version 0,
+ * which no open snapshot has
+ */
+static void ensure_chunk_versions(SnapshotStore *store, int chunk_count) {
+    if (chunk_count <= store->chunk_capacity) return;
+
+    int new_capacity = store->chunk_capacity > 0 ? store->chunk_capacity : 16;
+    while (new_capacity < chunk_count) {
+        new_capacity *= 2;
+    }
+    store->chunk_versions = (uint64_t*)safe_realloc(store->chunk_versions,
+                                                    (size_t)new_capacity * sizeof(uint64_t));
+    memset(store->chunk_versions + store->chunk_capacity, 0,
+           (size_t)(new_capacity - store->chunk_capacity) * sizeof(uint64_t));
+    store->chunk_capacity = new_capacity;
+}
+
+/**
+ * Copy of the live records of one chunk (the tail past record_count is
+ * left unset; no snapshot that reads this chunk extends into it)
+ */
+static SnapshotChunk* copy_chunk(SnapshotStore *store, const void *records, int record_count,
+                                 int chunk) {
+    size_t chunk_bytes = SNAPSHOT_CHUNK_RECORDS * store->record_size;
+    SnapshotChunk *copy = (SnapshotChunk*)safe_malloc(sizeof(SnapshotChunk) + chunk_bytes);
+
+    int first = chunk * SNAPSHOT_CHUNK_RECORDS;
+    int available = record_count - first;
+    if (available > SNAPSHOT_CHUNK_RECORDS) available = SNAPSHOT_CHUNK_RECORDS;
+    if (available > 0) {
+        memcpy(copy->records, (const unsigned char*)records + (size_t)first * store->record_size,
+               (size_t)available * store->record_size);
+    }
+
+    copy->references = 0;
+    store->saved_chunks++;
+    return copy;
+}
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+void snapshot_store_init(SnapshotStore *store, size_t record_size) {
+    store->oldest = NULL;
+    store->newest = NULL;
+    store->record_size = record_size;
+    store->version = 0;
+    store->chunk_versions = NULL;
+    store->chunk_capacity = 0;
+    store->saved_chunks = 0;
+    pthread_mutex_init(&store->lock, NULL);
+}
+
+/**
+ * Free the store, closing any snapshot its owner left open
+ */
+void snapshot_store_free(SnapshotStore *store) {
+    while (store->oldest) {
+        snapshot_store_close(store, store->oldest);
+    }
+    free(store->chunk_versions);
+    store->chunk_versions = NULL;
+    store->chunk_capacity = 0;
+    pthread_mutex_destroy(&store->lock);
+}
+
+/* ============================================================================
+ * SNAPSHOTS
+ * ============================================================================ */
+
+/**
+ * Open a view of the first record_count records as they are now
+ * @param store Chunk store of the array
+ * @param record_count Records currently in the array
+ * @return New snapshot (close with snapshot_store_close)
+ */
+Snapshot* snapshot_store_open(SnapshotStore *store, int record_count) {
+    Snapshot *snapshot = (Snapshot*)safe_malloc(sizeof(Snapshot));
+    snapshot->count = record_count;
+    snapshot->saved = NULL;
+    snapshot->saved_capacity = 0;
+    snapshot->newer = NULL;
+
+    pthread_mutex_lock(&store->lock);
+    snapshot->older = store->newest;
+    if (store->newest) {
+        store->newest->newer = snapshot;
+    } else {
+        store->oldest = snapshot;
+    }
+    store->newest = snapshot;
+
+    // Every chunk now predates the newest snapshot
+    store->version++;
+    pthread_mutex_unlock(&store->lock);
+
+    return snapshot;
+}
+
+/**
+ * Close a snapshot, freeing the chunk copies no other snapshot shares
+ * @param store Chunk store the snapshot came from
+ * @param snapshot Snapshot to close (may be NULL)
+ */
+void snapshot_store_close(SnapshotStore *store, Snapshot *snapshot) {
+    if (!snapshot) return;
+
+    pthread_mutex_lock(&store->lock);
+    if (snapshot->older) {
+        snapshot->older->newer = snapshot->newer;
+    } else {
+        store->oldest = snapshot->newer;
+    }
+    if (snapshot->newer) {
+        snapshot->newer->older = snapshot->older;
+    } else {
+        store->newest = snapshot->older;
+    }
+
+    for (int i = 0; i < snapshot->saved_capacity; i++) {
+        if (snapshot->saved[i]) {
+            release_chunk(store, snapshot->saved[i]);
+        }
+    }
+    pthread_mutex_unlock(&store->lock);
+
+    free(snapshot->saved);
+    free(snapshot);
+}
+
+/**
+ * Save the chunks holding records [first, first + count) for every open
+ * snapshot that still reads them from the live array. Call before the
+ * records change.
+ * @param store Chunk store of the array
+ * @param records The live array
+ * @param record_count Records currently in the array
+ * @param first First record about to change
+ * @param count Number of records about to change
+ */
+void snapshot_store_preserve(SnapshotStore *store, const void *records, int record_count,
+                             int first, int count) {
+    if (count <= 0 || first < 0) return;
+
+    pthread_mutex_lock(&store->lock);
+    if (!store->oldest) {
+        pthread_mutex_unlock(&store->lock);
+        return;
+    }
+
+    int first_chunk = first / SNAPSHOT_CHUNK_RECORDS;
+    int last_chunk = (first + count - 1) / SNAPSHOT_CHUNK_RECORDS;
+    ensure_chunk_versions(store, last_chunk + 1);
+
+    for (int chunk = first_chunk; chunk <= last_chunk; chunk++) {
+        if (store->chunk_versions[chunk] == store->version) continue;
+        store->chunk_versions[chunk] = store->version;
+
+        SnapshotChunk *copy = NULL;
+        for (Snapshot *snapshot = store->oldest; snapshot; snapshot = snapshot->newer) {
+            if (chunk >= chunks_for(snapshot->count)) continue;
+            if (snapshot->saved && snapshot->saved[chunk]) continue;
+
+            if (!snapshot->saved) {
+                snapshot->saved_capacity = chunks_for(snapshot->count);
+                snapshot->saved = (SnapshotChunk**)safe_malloc(
+                    (size_t)snapshot->saved_capacity * sizeof(SnapshotChunk*));
+                memset(snapshot->saved, 0, (size_t)snapshot->saved_capacity * sizeof(SnapshotChunk*));
+            }
+            if (!copy) {
+                copy = copy_chunk(store, records, record_count, chunk);
+            }
+            snapshot->saved[chunk] = copy;
+            copy->references++;
+        }
+    }
+    pthread_mutex_unlock(&store->lock);
+}
+
+const void* snapshot_saved_chunk(const Snapshot *snapshot, int chunk) {
+    if (!snapshot->saved || chunk >= snapshot->saved_capacity) return NULL;
+    return snapshot->saved[chunk] ? snapshot->saved[chunk]->records : NULL;
+}
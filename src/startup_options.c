@@ -0,0 +1,77 @@
+/*
+ * File: src/startup_options.c
+ * Path: SchoolRecordSystem/src/startup_options.c
+ * Description: Command-line options shared by the GUI and headless front ends
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "startup_options.h"
+#include "grading.h"
+#include "logger.h"
+#include "student.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Take a shared option and its value from the command line
+ * @param options Options to fill
+ * @param argc Argument count
+ * @param argv Arguments
+ * @param index Position of the option; advanced past its value when taken
+ * @return true if the argument was a shared option
+ */
+bool parse_startup_option(StartupOptions *options, int argc, char *argv[], int *index) {
+    int i = *index;
+    if (i + 1 >= argc) return false;
+
+    if (strcmp(argv[i], "--log-level") == 0) {
+        options->log_level = argv[i + 1];
+    } else if (strcmp(argv[i], "--grades") == 0) {
+        options->grade_boundaries = argv[i + 1];
+    } else {
+        return false;
+    }
+    *index = i + 1;
+    return true;
+}
+
+/**
+ * Start the logger at the requested level and install the grading
+ * scheme. Call before any database exists: aggregates and indexes keep
+ * the grades they were built with.
+ * @param options Parsed options
+ * @return false (after printing why) if a value is invalid
+ */
+bool apply_startup_options(const StartupOptions *options) {
+    log_init();
+    if (options->log_level) {
+        LogLevel level;
+        if (!log_level_from_string(options->log_level, &level)) {
+            printf("Unknown log level: %s\n", options->log_level);
+            printf("Use --help for usage information.\n");
+            return false;
+        }
+        log_set_level(level);
+    }
+
+    if (options->grade_boundaries) {
+        float minimums[GRADE_BOUNDARY_COUNT];
+        if (!grading_boundaries_from_string(options->grade_boundaries, minimums) ||
+            !set_grading_scheme(minimums)) {
+            printf("Invalid grade boundaries: %s (five descending marks ending at the pass mark %.0f,"
+                   " e.g. 90,80,70,60,40)\n", options->grade_boundaries, PASSING_MARKS);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Help lines for the shared options, in the front ends' --help layout
+void print_startup_options_help(void) {
+    printf("  --log-level L  Diagnostics to show: trace, debug, info, warn, error, off\n");
+    printf("                 (default: info, or $%s)\n", LOG_LEVEL_ENV);
+    printf("  --grades LIST  Lowest marks for A,B,C,D,E (default: 90,80,70,60,40);\n");
+    printf("                 E is the pass mark and must stay %.0f\n", PASSING_MARKS);
+}
@@ -9,6 +9,8 @@
 
 #include "student.h"
 #include "memory_manager.h"
+#include "logger.h"
+#include <stddef.h>
 
 /* ============================================================================
  * DATABASE MANAGEMENT FUNCTIONS
@@ -30,12 +32,36 @@ StudentDatabase* create_database(void) {
         return NULL;
     }
 
+    db->marks_column = (float*)safe_malloc(INITIAL_CAPACITY * sizeof(float));
+    if (!db->marks_column) {
+        free(db->students);
+        free(db);
+        return NULL;
+    }
+
     // Initialize database properties
     db->count = 0;
     db->capacity = INITIAL_CAPACITY;
     db->has_unsaved_changes = false;
     strcpy(db->last_saved_file, "");
 
+    // Derived state starts empty and grows with the data
+    memset(&db->aggregates, 0, sizeof(db->aggregates));
+    rank_tree_init(&db->marks_tree);
+    rank_tree_init(&db->gpa_tree);
+    roll_index_init(&db->roll_index);
+    bitmap_index_init(&db->bitmap_index);
+    name_index_init(&db->name_index);
+    trigram_index_init(&db->trigram_index);
+    db->observer_count = 0;
+    db->batch_depth = 0;
+    db->batch_changed = false;
+    pthread_rwlock_init(&db->lock, NULL);
+    pthread_mutex_init(&db->writer_turnstile, NULL);
+    pthread_mutex_init(&db->search_lock, NULL);
+    snapshot_store_init(&db->snapshots, sizeof(Student));
+    course_stats_cache_init(&db->course_stats);
+
     // Initialize all student records as inactive
     for (int i = 0; i < INITIAL_CAPACITY; i++) {
         db->students[i].is_active = false;
@@ -47,7 +73,7 @@ StudentDatabase* create_database(void) {
         }
     }
 
-    printf("Database created successfully with capacity: %d\n", INITIAL_CAPACITY);
+    LOG_DEBUG("Database created successfully with capacity: %d", INITIAL_CAPACITY);
     return db;
 }
 
@@ -58,15 +84,400 @@ StudentDatabase* create_database(void) {
 void destroy_database(StudentDatabase *db) {
     if (db) {
         if (db->students) {
-            printf("Freeing memory for %d students\n", db->count);
+            LOG_DEBUG("Freeing memory for %d students", db->count);
             free(db->students);
             db->students = NULL;
         }
+        if (db->marks_column) {
+            free(db->marks_column);
+            db->marks_column = NULL;
+        }
+        rank_tree_free(&db->marks_tree);
+        rank_tree_free(&db->gpa_tree);
+        roll_index_free(&db->roll_index);
+        bitmap_index_free(&db->bitmap_index);
+        name_index_free(&db->name_index);
+        trigram_index_free(&db->trigram_index);
+        pthread_rwlock_destroy(&db->lock);
+        pthread_mutex_destroy(&db->writer_turnstile);
+        pthread_mutex_destroy(&db->search_lock);
+        snapshot_store_free(&db->snapshots);
+        course_stats_cache_free(&db->course_stats);
         free(db);
-        printf("Database destroyed successfully\n");
+        LOG_DEBUG("Database destroyed successfully");
+    }
+}
+
+/* ============================================================================
+ * THREAD SAFETY
+ * ============================================================================ */
+
+/**
+ * Take the shared lock for queries. Readers pass through the writer
+ * turnstile first, so a steady stream of readers cannot starve a writer.
+ * @param db Student database
+ */
+void read_lock_database(StudentDatabase *db) {
+    pthread_mutex_lock(&db->writer_turnstile);
+    pthread_mutex_unlock(&db->writer_turnstile);
+    pthread_rwlock_rdlock(&db->lock);
+}
+
+void read_unlock_database(StudentDatabase *db) {
+    pthread_rwlock_unlock(&db->lock);
+}
+
+/**
+ * Take the exclusive lock for changes. The writer holds the turnstile
+ * until it unlocks, so new readers wait while current ones drain.
+ * @param db Student database
+ */
+void write_lock_database(StudentDatabase *db) {
+    pthread_mutex_lock(&db->writer_turnstile);
+    pthread_rwlock_wrlock(&db->lock);
+}
+
+void write_unlock_database(StudentDatabase *db) {
+    pthread_rwlock_unlock(&db->lock);
+    pthread_mutex_unlock(&db->writer_turnstile);
+}
+
+/* ============================================================================
+ * SNAPSHOTS
+ * ============================================================================ */
+
+/**
+ * Open a point-in-time view of the records. Only the snapshot list is
+ * touched; chunks are copied later, by the writers that change them.
+ * @param db Student database
+ * @return Snapshot to read with read_student_snapshot(), or NULL
+ */
+Snapshot* open_student_snapshot(StudentDatabase *db) {
+    if (!db) return NULL;
+
+    read_lock_database(db);
+    Snapshot *snapshot = snapshot_store_open(&db->snapshots, db->count);
+    read_unlock_database(db);
+    return snapshot;
+}
+
+void close_student_snapshot(StudentDatabase *db, Snapshot *snapshot) {
+    if (!db || !snapshot) return;
+    snapshot_store_close(&db->snapshots, snapshot);
+}
+
+/**
+ * Copy records out of a snapshot. The read lock is held only for this
+ * call, so read a chunk or so at a time to let writers in between.
+ * @param db Database the snapshot was opened on
+ * @param snapshot Open snapshot
+ * @param first Position of the first record to copy
+ * @param records Receives the records
+ * @param max_records Capacity of records
+ * @return Number of records copied (0 past the end of the snapshot)
+ */
+int read_student_snapshot(StudentDatabase *db, const Snapshot *snapshot, int first,
+                          Student *records, int max_records) {
+    if (!db || !snapshot || !records || first < 0) return 0;
+
+    int wanted = snapshot->count - first;
+    if (wanted > max_records) wanted = max_records;
+    if (wanted <= 0) return 0;
+
+    read_lock_database(db);
+    int copied = 0;
+    while (copied < wanted) {
+        int position = first + copied;
+        int offset = position % SNAPSHOT_CHUNK_RECORDS;
+        int run = SNAPSHOT_CHUNK_RECORDS - offset;
+        if (run > wanted - copied) run = wanted - copied;
+
+        // Unsaved chunks have not changed since the snapshot was opened
+        const Student *saved = snapshot_saved_chunk(snapshot, position / SNAPSHOT_CHUNK_RECORDS);
+        const Student *source = saved ? saved + offset : &db->students[position];
+        memcpy(records + copied, source, (size_t)run * sizeof(Student));
+        copied += run;
+    }
+    read_unlock_database(db);
+    return copied;
+}
+
+/**
+ * Call a function for every record of a snapshot in position order,
+ * copying a chunk at a time so writers can get in between chunks
+ * @param db Database the snapshot was opened on
+ * @param snapshot Open snapshot
+ * @param visit Called with each record; returning false stops the walk
+ * @param context Passed to visit
+ * @return false if visit stopped the walk
+ */
+bool visit_student_snapshot(StudentDatabase *db, const Snapshot *snapshot,
+                            StudentVisitFunc visit, void *context) {
+    if (!db || !snapshot || !visit) return false;
+
+    Student *chunk = (Student*)safe_malloc(SNAPSHOT_CHUNK_RECORDS * sizeof(Student));
+    bool completed = true;
+    int position = 0;
+    int copied;
+    while (completed &&
+           (copied = read_student_snapshot(db, snapshot, position, chunk, SNAPSHOT_CHUNK_RECORDS)) > 0) {
+        for (int i = 0; i < copied && completed; i++) {
+            completed = visit(&chunk[i], position + i, context);
+        }
+        position += copied;
+    }
+
+    free(chunk);
+    return completed;
+}
+
+/**
+ * Let open snapshots keep the current contents of students
+ * [first, first + count) before they change in place, and mark the
+ * course breakdowns out of date
+ * @param db Student database (write lock held)
+ * @param first First position about to change
+ * @param count Number of positions about to change
+ */
+void preserve_student_records(StudentDatabase *db, int first, int count) {
+    snapshot_store_preserve(&db->snapshots, db->students, db->count, first, count);
+    db->course_stats.stale = true;
+}
+
+/* ============================================================================
+ * CHANGE NOTIFICATION
+ * ============================================================================ */
+
+/**
+ * Register a callback for every change to the student records
+ * @param db Database to observe
+ * @param func Callback, run synchronously after each change
+ * @param context Opaque pointer passed to the callback
+ * @return false if the observer table is full
+ */
+bool add_student_observer(StudentDatabase *db, StudentObserverFunc func, void *context) {
+    if (!db || !func || db->observer_count >= MAX_STUDENT_OBSERVERS) {
+        return false;
+    }
+
+    db->observers[db->observer_count].func = func;
+    db->observers[db->observer_count].context = context;
+    db->observer_count++;
+    return true;
+}
+
+/**
+ * Unregister a callback added with add_student_observer
+ * @param db Database being observed
+ * @param func Callback to remove
+ * @param context Context it was registered with
+ */
+void remove_student_observer(StudentDatabase *db, StudentObserverFunc func, void *context) {
+    if (!db) return;
+
+    for (int i = 0; i < db->observer_count; i++) {
+        if (db->observers[i].func == func && db->observers[i].context == context) {
+            memmove(&db->observers[i], &db->observers[i + 1],
+                    (size_t)(db->observer_count - i - 1) * sizeof(StudentObserver));
+            db->observer_count--;
+            return;
+        }
+    }
+}
+
+/**
+ * Report one change to every observer (held back inside a batch)
+ * @param db Database that changed
+ * @param kind Kind of change
+ * @param roll_number Student concerned
+ * @param position Student's index in the students array
+ */
+static void notify_student_change(StudentDatabase *db, StudentChangeKind kind, int roll_number, int position) {
+    if (db->batch_depth > 0) {
+        db->batch_changed = true;
+        return;
+    }
+
+    StudentChange change = {kind, roll_number, position};
+    for (int i = 0; i < db->observer_count; i++) {
+        db->observers[i].func(&change, db->observers[i].context);
+    }
+}
+
+/**
+ * Start a bulk change (e.g. loading a file). Per-record notifications
+ * are held back until the matching end_student_batch.
+ * @param db Database about to change
+ */
+void begin_student_batch(StudentDatabase *db) {
+    if (db) {
+        db->batch_depth++;
+    }
+}
+
+/**
+ * Finish a bulk change; observers get a single STUDENT_CHANGE_RESET if
+ * anything changed while the batch was open
+ * @param db Database that changed
+ */
+void end_student_batch(StudentDatabase *db) {
+    if (!db || db->batch_depth <= 0) return;
+
+    if (--db->batch_depth == 0 && db->batch_changed) {
+        db->batch_changed = false;
+        notify_student_change(db, STUDENT_CHANGE_RESET, 0, -1);
+    }
+}
+
+/* ============================================================================
+ * RUNNING AGGREGATES
+ * ============================================================================ */
+
+/**
+ * Marks histogram bin holding a mark
+ * @param marks Marks (0-100; values outside fall into the end bins)
+ * @return Bin index in [0, MARKS_HISTOGRAM_BINS)
+ */
+int marks_histogram_bin(float marks) {
+    int bin = (int)(marks / MARKS_HISTOGRAM_BIN_WIDTH);
+    if (bin < 0) return 0;
+    if (bin >= MARKS_HISTOGRAM_BINS) return MARKS_HISTOGRAM_BINS - 1;
+    return bin;
+}
+
+/**
+ * Add a student's contribution to the running aggregates, rank trees and
+ * bitmap index.
+ * Must be paired with aggregates_detach around every change to marks,
+ * courses or GPA.
+ * @param db Database owning the aggregates
+ * @param student Student to account for
+ */
+static void aggregates_attach(StudentDatabase *db, const Student *student) {
+    RunningAggregates *agg = &db->aggregates;
+    double marks = student->marks;
+
+    agg->count++;
+    agg->sum_marks += marks;
+    agg->sum_squares += marks * marks;
+    if (student->marks >= PASSING_MARKS) {
+        agg->passed_students++;
+    }
+    agg->grade_counts[grade_index_for_marks(student->marks)]++;
+    agg->marks_histogram[marks_histogram_bin(student->marks)]++;
+
+    if (student->course_count > 0) {
+        agg->sum_gpa += student->gpa;
+        agg->students_with_courses++;
+    }
+
+    rank_tree_insert(&db->marks_tree, student->marks, student->roll_number);
+    rank_tree_insert(&db->gpa_tree, student->gpa, student->roll_number);
+
+    bitmap_index_update(&db->bitmap_index, student->roll_number, student->marks, student->gpa, true);
+    for (int i = 0; i < MAX_COURSES; i++) {
+        if (student->courses[i].is_active) {
+            bitmap_index_set_enrolment(&db->bitmap_index, student->courses[i].course_name,
+                                       student->roll_number, true);
+        }
+    }
+}
+
+/**
+ * Remove a student's contribution from the running aggregates, rank trees
+ * and bitmap index
+ * @param db Database owning the aggregates
+ * @param student Student to remove (must hold the values it was attached with)
+ */
+static void aggregates_detach(StudentDatabase *db, const Student *student) {
+    RunningAggregates *agg = &db->aggregates;
+    double marks = student->marks;
+
+    agg->count--;
+    agg->sum_marks -= marks;
+    agg->sum_squares -= marks * marks;
+    if (student->marks >= PASSING_MARKS) {
+        agg->passed_students--;
+    }
+    agg->grade_counts[grade_index_for_marks(student->marks)]--;
+    agg->marks_histogram[marks_histogram_bin(student->marks)]--;
+
+    if (student->course_count > 0) {
+        agg->sum_gpa -= student->gpa;
+        agg->students_with_courses--;
+    }
+
+    // Drop accumulated rounding once the database is empty again
+    if (agg->count == 0) {
+        agg->sum_marks = 0.0;
+        agg->sum_squares = 0.0;
+    }
+    if (agg->students_with_courses == 0) {
+        agg->sum_gpa = 0.0;
+    }
+
+    rank_tree_remove(&db->marks_tree, student->marks, student->roll_number);
+    rank_tree_remove(&db->gpa_tree, student->gpa, student->roll_number);
+
+    bitmap_index_update(&db->bitmap_index, student->roll_number, student->marks, student->gpa, false);
+    for (int i = 0; i < MAX_COURSES; i++) {
+        if (student->courses[i].is_active) {
+            bitmap_index_set_enrolment(&db->bitmap_index, student->courses[i].course_name,
+                                       student->roll_number, false);
+        }
+    }
+}
+
+/**
+ * (Re)index a student's name for exact and fuzzy name search
+ * @param db Database owning the indexes
+ * @param student Student whose current name should be searchable
+ */
+static void index_student_name(StudentDatabase *db, const Student *student) {
+    name_index_add(&db->name_index, student->roll_number, student->name);
+    trigram_index_add(&db->trigram_index, student->roll_number, student->name);
+}
+
+/**
+ * Recompute the running aggregates, rank trees and search indexes from scratch
+ * @param db Database to rebuild
+ */
+void rebuild_running_aggregates(StudentDatabase *db) {
+    if (!db) return;
+
+    memset(&db->aggregates, 0, sizeof(db->aggregates));
+    rank_tree_clear(&db->marks_tree);
+    rank_tree_clear(&db->gpa_tree);
+    bitmap_index_clear(&db->bitmap_index);
+    name_index_clear(&db->name_index);
+    trigram_index_clear(&db->trigram_index);
+
+    for (int i = 0; i < db->count; i++) {
+        if (db->students[i].is_active) {
+            aggregates_attach(db, &db->students[i]);
+            index_student_name(db, &db->students[i]);
+        }
     }
 }
 
+/**
+ * Rebuild everything that depends on array positions (marks column and
+ * roll number index) after the students array was reordered
+ * @param db Database to refresh
+ */
+void refresh_student_positions(StudentDatabase *db) {
+    if (!db) return;
+
+    rebuild_marks_column(db);
+
+    roll_index_clear(&db->roll_index);
+    for (int i = 0; i < db->count; i++) {
+        roll_index_put(&db->roll_index, db->students[i].roll_number, i);
+    }
+
+    notify_student_change(db, STUDENT_CHANGE_RESET, 0, -1);
+}
+
 /* ============================================================================
  * STUDENT MANAGEMENT FUNCTIONS
  * ============================================================================ */
@@ -92,14 +503,7 @@ void update_student_status(Student *student) {
  * @return true if duplicate found, false otherwise
  */
 bool is_duplicate_roll_number(StudentDatabase *db, int roll_number) {
-    if (!db) return false;
-
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].roll_number == roll_number) {
-            return true;
-        }
-    }
-    return false;
+    return find_student(db, roll_number) != NULL;
 }
 
 /**
@@ -139,6 +543,7 @@ StudentError add_student(StudentDatabase *db, const char *name, int roll_number,
     }
 
     // Add the student
+    preserve_student_records(db, db->count, 1);
     Student *new_student = &db->students[db->count];
 
     // Initialize student data
@@ -160,11 +565,16 @@ StudentError add_student(StudentDatabase *db, const char *name, int roll_number,
     }
 
     update_student_status(new_student);
+    db->marks_column[db->count] = marks;
+    roll_index_put(&db->roll_index, roll_number, db->count);
+    index_student_name(db, new_student);
+    aggregates_attach(db, new_student);
     db->count++;
     mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_ADDED, roll_number, db->count - 1);
 
-    printf("Student added successfully: %s (Roll: %d, Marks: %.2f)\n",
-           name, roll_number, marks);
+    LOG_DEBUG("Student added successfully: %s (Roll: %d, Marks: %.2f)",
+              name, roll_number, marks);
 
     return STUDENT_SUCCESS;
 }
@@ -178,12 +588,89 @@ StudentError add_student(StudentDatabase *db, const char *name, int roll_number,
 Student* find_student(StudentDatabase *db, int roll_number) {
     if (!db) return NULL;
 
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].roll_number == roll_number) {
-            return &db->students[i];
+    int index = roll_index_get(&db->roll_index, roll_number);
+    if (index < 0 || index >= db->count) {
+        return NULL;
+    }
+
+    Student *student = &db->students[index];
+    if (!student->is_active || student->roll_number != roll_number) {
+        return NULL;
+    }
+    return student;
+}
+
+// Output cursor for name search results
+typedef struct {
+    StudentDatabase *db;
+    Student **results;
+    int filled;
+} NameSearchResults;
+
+static bool collect_name_match(int roll_number, void *context) {
+    NameSearchResults *out = (NameSearchResults*)context;
+    Student *student = find_student(out->db, roll_number);
+    if (student) {
+        out->results[out->filled++] = student;
+    }
+    return true;
+}
+
+/**
+ * Find students by name. The query is normalized like the stored names
+ * (case-insensitive, whitespace-collapsed); prefix matches are returned
+ * first in name order, followed in substring mode by names containing
+ * the query elsewhere.
+ * @param db Database to search
+ * @param query Name fragment to look for
+ * @param mode NAME_SEARCH_PREFIX or NAME_SEARCH_SUBSTRING
+ * @param results Caller-provided array of at least max_results pointers
+ * @param max_results Maximum number of matches to return
+ * @return Number of students written to results
+ */
+int search_students_by_name(StudentDatabase *db, const char *query, NameSearchMode mode,
+                            Student **results, int max_results) {
+    if (!db || !query || !results || max_results <= 0) return 0;
+
+    NameSearchResults out = {db, results, 0};
+    pthread_mutex_lock(&db->search_lock);
+    name_index_search(&db->name_index, query, mode, max_results, collect_name_match, &out);
+    pthread_mutex_unlock(&db->search_lock);
+    return out.filled;
+}
+
+/**
+ * Find the students whose names are closest to a possibly misspelled
+ * query (edit distance with adjacent transpositions, case-insensitive)
+ * @param db Database to search
+ * @param query Name or part of a name, e.g. "jonh smiht"
+ * @param max_distance Largest edit distance accepted; negative picks one
+ *                     from the query length
+ * @param results Caller-provided array of at least k matches, closest first
+ * @param k Maximum number of matches
+ * @return Number of matches written to results
+ */
+int fuzzy_search_students_by_name(StudentDatabase *db, const char *query, int max_distance,
+                                  FuzzyNameMatch *results, int k) {
+    if (!db || !query || !results || k <= 0) return 0;
+
+    TrigramMatch *matches = (TrigramMatch*)safe_malloc((size_t)k * sizeof(TrigramMatch));
+    pthread_mutex_lock(&db->search_lock);
+    int found = trigram_index_search(&db->trigram_index, query, max_distance, matches, k);
+    pthread_mutex_unlock(&db->search_lock);
+
+    int filled = 0;
+    for (int i = 0; i < found; i++) {
+        Student *student = find_student(db, matches[i].roll_number);
+        if (student) {
+            results[filled].student = student;
+            results[filled].distance = matches[i].distance;
+            filled++;
         }
     }
-    return NULL;
+
+    free(matches);
+    return filled;
 }
 
 /**
@@ -197,29 +684,33 @@ StudentError remove_student(StudentDatabase *db, int roll_number) {
         return STUDENT_ERROR_NULL_POINTER;
     }
 
-    int index = -1;
-    for (int i = 0; i < db->count; i++) {
-        if (db->students[i].is_active && db->students[i].roll_number == roll_number) {
-            index = i;
-            break;
-        }
-    }
-
-    if (index == -1) {
+    Student *student = find_student(db, roll_number);
+    if (!student) {
         return STUDENT_ERROR_STUDENT_NOT_FOUND;
     }
 
+    int index = (int)(student - db->students);
+    preserve_student_records(db, index, db->count - index);
+    aggregates_detach(db, student);
+    roll_index_remove(&db->roll_index, roll_number);
+    name_index_remove(&db->name_index, roll_number);
+    trigram_index_remove(&db->trigram_index, roll_number);
+
     // Shift all elements after the removed student
     for (int i = index; i < db->count - 1; i++) {
         db->students[i] = db->students[i + 1];
+        roll_index_put(&db->roll_index, db->students[i].roll_number, i);
     }
+    memmove(&db->marks_column[index], &db->marks_column[index + 1],
+            (size_t)(db->count - 1 - index) * sizeof(float));
 
     // Mark the last slot as inactive
     db->students[db->count - 1].is_active = false;
     db->count--;
     mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_REMOVED, roll_number, index);
 
-    printf("Student with roll number %d removed successfully\n", roll_number);
+    LOG_DEBUG("Student with roll number %d removed successfully", roll_number);
     return STUDENT_SUCCESS;
 }
 
@@ -249,18 +740,28 @@ StudentError modify_student(StudentDatabase *db, int roll_number, const char *na
         return STUDENT_ERROR_STUDENT_NOT_FOUND;
     }
 
+    preserve_student_records(db, (int)(student - db->students), 1);
+    aggregates_detach(db, student);
+
     // Update student information
+    bool name_changed = strncmp(student->name, name, MAX_NAME_LENGTH - 1) != 0;
     strncpy(student->name, name, MAX_NAME_LENGTH - 1);
     student->name[MAX_NAME_LENGTH - 1] = '\0';
+    if (name_changed) {
+        index_student_name(db, student);
+    }
     student->marks = marks;
 
     // Recalculate overall status
     calculate_overall_marks(student);
     update_student_status(student);
+    sync_marks_column(db, student);
+    aggregates_attach(db, student);
     mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_MODIFIED, roll_number, (int)(student - db->students));
 
-    printf("Student updated successfully: %s (Roll: %d, Marks: %.2f)\n",
-           name, roll_number, marks);
+    LOG_DEBUG("Student updated successfully: %s (Roll: %d, Marks: %.2f)",
+              name, roll_number, marks);
 
     return STUDENT_SUCCESS;
 }
@@ -318,6 +819,9 @@ StudentError add_course_to_student(StudentDatabase *db, int roll_number,
         return STUDENT_ERROR_MAX_COURSES_REACHED;
     }
 
+    preserve_student_records(db, (int)(student - db->students), 1);
+    aggregates_detach(db, student);
+
     // Add the course
     Course *new_course = &student->courses[course_index];
     strncpy(new_course->course_name, course_name, MAX_COURSE_NAME_LENGTH - 1);
@@ -333,10 +837,110 @@ StudentError add_course_to_student(StudentDatabase *db, int roll_number,
     calculate_student_gpa(student);
     calculate_overall_marks(student);
     update_student_status(student);
+    sync_marks_column(db, student);
+    aggregates_attach(db, student);
     mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_MODIFIED, roll_number, (int)(student - db->students));
 
-    printf("Course added successfully: %s (Score: %.2f, Grade: %s)\n",
-           course_name, course_score, new_course->grade_letter);
+    LOG_DEBUG("Course added successfully: %s (Score: %.2f, Grade: %s)",
+              course_name, course_score, new_course->grade_letter);
+
+    return STUDENT_SUCCESS;
+}
+
+/**
+ * Remove a course from a student's record
+ * @param db Database containing the student
+ * @param roll_number Student's roll number
+ * @param course_name Name of the course to remove
+ * @return StudentError code
+ */
+StudentError remove_course_from_student(StudentDatabase *db, int roll_number,
+                                       const char *course_name) {
+    if (!db || !course_name) {
+        return STUDENT_ERROR_NULL_POINTER;
+    }
+
+    Student *student = find_student(db, roll_number);
+    if (!student) {
+        return STUDENT_ERROR_STUDENT_NOT_FOUND;
+    }
+
+    Course *course = find_course_in_student(student, course_name);
+    if (!course) {
+        return STUDENT_ERROR_COURSE_NOT_FOUND;
+    }
+
+    preserve_student_records(db, (int)(student - db->students), 1);
+    aggregates_detach(db, student);
+
+    // Free the course slot
+    course->is_active = false;
+    strcpy(course->course_name, "");
+    course->course_score = 0.0f;
+    strcpy(course->grade_letter, "");
+    strcpy(course->status, "");
+    student->course_count--;
+
+    // Recalculate student's overall performance
+    calculate_student_gpa(student);
+    calculate_overall_marks(student);
+    update_student_status(student);
+    sync_marks_column(db, student);
+    aggregates_attach(db, student);
+    mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_MODIFIED, roll_number, (int)(student - db->students));
+
+    LOG_DEBUG("Course removed successfully: %s (Roll: %d)", course_name, roll_number);
+    return STUDENT_SUCCESS;
+}
+
+/**
+ * Change the score of an existing course
+ * @param db Database containing the student
+ * @param roll_number Student's roll number
+ * @param course_name Name of the course
+ * @param new_score New score in the course
+ * @return StudentError code
+ */
+StudentError modify_course_score(StudentDatabase *db, int roll_number,
+                                const char *course_name, float new_score) {
+    if (!db || !course_name) {
+        return STUDENT_ERROR_NULL_POINTER;
+    }
+
+    if (!is_valid_marks(new_score)) {
+        return STUDENT_ERROR_INVALID_MARKS;
+    }
+
+    Student *student = find_student(db, roll_number);
+    if (!student) {
+        return STUDENT_ERROR_STUDENT_NOT_FOUND;
+    }
+
+    Course *course = find_course_in_student(student, course_name);
+    if (!course) {
+        return STUDENT_ERROR_COURSE_NOT_FOUND;
+    }
+
+    preserve_student_records(db, (int)(student - db->students), 1);
+    aggregates_detach(db, student);
+
+    course->course_score = new_score;
+    strcpy(course->grade_letter, calculate_grade_letter(new_score));
+    update_course_status(course);
+
+    // Recalculate student's overall performance
+    calculate_student_gpa(student);
+    calculate_overall_marks(student);
+    update_student_status(student);
+    sync_marks_column(db, student);
+    aggregates_attach(db, student);
+    mark_database_changed(db);
+    notify_student_change(db, STUDENT_CHANGE_MODIFIED, roll_number, (int)(student - db->students));
+
+    LOG_DEBUG("Course score updated: %s (Score: %.2f, Grade: %s)",
+              course_name, new_score, course->grade_letter);
 
     return STUDENT_SUCCESS;
 }
@@ -416,21 +1020,12 @@ void calculate_overall_marks(Student *student) {
  * ============================================================================ */
 
 /**
- * Calculate grade letter based on score
+ * Calculate grade letter based on score, from the active grading scheme
  * @param score Numerical score
- * @return Grade letter (A-F)
+ * @return Grade letter (A-F), a constant string
  */
-char* calculate_grade_letter(float score) {
-    static char grade[3];
-
-    if (score >= 90.0f) strcpy(grade, "A");
-    else if (score >= 80.0f) strcpy(grade, "B");
-    else if (score >= 70.0f) strcpy(grade, "C");
-    else if (score >= 60.0f) strcpy(grade, "D");
-    else if (score >= 40.0f) strcpy(grade, "E");
-    else strcpy(grade, "F");
-
-    return grade;
+const char* calculate_grade_letter(float score) {
+    return grade_letter_for_marks(score);
 }
 
 /**
@@ -591,6 +1186,36 @@ void mark_database_saved(StudentDatabase *db) {
     }
 }
 
+/* ============================================================================
+ * MARKS COLUMN FUNCTIONS
+ * ============================================================================ */
+
+/**
+ * Copy one student's marks into the contiguous marks column
+ * @param db Database owning the student
+ * @param student Student whose marks changed (must live in db->students)
+ */
+void sync_marks_column(StudentDatabase *db, const Student *student) {
+    if (!db || !db->marks_column || !student) return;
+
+    ptrdiff_t index = student - db->students;
+    if (index >= 0 && index < db->count) {
+        db->marks_column[index] = student->marks;
+    }
+}
+
+/**
+ * Rebuild the whole marks column after the students array was reordered
+ * @param db Database to rebuild
+ */
+void rebuild_marks_column(StudentDatabase *db) {
+    if (!db || !db->marks_column) return;
+
+    for (int i = 0; i < db->count; i++) {
+        db->marks_column[i] = db->students[i].marks;
+    }
+}
+
 /* ============================================================================
  * UTILITY FUNCTIONS
  * ============================================================================ */
@@ -639,6 +1264,8 @@ int get_student_count(StudentDatabase *db) {
  */
 void clear_database(StudentDatabase *db) {
     if (db) {
+        preserve_student_records(db, 0, db->count);
+
         // Mark all students as inactive
         for (int i = 0; i < db->count; i++) {
             db->students[i].is_active = false;
@@ -651,7 +1278,67 @@ void clear_database(StudentDatabase *db) {
         }
 
         db->count = 0;
+        memset(&db->aggregates, 0, sizeof(db->aggregates));
+        rank_tree_clear(&db->marks_tree);
+        rank_tree_clear(&db->gpa_tree);
+        roll_index_clear(&db->roll_index);
+        bitmap_index_clear(&db->bitmap_index);
+        name_index_clear(&db->name_index);
+        trigram_index_clear(&db->trigram_index);
         mark_database_changed(db);
-        printf("Database cleared successfully\n");
+        notify_student_change(db, STUDENT_CHANGE_RESET, 0, -1);
+        LOG_DEBUG("Database cleared successfully");
+    }
+}
+
+// Exchange two objects of 'size' bytes through a small stack buffer
+static void swap_bytes(void *a, void *b, size_t size) {
+    unsigned char buffer[256];
+    unsigned char *x = (unsigned char*)a;
+    unsigned char *y = (unsigned char*)b;
+    while (size > 0) {
+        size_t step = size < sizeof(buffer) ? size : sizeof(buffer);
+        memcpy(buffer, x, step);
+        memcpy(x, y, step);
+        memcpy(y, buffer, step);
+        x += step;
+        y += step;
+        size -= step;
     }
+}
+
+/**
+ * Exchange every record, and the indexes built over them, between two
+ * databases in O(1). Observers and batch state stay with their database;
+ * the observers of 'db' are told to re-read everything. Used to install
+ * records loaded into a private database on another thread.
+ * @param db Database whose records are replaced
+ * @param other Database that receives the old records
+ */
+void swap_database_records(StudentDatabase *db, StudentDatabase *other) {
+    if (!db || !other || db == other) return;
+    preserve_student_records(db, 0, db->count);
+    preserve_student_records(other, 0, other->count);
+
+    // Only the records and the indexes over them move; observers, batch
+    // state, the locks, open snapshots and the course cache belong to the
+    // database object and stay put. The indexes own heap memory and hold
+    // no pointers into themselves, so swapping them by value is safe.
+#define SWAP_RECORD_FIELD(field) swap_bytes(&db->field, &other->field, sizeof(db->field))
+    SWAP_RECORD_FIELD(students);
+    SWAP_RECORD_FIELD(marks_column);
+    SWAP_RECORD_FIELD(count);
+    SWAP_RECORD_FIELD(capacity);
+    SWAP_RECORD_FIELD(last_saved_file);
+    SWAP_RECORD_FIELD(has_unsaved_changes);
+    SWAP_RECORD_FIELD(aggregates);
+    SWAP_RECORD_FIELD(marks_tree);
+    SWAP_RECORD_FIELD(gpa_tree);
+    SWAP_RECORD_FIELD(roll_index);
+    SWAP_RECORD_FIELD(bitmap_index);
+    SWAP_RECORD_FIELD(name_index);
+    SWAP_RECORD_FIELD(trigram_index);
+#undef SWAP_RECORD_FIELD
+
+    notify_student_change(db, STUDENT_CHANGE_RESET, 0, -1);
 }
\ No newline at end of file
@@ -0,0 +1,670 @@
+/*
+ * File: src/student_list_model.c
+ * Path: SchoolRecordSystem/src/student_list_model.c
+ * Description: Virtual GtkTreeModel that reads student rows straight from the database
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ */
+
+#include "student_list_model.h"
+#include "gui.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct _StudentListModel {
+    GObject parent_instance;
+
+    StudentDatabase *db;
+    gint stamp;                          // Changes whenever rows move; stale iters fail
+
+    bool shows_all;                      // Every student rather than a subset
+    int *roll_numbers;                   // Explicit rows (NULL = database order)
+    int row_count;                       // Rows in roll_numbers
+    int row_capacity;
+    RollIndex row_of_roll;               // Roll number -> row, for explicit rows
+
+    gint sort_column;                    // Column chosen in the view, or unsorted
+    GtkSortType sort_order;
+};
+
+static void student_list_model_tree_model_init(GtkTreeModelIface *iface);
+static void student_list_model_sortable_init(GtkTreeSortableIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(StudentListModel, student_list_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, student_list_model_tree_model_init)
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_SORTABLE, student_list_model_sortable_init))
+
+/* ============================================================================
+ * ROW ACCESS
+ * ============================================================================ */
+
+static int model_row_count(const StudentListModel *model) {
+    return model->roll_numbers ? model->row_count : model->db->count;
+}
+
+static Student* row_student(const StudentListModel *model, int row) {
+    if (row < 0 || row >= model_row_count(model)) return NULL;
+    if (!model->roll_numbers) return &model->db->students[row];
+    return find_student(model->db, model->roll_numbers[row]);
+}
+
+static bool is_sorted_view(const StudentListModel *model) {
+    return model->sort_column != GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID &&
+           model->sort_column != GTK_TREE_SORTABLE_DEFAULT_SORT_COLUMN_ID;
+}
+
+static void reserve_rows(StudentListModel *model, int count) {
+    if (count <= model->row_capacity) return;
+
+    int capacity = model->row_capacity > 0 ? model->row_capacity : 64;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    model->roll_numbers = g_renew(int, model->roll_numbers, capacity);
+    model->row_capacity = capacity;
+}
+
+/**
+ * Re-point the roll number map at rows [from, row_count). Appends touch
+ * one row; an insert or delete in the middle of a column-sorted view
+ * moves every later row anyway.
+ * @param model Model with explicit rows
+ * @param from First row whose position changed
+ */
+static void reindex_rows(StudentListModel *model, int from) {
+    if (from == 0) {
+        roll_index_clear(&model->row_of_roll);
+    }
+    for (int row = from; row < model->row_count; row++) {
+        roll_index_put(&model->row_of_roll, model->roll_numbers[row], row);
+    }
+}
+
+static void set_iter(const StudentListModel *model, GtkTreeIter *iter, int row) {
+    iter->stamp = model->stamp;
+    iter->user_data = GINT_TO_POINTER(row);
+    iter->user_data2 = NULL;
+    iter->user_data3 = NULL;
+}
+
+static int iter_row(const StudentListModel *model, const GtkTreeIter *iter) {
+    if (!iter || iter->stamp != model->stamp) return -1;
+    return GPOINTER_TO_INT(iter->user_data);
+}
+
+static void emit_row_signal(StudentListModel *model, int row, bool inserted) {
+    GtkTreeIter iter;
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    set_iter(model, &iter, row);
+    if (inserted) {
+        gtk_tree_model_row_inserted(GTK_TREE_MODEL(model), path, &iter);
+    } else {
+        gtk_tree_model_row_changed(GTK_TREE_MODEL(model), path, &iter);
+    }
+    gtk_tree_path_free(path);
+}
+
+static void emit_row_deleted(StudentListModel *model, int row) {
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_deleted(GTK_TREE_MODEL(model), path);
+    gtk_tree_path_free(path);
+}
+
+/* ============================================================================
+ * COLUMN ORDERING
+ * ============================================================================ */
+
+static int compare_rolls(const Student *a, const Student *b) {
+    return (a->roll_number > b->roll_number) - (a->roll_number < b->roll_number);
+}
+
+static int compare_names(const Student *a, const Student *b) {
+    int order = g_ascii_strcasecmp(a->name, b->name);
+    return order != 0 ? order : compare_rolls(a, b);
+}
+
+static int compare_marks(const Student *a, const Student *b) {
+    int order = (a->marks > b->marks) - (a->marks < b->marks);
+    return order != 0 ? order : compare_rolls(a, b);
+}
+
+static int compare_gpas(const Student *a, const Student *b) {
+    int order = (a->gpa > b->gpa) - (a->gpa < b->gpa);
+    return order != 0 ? order : compare_rolls(a, b);
+}
+
+typedef int (*StudentCompareFunc)(const Student *a, const Student *b);
+
+static StudentCompareFunc column_comparator(gint column) {
+    switch (column) {
+        case COL_NAME:  return compare_names;
+        case COL_MARKS: return compare_marks;
+        case COL_GPA:   return compare_gpas;
+        default:        return compare_rolls;
+    }
+}
+
+// Order of two rows in the current sort (missing students sort first)
+static int compare_in_view(const StudentListModel *model, const Student *a, const Student *b) {
+    if (!a || !b) return (a != NULL) - (b != NULL);
+
+    int order = column_comparator(model->sort_column)(a, b);
+    return model->sort_order == GTK_SORT_DESCENDING ? -order : order;
+}
+
+// A row being sorted, remembering where it came from
+typedef struct {
+    Student *student;
+    int roll_number;
+    int old_row;
+} SortSlot;
+
+static StudentCompareFunc active_comparator;
+static bool active_descending;
+
+static int compare_slots(const void *a, const void *b) {
+    const SortSlot *x = (const SortSlot*)a;
+    const SortSlot *y = (const SortSlot*)b;
+
+    if (!x->student || !y->student) {
+        int order = (x->student != NULL) - (y->student != NULL);
+        return order != 0 ? order : (x->old_row > y->old_row) - (x->old_row < y->old_row);
+    }
+
+    int order = active_comparator(x->student, y->student);
+    return active_descending ? -order : order;
+}
+
+/**
+ * Put the rows in the order of the chosen column, switching to explicit
+ * rows if needed. Emits rows-reordered when 'notify' is set.
+ * @param model Model to sort
+ * @param notify Whether attached views must be told
+ */
+static void sort_rows(StudentListModel *model, bool notify) {
+    int count = model_row_count(model);
+    SortSlot *slots = g_new(SortSlot, count > 0 ? count : 1);
+
+    for (int row = 0; row < count; row++) {
+        Student *student = row_student(model, row);
+        slots[row].student = student;
+        slots[row].roll_number = model->roll_numbers ? model->roll_numbers[row] : student->roll_number;
+        slots[row].old_row = row;
+    }
+
+    // The view only ever sorts on the main thread
+    active_comparator = column_comparator(model->sort_column);
+    active_descending = model->sort_order == GTK_SORT_DESCENDING;
+    qsort(slots, (size_t)count, sizeof(SortSlot), compare_slots);
+
+    reserve_rows(model, count);
+    int *new_order = g_new(int, count > 0 ? count : 1);
+    for (int row = 0; row < count; row++) {
+        model->roll_numbers[row] = slots[row].roll_number;
+        new_order[row] = slots[row].old_row;
+    }
+    model->row_count = count;
+    model->stamp++;
+    reindex_rows(model, 0);
+
+    if (notify && count > 0) {
+        GtkTreePath *path = gtk_tree_path_new();
+        gtk_tree_model_rows_reordered(GTK_TREE_MODEL(model), path, NULL, new_order);
+        gtk_tree_path_free(path);
+    }
+
+    g_free(new_order);
+    g_free(slots);
+}
+
+// Row where a student belongs in the sorted rows (binary search)
+static int sorted_insert_row(const StudentListModel *model, const Student *student) {
+    int lo = 0, hi = model->row_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_in_view(model, row_student(model, mid), student) <= 0) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static void insert_row(StudentListModel *model, int row, int roll_number) {
+    reserve_rows(model, model->row_count + 1);
+    memmove(&model->roll_numbers[row + 1], &model->roll_numbers[row],
+            (size_t)(model->row_count - row) * sizeof(int));
+    model->roll_numbers[row] = roll_number;
+    model->row_count++;
+    model->stamp++;
+    reindex_rows(model, row);
+    emit_row_signal(model, row, true);
+}
+
+static void delete_row(StudentListModel *model, int row) {
+    roll_index_remove(&model->row_of_roll, model->roll_numbers[row]);
+    memmove(&model->roll_numbers[row], &model->roll_numbers[row + 1],
+            (size_t)(model->row_count - row - 1) * sizeof(int));
+    model->row_count--;
+    model->stamp++;
+    reindex_rows(model, row);
+    emit_row_deleted(model, row);
+}
+
+/* ============================================================================
+ * GTK TREE MODEL INTERFACE
+ * ============================================================================ */
+
+static GtkTreeModelFlags model_get_flags(GtkTreeModel *tree_model) {
+    return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint model_get_n_columns(GtkTreeModel *tree_model) {
+    return NUM_STUDENT_COLS;
+}
+
+static GType model_get_column_type(GtkTreeModel *tree_model, gint column) {
+    switch (column) {
+        case COL_ROLL_NUMBER:
+        case COL_COURSES:
+            return G_TYPE_INT;
+        case COL_NAME:
+        case COL_STATUS:
+            return G_TYPE_STRING;
+        case COL_MARKS:
+        case COL_GPA:
+            return G_TYPE_FLOAT;
+        default:
+            return G_TYPE_INVALID;
+    }
+}
+
+static gboolean model_get_iter(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreePath *path) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+
+    if (gtk_tree_path_get_depth(path) != 1) return FALSE;
+
+    int row = gtk_tree_path_get_indices(path)[0];
+    if (row < 0 || row >= model_row_count(model)) return FALSE;
+
+    set_iter(model, iter, row);
+    return TRUE;
+}
+
+static GtkTreePath* model_get_path(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+
+    int row = iter_row(model, iter);
+    if (row < 0) return NULL;
+    return gtk_tree_path_new_from_indices(row, -1);
+}
+
+/**
+ * Read one cell straight from the student record; only rows being drawn
+ * are ever asked for
+ */
+static void model_get_value(GtkTreeModel *tree_model, GtkTreeIter *iter, gint column, GValue *value) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+    const Student *student = row_student(model, iter_row(model, iter));
+
+    g_value_init(value, model_get_column_type(tree_model, column));
+    if (!student) return;
+
+    switch (column) {
+        case COL_ROLL_NUMBER: g_value_set_int(value, student->roll_number);    break;
+        case COL_NAME:        g_value_set_string(value, student->name);        break;
+        case COL_MARKS:       g_value_set_float(value, student->marks);        break;
+        case COL_STATUS:      g_value_set_string(value, student->status);      break;
+        case COL_COURSES:     g_value_set_int(value, student->course_count);   break;
+        case COL_GPA:         g_value_set_float(value, student->gpa);          break;
+        default:              break;
+    }
+}
+
+static gboolean model_iter_next(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+
+    int row = iter_row(model, iter);
+    if (row < 0 || row + 1 >= model_row_count(model)) {
+        iter->stamp = 0;
+        return FALSE;
+    }
+
+    set_iter(model, iter, row + 1);
+    return TRUE;
+}
+
+static gboolean model_iter_previous(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+
+    int row = iter_row(model, iter);
+    if (row <= 0) {
+        iter->stamp = 0;
+        return FALSE;
+    }
+
+    set_iter(model, iter, row - 1);
+    return TRUE;
+}
+
+static gboolean model_iter_nth_child(GtkTreeModel *tree_model, GtkTreeIter *iter,
+                                     GtkTreeIter *parent, gint n) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+
+    if (parent || n < 0 || n >= model_row_count(model)) return FALSE;
+
+    set_iter(model, iter, n);
+    return TRUE;
+}
+
+static gboolean model_iter_children(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent) {
+    return model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean model_iter_has_child(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    return FALSE;
+}
+
+static gint model_iter_n_children(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    StudentListModel *model = STUDENT_LIST_MODEL(tree_model);
+    return iter ? 0 : model_row_count(model);
+}
+
+static gboolean model_iter_parent(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *child) {
+    return FALSE;
+}
+
+static void student_list_model_tree_model_init(GtkTreeModelIface *iface) {
+    iface->get_flags = model_get_flags;
+    iface->get_n_columns = model_get_n_columns;
+    iface->get_column_type = model_get_column_type;
+    iface->get_iter = model_get_iter;
+    iface->get_path = model_get_path;
+    iface->get_value = model_get_value;
+    iface->iter_next = model_iter_next;
+    iface->iter_previous = model_iter_previous;
+    iface->iter_children = model_iter_children;
+    iface->iter_has_child = model_iter_has_child;
+    iface->iter_n_children = model_iter_n_children;
+    iface->iter_nth_child = model_iter_nth_child;
+    iface->iter_parent = model_iter_parent;
+}
+
+/* ============================================================================
+ * GTK TREE SORTABLE INTERFACE
+ * ============================================================================ */
+
+static gboolean sortable_get_sort_column_id(GtkTreeSortable *sortable, gint *sort_column_id,
+                                            GtkSortType *order) {
+    StudentListModel *model = STUDENT_LIST_MODEL(sortable);
+
+    if (sort_column_id) *sort_column_id = model->sort_column;
+    if (order) *order = model->sort_order;
+    return is_sorted_view(model);
+}
+
+/**
+ * Column header clicked: sort the visible rows with one rows-reordered
+ * signal. Unsorting an all-students view returns it to database order.
+ */
+static void sortable_set_sort_column_id(GtkTreeSortable *sortable, gint sort_column_id,
+                                        GtkSortType order) {
+    StudentListModel *model = STUDENT_LIST_MODEL(sortable);
+
+    if (model->sort_column == sort_column_id && model->sort_order == order) return;
+
+    model->sort_column = sort_column_id;
+    model->sort_order = order;
+
+    if (is_sorted_view(model)) {
+        sort_rows(model, true);
+    } else if (model->shows_all && model->roll_numbers) {
+        // Back to database order: row i becomes students[i]
+        RollIndex row_of_roll;
+        roll_index_init(&row_of_roll);
+        for (int row = 0; row < model->row_count; row++) {
+            roll_index_put(&row_of_roll, model->roll_numbers[row], row);
+        }
+
+        int count = model->db->count;
+        int *new_order = g_new(int, count > 0 ? count : 1);
+        for (int i = 0; i < count; i++) {
+            new_order[i] = roll_index_get(&row_of_roll, model->db->students[i].roll_number);
+        }
+        roll_index_free(&row_of_roll);
+
+        g_free(model->roll_numbers);
+        model->roll_numbers = NULL;
+        model->row_count = 0;
+        model->row_capacity = 0;
+        roll_index_clear(&model->row_of_roll);
+        model->stamp++;
+
+        if (count > 0) {
+            GtkTreePath *path = gtk_tree_path_new();
+            gtk_tree_model_rows_reordered(GTK_TREE_MODEL(model), path, NULL, new_order);
+            gtk_tree_path_free(path);
+        }
+        g_free(new_order);
+    }
+
+    gtk_tree_sortable_sort_column_changed(sortable);
+}
+
+static void sortable_set_sort_func(GtkTreeSortable *sortable, gint sort_column_id,
+                                   GtkTreeIterCompareFunc sort_func, gpointer user_data,
+                                   GDestroyNotify destroy) {
+    g_warning("StudentListModel sorts by its own column order; custom sort functions are ignored");
+}
+
+static void sortable_set_default_sort_func(GtkTreeSortable *sortable, GtkTreeIterCompareFunc sort_func,
+                                           gpointer user_data, GDestroyNotify destroy) {
+    g_warning("StudentListModel has no default sort function");
+}
+
+static gboolean sortable_has_default_sort_func(GtkTreeSortable *sortable) {
+    return FALSE;
+}
+
+static void student_list_model_sortable_init(GtkTreeSortableIface *iface) {
+    iface->get_sort_column_id = sortable_get_sort_column_id;
+    iface->set_sort_column_id = sortable_set_sort_column_id;
+    iface->set_sort_func = sortable_set_sort_func;
+    iface->set_default_sort_func = sortable_set_default_sort_func;
+    iface->has_default_sort_func = sortable_has_default_sort_func;
+}
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+static void student_list_model_finalize(GObject *object) {
+    StudentListModel *model = STUDENT_LIST_MODEL(object);
+    g_free(model->roll_numbers);
+    roll_index_free(&model->row_of_roll);
+    G_OBJECT_CLASS(student_list_model_parent_class)->finalize(object);
+}
+
+static void student_list_model_class_init(StudentListModelClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = student_list_model_finalize;
+}
+
+static void student_list_model_init(StudentListModel *model) {
+    model->stamp = g_random_int();
+    model->shows_all = true;
+    roll_index_init(&model->row_of_roll);
+    model->sort_column = GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID;
+    model->sort_order = GTK_SORT_ASCENDING;
+}
+
+/**
+ * Create a model showing every student in database order
+ * @param db Database the rows are read from (must outlive the model)
+ * @return New model (one reference)
+ */
+StudentListModel* student_list_model_new(StudentDatabase *db) {
+    StudentListModel *model = g_object_new(STUDENT_TYPE_LIST_MODEL, NULL);
+    model->db = db;
+    return model;
+}
+
+/* ============================================================================
+ * ROW SETS
+ * ============================================================================ */
+
+/**
+ * Show every student (database order, or the view's sort column). No
+ * per-row signals - detach the model from its views first.
+ * @param model Model to reset
+ */
+void student_list_model_show_all(StudentListModel *model) {
+    g_free(model->roll_numbers);
+    model->roll_numbers = NULL;
+    model->row_count = 0;
+    model->row_capacity = 0;
+    model->shows_all = true;
+    roll_index_clear(&model->row_of_roll);
+    model->stamp++;
+
+    if (is_sorted_view(model)) {
+        sort_rows(model, false);
+    }
+}
+
+/**
+ * Show only the given students, in the given order unless the view has
+ * a sort column. No per-row signals - detach the model from its views first.
+ * @param model Model to reset
+ * @param roll_numbers Students to show
+ * @param count Number of roll numbers
+ */
+void student_list_model_show_students(StudentListModel *model, const int *roll_numbers, int count) {
+    model->row_count = 0;
+    model->shows_all = false;
+    reserve_rows(model, count > 0 ? count : 1);
+    if (count > 0) {
+        memcpy(model->roll_numbers, roll_numbers, (size_t)count * sizeof(int));
+    }
+    model->row_count = count;
+    model->stamp++;
+
+    if (is_sorted_view(model)) {
+        sort_rows(model, false);
+    } else {
+        reindex_rows(model, 0);
+    }
+}
+
+/**
+ * Add students to a subset view (e.g. the next page of search results)
+ * @param model Model showing a subset
+ * @param roll_numbers Students to add
+ * @param count Number of roll numbers
+ */
+void student_list_model_append_students(StudentListModel *model, const int *roll_numbers, int count) {
+    if (model->shows_all) return;
+
+    for (int i = 0; i < count; i++) {
+        int row = model->row_count;
+        if (is_sorted_view(model)) {
+            Student *student = find_student(model->db, roll_numbers[i]);
+            if (!student) continue;
+            row = sorted_insert_row(model, student);
+        }
+        insert_row(model, row, roll_numbers[i]);
+    }
+}
+
+/* ============================================================================
+ * SINGLE-ROW UPDATES
+ * ============================================================================ */
+
+/**
+ * Row showing a roll number, in O(1): the database's roll index in
+ * database order, the model's own roll -> row map otherwise
+ * @param model Model to search
+ * @param roll_number Student's roll number
+ * @return Row index, or -1 if the student is not shown
+ */
+int student_list_model_row_of(StudentListModel *model, int roll_number) {
+    if (!model->roll_numbers) {
+        Student *student = find_student(model->db, roll_number);
+        return student ? (int)(student - model->db->students) : -1;
+    }
+
+    return roll_index_get(&model->row_of_roll, roll_number);
+}
+
+/**
+ * Whether the model shows every student
+ * @param model Model to query
+ * @return true unless a subset (search results) is shown
+ */
+bool student_list_model_shows_all(const StudentListModel *model) {
+    return model->shows_all;
+}
+
+/**
+ * A student was added to the database; all-students views gain its row
+ * @param model Model to patch
+ * @param roll_number New student's roll number
+ */
+void student_list_model_student_added(StudentListModel *model, int roll_number) {
+    if (!model->shows_all) return;
+
+    if (!model->roll_numbers) {
+        // add_student appends, so the new row is the last one
+        model->stamp++;
+        emit_row_signal(model, model->db->count - 1, true);
+        return;
+    }
+
+    Student *student = find_student(model->db, roll_number);
+    if (student) {
+        insert_row(model, sorted_insert_row(model, student), roll_number);
+    }
+}
+
+/**
+ * A student's fields changed; its row is redrawn, or moved if the change
+ * breaks the view's sort order
+ * @param model Model to patch
+ * @param roll_number Student's roll number
+ */
+void student_list_model_student_changed(StudentListModel *model, int roll_number) {
+    int row = student_list_model_row_of(model, roll_number);
+    if (row < 0) return;
+
+    if (model->roll_numbers && is_sorted_view(model)) {
+        const Student *student = row_student(model, row);
+        bool after_previous = row == 0 || compare_in_view(model, row_student(model, row - 1), student) <= 0;
+        bool before_next = row + 1 >= model->row_count ||
+                           compare_in_view(model, student, row_student(model, row + 1)) <= 0;
+
+        if (!after_previous || !before_next) {
+            delete_row(model, row);
+            insert_row(model, sorted_insert_row(model, student), roll_number);
+            return;
+        }
+    }
+
+    emit_row_signal(model, row, false);
+}
+
+/**
+ * A student was removed from the database; drop its row if shown
+ * @param model Model to patch
+ * @param roll_number Removed student's roll number
+ * @param database_position Index the student had in db->students
+ */
+void student_list_model_student_removed(StudentListModel *model, int roll_number, int database_position) {
+    if (!model->roll_numbers) {
+        // Later students shifted down one position, exactly like the rows
+        model->stamp++;
+        emit_row_deleted(model, database_position);
+        return;
+    }
+
+    int row = student_list_model_row_of(model, roll_number);
+    if (row >= 0) {
+        delete_row(model, row);
+    }
+}
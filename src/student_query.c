@@ -0,0 +1,309 @@
+/*
+ * File: src/student_query.c
+ * Path: SchoolRecordSystem/src/student_query.c
+ * Description: Compound student predicates evaluated over the bitmap index
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Leaf predicates map to index bitmaps and are used in place (no copy)
+ * - Marks/GPA thresholds union whole buckets and only inspect the single
+ *   bucket that straddles the threshold
+ * - AND/OR/NOT run on compressed containers, a 64-bit word at a time
+ */
+
+#include "student_query.h"
+#include <math.h>
+
+/* ============================================================================
+ * QUERY BUILDERS
+ * ============================================================================ */
+
+static StudentQuery make_query(QueryOp op) {
+    StudentQuery query = {0};
+    query.op = op;
+    return query;
+}
+
+StudentQuery query_passed(void) {
+    return make_query(QUERY_PASSED);
+}
+
+StudentQuery query_failed(void) {
+    return make_query(QUERY_FAILED);
+}
+
+StudentQuery query_grade(int grade_index) {
+    StudentQuery query = make_query(QUERY_GRADE);
+    query.grade = grade_index;
+    return query;
+}
+
+StudentQuery query_enrolled(const char *course_name) {
+    StudentQuery query = make_query(QUERY_ENROLLED);
+    query.course_name = course_name;
+    return query;
+}
+
+StudentQuery query_marks_below(float value) {
+    StudentQuery query = make_query(QUERY_MARKS_BELOW);
+    query.value = value;
+    return query;
+}
+
+StudentQuery query_marks_at_least(float value) {
+    StudentQuery query = make_query(QUERY_MARKS_AT_LEAST);
+    query.value = value;
+    return query;
+}
+
+StudentQuery query_gpa_below(float value) {
+    StudentQuery query = make_query(QUERY_GPA_BELOW);
+    query.value = value;
+    return query;
+}
+
+StudentQuery query_gpa_at_least(float value) {
+    StudentQuery query = make_query(QUERY_GPA_AT_LEAST);
+    query.value = value;
+    return query;
+}
+
+StudentQuery query_and(const StudentQuery *left, const StudentQuery *right) {
+    StudentQuery query = make_query(QUERY_AND);
+    query.left = left;
+    query.right = right;
+    return query;
+}
+
+StudentQuery query_or(const StudentQuery *left, const StudentQuery *right) {
+    StudentQuery query = make_query(QUERY_OR);
+    query.left = left;
+    query.right = right;
+    return query;
+}
+
+StudentQuery query_not(const StudentQuery *operand) {
+    StudentQuery query = make_query(QUERY_NOT);
+    query.left = operand;
+    return query;
+}
+
+/* ============================================================================
+ * THRESHOLD PREDICATES
+ * ============================================================================ */
+
+// Context for filtering the bucket that straddles a threshold
+typedef struct {
+    StudentDatabase *db;
+    bool use_gpa;
+    float threshold;
+    bool want_below;
+    RoaringBitmap *out;
+} BoundaryFilter;
+
+static bool refine_boundary_member(uint32_t roll_number, void *context) {
+    BoundaryFilter *filter = (BoundaryFilter*)context;
+    Student *student = find_student(filter->db, (int)roll_number);
+    if (student) {
+        float value = filter->use_gpa ? student->gpa : student->marks;
+        if ((value < filter->threshold) == filter->want_below) {
+            roaring_add(filter->out, roll_number);
+        }
+    }
+    return true;
+}
+
+/**
+ * Build the set of students whose marks (or GPA) are below a threshold
+ * @param db Student database
+ * @param use_gpa true for GPA, false for marks
+ * @param threshold Exclusive upper bound
+ * @param out Receives the result
+ */
+static void evaluate_below(StudentDatabase *db, bool use_gpa, float threshold, RoaringBitmap *out) {
+    const BitmapIndex *index = &db->bitmap_index;
+    const RoaringBitmap *buckets = use_gpa ? index->gpa_buckets : index->marks_buckets;
+    int bucket_count = use_gpa ? BITMAP_GPA_BUCKETS : BITMAP_MARKS_BUCKETS;
+
+    roaring_clear(out);
+    if (isnan(threshold)) {
+        return;
+    }
+
+    // Buckets below the boundary lie entirely under the threshold and
+    // buckets above it entirely over; only the boundary needs checking
+    int boundary = use_gpa ? bitmap_gpa_bucket(threshold) : bitmap_marks_bucket(threshold);
+    BoundaryFilter filter = {db, use_gpa, threshold, true, out};
+
+    if (boundary <= bucket_count / 2) {
+        for (int b = 0; b < boundary; b++) {
+            roaring_or_inplace(out, &buckets[b]);
+        }
+        roaring_visit(&buckets[boundary], refine_boundary_member, &filter);
+        return;
+    }
+
+    // Fewer buckets above the boundary: build the complement instead
+    RoaringBitmap above;
+    roaring_init(&above);
+    for (int b = boundary + 1; b < bucket_count; b++) {
+        roaring_or_inplace(&above, &buckets[b]);
+    }
+    filter.want_below = false;
+    filter.out = &above;
+    roaring_visit(&buckets[boundary], refine_boundary_member, &filter);
+
+    roaring_andnot(&index->all, &above, out);
+    roaring_free(&above);
+}
+
+/* ============================================================================
+ * EVALUATION
+ * ============================================================================ */
+
+// Shared empty set for courses nobody is enrolled in
+static const RoaringBitmap empty_bitmap = {NULL, 0, 0};
+
+/**
+ * Evaluate a query node. Leaves backed by a single index bitmap are
+ * returned directly; everything else is built into 'scratch'.
+ * @return Result bitmap (index-owned or scratch) or NULL for an invalid query
+ */
+static const RoaringBitmap* evaluate_node(StudentDatabase *db, const StudentQuery *query,
+                                          RoaringBitmap *scratch) {
+    if (!query) return NULL;
+
+    const BitmapIndex *index = &db->bitmap_index;
+
+    switch (query->op) {
+        case QUERY_PASSED:
+            return &index->passed;
+
+        case QUERY_FAILED:
+            roaring_andnot(&index->all, &index->passed, scratch);
+            return scratch;
+
+        case QUERY_GRADE:
+            if (query->grade < 0 || query->grade >= BITMAP_GRADE_COUNT) return NULL;
+            return &index->grades[query->grade];
+
+        case QUERY_ENROLLED: {
+            const RoaringBitmap *members = bitmap_index_course(index, query->course_name);
+            return members ? members : &empty_bitmap;
+        }
+
+        case QUERY_MARKS_BELOW:
+        case QUERY_GPA_BELOW:
+            evaluate_below(db, query->op == QUERY_GPA_BELOW, query->value, scratch);
+            return scratch;
+
+        case QUERY_MARKS_AT_LEAST:
+        case QUERY_GPA_AT_LEAST: {
+            RoaringBitmap below;
+            roaring_init(&below);
+            evaluate_below(db, query->op == QUERY_GPA_AT_LEAST, query->value, &below);
+            roaring_andnot(&index->all, &below, scratch);
+            roaring_free(&below);
+            return scratch;
+        }
+
+        case QUERY_AND:
+        case QUERY_OR: {
+            RoaringBitmap left_scratch, right_scratch;
+            roaring_init(&left_scratch);
+            roaring_init(&right_scratch);
+
+            const RoaringBitmap *left = evaluate_node(db, query->left, &left_scratch);
+            const RoaringBitmap *right = evaluate_node(db, query->right, &right_scratch);
+            if (left && right) {
+                if (query->op == QUERY_AND) {
+                    roaring_and(left, right, scratch);
+                } else {
+                    roaring_or(left, right, scratch);
+                }
+            }
+
+            roaring_free(&left_scratch);
+            roaring_free(&right_scratch);
+            return (left && right) ? scratch : NULL;
+        }
+
+        case QUERY_NOT: {
+            RoaringBitmap operand_scratch;
+            roaring_init(&operand_scratch);
+
+            const RoaringBitmap *operand = evaluate_node(db, query->left, &operand_scratch);
+            if (operand) {
+                roaring_andnot(&index->all, operand, scratch);
+            }
+
+            roaring_free(&operand_scratch);
+            return operand ? scratch : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Evaluate a compound query over the bitmap index
+ * @param db Student database
+ * @param query Root of the query expression
+ * @param result Initialized bitmap receiving the matching roll numbers
+ * @return false if the query is malformed
+ */
+bool evaluate_student_query(StudentDatabase *db, const StudentQuery *query, RoaringBitmap *result) {
+    if (!db || !query || !result) return false;
+
+    RoaringBitmap scratch;
+    roaring_init(&scratch);
+
+    const RoaringBitmap *matches = evaluate_node(db, query, &scratch);
+    if (matches == &scratch) {
+        // Hand over the scratch containers instead of copying them
+        roaring_free(result);
+        *result = scratch;
+        return true;
+    }
+
+    if (matches) {
+        roaring_copy(result, matches);
+    }
+    roaring_free(&scratch);
+    return matches != NULL;
+}
+
+/**
+ * Check a single student against a query without the index.
+ * Matches the StudentFilterFunc signature so queries can be passed to
+ * filter_students, which switches to the bitmap path for this filter.
+ * @param student Student to check
+ * @param criteria Pointer to the StudentQuery root
+ * @return true if the student satisfies the query
+ */
+bool student_matches_query(Student *student, void *criteria) {
+    const StudentQuery *query = (const StudentQuery*)criteria;
+    if (!student || !query) return false;
+
+    switch (query->op) {
+        case QUERY_PASSED:        return student->marks >= PASSING_MARKS;
+        case QUERY_FAILED:        return student->marks < PASSING_MARKS;
+        case QUERY_GRADE:         return grade_index_for_marks(student->marks) == query->grade;
+        case QUERY_ENROLLED:      return find_course_in_student(student, query->course_name) != NULL;
+        case QUERY_MARKS_BELOW:   return student->marks < query->value;
+        case QUERY_MARKS_AT_LEAST: return !(student->marks < query->value);
+        case QUERY_GPA_BELOW:     return student->gpa < query->value;
+        case QUERY_GPA_AT_LEAST:  return !(student->gpa < query->value);
+        case QUERY_AND:
+            return student_matches_query(student, (void*)query->left) &&
+                   student_matches_query(student, (void*)query->right);
+        case QUERY_OR:
+            return student_matches_query(student, (void*)query->left) ||
+                   student_matches_query(student, (void*)query->right);
+        case QUERY_NOT:
+            return query->left && !student_matches_query(student, (void*)query->left);
+    }
+    return false;
+}
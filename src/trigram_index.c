@@ -0,0 +1,694 @@
+/*
+ * File: src/trigram_index.c
+ * Path: SchoolRecordSystem/src/trigram_index.c
+ * Description: Trigram index for fuzzy (edit-distance) student name matching
+ * Author: Wisdom Chimezie
+ * Date: July 20, 2025
+ * Version: 2.0.0
+ *
+ * Notes:
+ * - Each word of a normalized name is padded ("  w" ... "d ") and split
+ *   into trigrams; an edit destroys at most four of them (three for
+ *   insert/delete/substitute, four for a transposition), so a name within
+ *   distance d shares at least m - 4d of the query's m trigrams
+ * - Candidates come from the 4d + 1 shortest posting lists only; longer
+ *   lists are probed by binary search for those candidates
+ * - Candidates are verified best-first (most shared trigrams first) with a
+ *   banded edit distance whose bound tightens as the top-k fills up, up
+ *   to a fixed verification budget
+ */
+
+#include "trigram_index.h"
+#include "name_index.h"
+#include "memory_manager.h"
+
+#define TRIGRAM_TABLE_INITIAL_CAPACITY 1024
+#define TRIGRAM_COMPACT_MIN 1024         // Dead names tolerated before compaction
+#define TRIGRAM_MAX_PER_NAME NAME_INDEX_KEY_MAX
+#define TRIGRAM_LOSS_PER_EDIT 4          // Trigrams one edit can destroy (a transposition)
+#define TRIGRAM_VERIFY_BUDGET 20000      // Edit-distance checks per search
+
+/* ============================================================================
+ * TRIGRAM EXTRACTION
+ * ============================================================================ */
+
+static uint32_t pack_trigram(unsigned char a, unsigned char b, unsigned char c) {
+    return ((uint32_t)a << 16) | ((uint32_t)b << 8) | (uint32_t)c;
+}
+
+static int compare_trigrams(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Collect the distinct padded word trigrams of a normalized key
+ * @param key Normalized key (single spaces between words)
+ * @param length Key length
+ * @param out Receives up to TRIGRAM_MAX_PER_NAME sorted, distinct trigrams
+ * @return Number of trigrams written
+ */
+static int extract_trigrams(const char *key, size_t length, uint32_t *out) {
+    int count = 0;
+    size_t start = 0;
+
+    while (start < length) {
+        size_t end = start;
+        while (end < length && key[end] != ' ') end++;
+
+        // Padded word: two leading blanks, one trailing blank
+        unsigned char padded[NAME_INDEX_KEY_MAX + 3];
+        size_t padded_length = 0;
+        padded[padded_length++] = ' ';
+        padded[padded_length++] = ' ';
+        for (size_t i = start; i < end; i++) {
+            padded[padded_length++] = (unsigned char)key[i];
+        }
+        padded[padded_length++] = ' ';
+
+        for (size_t i = 0; i + 2 < padded_length && count < TRIGRAM_MAX_PER_NAME; i++) {
+            out[count++] = pack_trigram(padded[i], padded[i + 1], padded[i + 2]);
+        }
+        start = end + 1;
+    }
+
+    qsort(out, (size_t)count, sizeof(uint32_t), compare_trigrams);
+
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || out[unique - 1] != out[i]) {
+            out[unique++] = out[i];
+        }
+    }
+    return unique;
+}
+
+/* ============================================================================
+ * POSTING TABLE
+ * ============================================================================ */
+
+static int trigram_slot(uint32_t key, int capacity) {
+    return (int)((key * 2654435769u) & (uint32_t)(capacity - 1));
+}
+
+/**
+ * Find the posting list of a trigram
+ * @return Posting list or NULL if no name contains the trigram
+ */
+static TrigramPosting* find_posting(const TrigramIndex *index, uint32_t trigram) {
+    if (index->table_capacity == 0) return NULL;
+
+    uint32_t key = trigram + 1;
+    int slot = trigram_slot(key, index->table_capacity);
+    while (index->keys[slot] != 0) {
+        if (index->keys[slot] == key) {
+            return &index->postings[slot];
+        }
+        slot = (slot + 1) & (index->table_capacity - 1);
+    }
+    return NULL;
+}
+
+/**
+ * Double the posting table (or allocate it) and rehash every list
+ */
+static void grow_table(TrigramIndex *index) {
+    int old_capacity = index->table_capacity;
+    uint32_t *old_keys = index->keys;
+    TrigramPosting *old_postings = index->postings;
+
+    int new_capacity = old_capacity > 0 ? old_capacity * 2 : TRIGRAM_TABLE_INITIAL_CAPACITY;
+    index->keys = (uint32_t*)safe_malloc((size_t)new_capacity * sizeof(uint32_t));
+    index->postings = (TrigramPosting*)safe_malloc((size_t)new_capacity * sizeof(TrigramPosting));
+    memset(index->keys, 0, (size_t)new_capacity * sizeof(uint32_t));
+    index->table_capacity = new_capacity;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_keys[i] == 0) continue;
+
+        int slot = trigram_slot(old_keys[i], new_capacity);
+        while (index->keys[slot] != 0) {
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+        index->keys[slot] = old_keys[i];
+        index->postings[slot] = old_postings[i];
+    }
+
+    free(old_keys);
+    free(old_postings);
+}
+
+/**
+ * Find or create the posting list of a trigram
+ */
+static TrigramPosting* posting_for(TrigramIndex *index, uint32_t trigram) {
+    TrigramPosting *posting = find_posting(index, trigram);
+    if (posting) return posting;
+
+    if ((index->table_count + 1) * 2 > index->table_capacity) {
+        grow_table(index);
+    }
+
+    uint32_t key = trigram + 1;
+    int slot = trigram_slot(key, index->table_capacity);
+    while (index->keys[slot] != 0) {
+        slot = (slot + 1) & (index->table_capacity - 1);
+    }
+
+    index->keys[slot] = key;
+    index->postings[slot].ids = NULL;
+    index->postings[slot].count = 0;
+    index->postings[slot].capacity = 0;
+    index->table_count++;
+    return &index->postings[slot];
+}
+
+static void posting_append(TrigramPosting *posting, int id) {
+    if (posting->count >= posting->capacity) {
+        int new_capacity = posting->capacity > 0 ? posting->capacity * 2 : 4;
+        posting->ids = (int*)safe_realloc(posting->ids, (size_t)new_capacity * sizeof(int));
+        posting->capacity = new_capacity;
+    }
+    posting->ids[posting->count++] = id;
+}
+
+/**
+ * Add an entry's trigrams to the posting lists
+ */
+static void post_entry(TrigramIndex *index, int id) {
+    const TrigramEntry *entry = &index->entries[id];
+    uint32_t trigrams[TRIGRAM_MAX_PER_NAME];
+    int count = extract_trigrams(index->text + entry->offset, entry->length, trigrams);
+
+    for (int i = 0; i < count; i++) {
+        posting_append(posting_for(index, trigrams[i]), id);
+    }
+}
+
+/* ============================================================================
+ * LIFECYCLE AND MAINTENANCE
+ * ============================================================================ */
+
+/**
+ * Initialize an empty index
+ * @param index Index to initialize
+ */
+void trigram_index_init(TrigramIndex *index) {
+    if (!index) return;
+
+    memset(index, 0, sizeof(*index));
+    roll_index_init(&index->entry_of_roll);
+}
+
+/**
+ * Release all memory held by the index
+ * @param index Index to free
+ */
+void trigram_index_free(TrigramIndex *index) {
+    if (!index) return;
+
+    for (int i = 0; i < index->table_capacity; i++) {
+        if (index->keys[i] != 0) {
+            free(index->postings[i].ids);
+        }
+    }
+    free(index->keys);
+    free(index->postings);
+    free(index->text);
+    free(index->entries);
+    free(index->shared_counts);
+    roll_index_free(&index->entry_of_roll);
+    trigram_index_init(index);
+}
+
+/**
+ * Remove every name, keeping allocated buffers for reuse
+ * @param index Index to clear
+ */
+void trigram_index_clear(TrigramIndex *index) {
+    if (!index) return;
+
+    for (int i = 0; i < index->table_capacity; i++) {
+        if (index->keys[i] != 0) {
+            index->postings[i].count = 0;
+        }
+    }
+    index->text_length = 0;
+    index->entry_count = 0;
+    index->live_count = 0;
+    roll_index_clear(&index->entry_of_roll);
+}
+
+/**
+ * Index a student's name, replacing any name already stored for the roll number
+ * @param index Index to update
+ * @param roll_number Student's roll number
+ * @param name Student's display name
+ * @return true on success
+ */
+bool trigram_index_add(TrigramIndex *index, int roll_number, const char *name) {
+    if (!index || !name || roll_number <= 0) return false;
+
+    trigram_index_remove(index, roll_number);
+
+    char key[NAME_INDEX_KEY_MAX];
+    size_t length = normalize_name_key(name, key, sizeof(key));
+
+    if (index->text_length + length + 1 > index->text_capacity) {
+        size_t new_capacity = index->text_capacity > 0 ? index->text_capacity * 2 : 4096;
+        while (new_capacity < index->text_length + length + 1) {
+            new_capacity *= 2;
+        }
+        index->text = (char*)safe_realloc(index->text, new_capacity);
+        index->text_capacity = new_capacity;
+    }
+
+    if (index->entry_count >= index->entry_capacity) {
+        int old_capacity = index->entry_capacity;
+        int new_capacity = old_capacity > 0 ? old_capacity * 2 : 64;
+        index->entries = (TrigramEntry*)safe_realloc(index->entries,
+                                                     (size_t)new_capacity * sizeof(TrigramEntry));
+        index->shared_counts = (uint16_t*)safe_realloc(index->shared_counts,
+                                                       (size_t)new_capacity * sizeof(uint16_t));
+        memset(index->shared_counts + old_capacity, 0,
+               (size_t)(new_capacity - old_capacity) * sizeof(uint16_t));
+        index->entry_capacity = new_capacity;
+    }
+
+    int id = index->entry_count++;
+    TrigramEntry *entry = &index->entries[id];
+    entry->roll_number = roll_number;
+    entry->offset = (uint32_t)index->text_length;
+    entry->length = (uint16_t)length;
+    entry->live = true;
+
+    memcpy(index->text + index->text_length, key, length + 1);
+    index->text_length += length + 1;
+
+    post_entry(index, id);
+    roll_index_put(&index->entry_of_roll, roll_number, id);
+    index->live_count++;
+    return true;
+}
+
+/**
+ * Drop the name stored for a roll number (no-op if there is none)
+ * @param index Index to update
+ * @param roll_number Student's roll number
+ */
+void trigram_index_remove(TrigramIndex *index, int roll_number) {
+    if (!index) return;
+
+    int id = roll_index_get(&index->entry_of_roll, roll_number);
+    if (id < 0) return;
+
+    index->entries[id].live = false;
+    index->live_count--;
+    roll_index_remove(&index->entry_of_roll, roll_number);
+}
+
+/**
+ * Rebuild the postings without removed names once they outnumber live ones
+ */
+static void compact_if_needed(TrigramIndex *index) {
+    if (index->entry_count - index->live_count <= TRIGRAM_COMPACT_MIN + index->live_count) {
+        return;
+    }
+
+    for (int i = 0; i < index->table_capacity; i++) {
+        if (index->keys[i] != 0) {
+            index->postings[i].count = 0;
+        }
+    }
+    roll_index_clear(&index->entry_of_roll);
+
+    size_t text_length = 0;
+    int count = 0;
+    for (int i = 0; i < index->entry_count; i++) {
+        TrigramEntry entry = index->entries[i];
+        if (!entry.live) continue;
+
+        memmove(index->text + text_length, index->text + entry.offset, (size_t)entry.length + 1);
+        entry.offset = (uint32_t)text_length;
+        index->entries[count] = entry;
+        roll_index_put(&index->entry_of_roll, entry.roll_number, count);
+        post_entry(index, count);
+
+        text_length += (size_t)entry.length + 1;
+        count++;
+    }
+
+    index->text_length = text_length;
+    index->entry_count = count;
+    index->live_count = count;
+}
+
+/* ============================================================================
+ * EDIT DISTANCE
+ * ============================================================================ */
+
+/**
+ * Optimal string alignment distance restricted to the diagonal band
+ * |i - j| <= bound, stopping as soon as a whole row exceeds the bound
+ * @param a First string
+ * @param a_length Length of a (at most NAME_INDEX_KEY_MAX)
+ * @param b Second string
+ * @param b_length Length of b (at most NAME_INDEX_KEY_MAX)
+ * @param bound Largest distance of interest
+ * @return Distance, or bound + 1 if it exceeds the bound
+ */
+int bounded_edit_distance(const char *a, size_t a_length, const char *b, size_t b_length, int bound) {
+    if (bound < 0) return 0;
+
+    int over = bound + 1;
+    int gap = (int)a_length - (int)b_length;
+    if (gap > bound || -gap > bound) return over;
+    if (a_length >= NAME_INDEX_KEY_MAX || b_length >= NAME_INDEX_KEY_MAX) return over;
+
+    int rows[3][NAME_INDEX_KEY_MAX + 1];
+    int *before = rows[0], *previous = rows[1], *current = rows[2];
+    int n = (int)b_length;
+
+    for (int j = 0; j <= n; j++) {
+        previous[j] = (j <= bound) ? j : over;
+        before[j] = over;
+        current[j] = over;
+    }
+
+    for (int i = 1; i <= (int)a_length; i++) {
+        int lo = (i - bound > 1) ? i - bound : 1;
+        int hi = (i + bound < n) ? i + bound : n;
+
+        current[lo - 1] = (lo == 1 && i <= bound) ? i : over;
+        if (hi < n) current[hi + 1] = over;
+
+        int row_min = current[lo - 1];
+        for (int j = lo; j <= hi; j++) {
+            int cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            int value = previous[j - 1] + cost;
+            if (previous[j] + 1 < value) value = previous[j] + 1;
+            if (current[j - 1] + 1 < value) value = current[j - 1] + 1;
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] &&
+                before[j - 2] + 1 < value) {
+                value = before[j - 2] + 1;
+            }
+            if (value > over) value = over;
+
+            current[j] = value;
+            if (value < row_min) row_min = value;
+        }
+
+        if (row_min > bound) return over;
+
+        int *recycled = before;
+        before = previous;
+        previous = current;
+        current = recycled;
+    }
+
+    return previous[n] < over ? previous[n] : over;
+}
+
+/**
+ * Distance between a query and a name: the whole name, or the closest run
+ * of as many consecutive words as the query has (so "jon" matches "John Smith")
+ */
+static int name_distance(const char *query, size_t query_length, int query_words,
+                         const char *name, size_t name_length, int bound) {
+    int best = bounded_edit_distance(query, query_length, name, name_length, bound);
+
+    // Word starts of the name
+    size_t starts[NAME_INDEX_KEY_MAX];
+    int words = 0;
+    for (size_t i = 0; i < name_length; i++) {
+        if (i == 0 || name[i - 1] == ' ') {
+            starts[words++] = i;
+        }
+    }
+
+    for (int w = 0; w + query_words <= words && query_words < words && best > 0; w++) {
+        int last = w + query_words;
+        size_t end = (last < words) ? starts[last] - 1 : name_length;
+        int limit = (best - 1 < bound) ? best - 1 : bound;
+        int distance = bounded_edit_distance(query, query_length, name + starts[w], end - starts[w], limit);
+        if (distance <= limit) {
+            best = distance;
+        }
+    }
+
+    return best;
+}
+
+/* ============================================================================
+ * SEARCH
+ * ============================================================================ */
+
+/**
+ * Default edit distance for a query: 1 up to four characters, 2 up to
+ * eight, 3 beyond
+ * @param query Raw query text
+ * @return Suggested maximum distance
+ */
+int trigram_default_distance(const char *query) {
+    char key[NAME_INDEX_KEY_MAX];
+    size_t length = normalize_name_key(query, key, sizeof(key));
+
+    if (length <= 4) return 1;
+    if (length <= 8) return 2;
+    return 3;
+}
+
+static int compare_posting_sizes(const void *a, const void *b) {
+    const TrigramPosting *x = *(const TrigramPosting* const*)a;
+    const TrigramPosting *y = *(const TrigramPosting* const*)b;
+    return (x->count > y->count) - (x->count < y->count);
+}
+
+static bool posting_contains(const TrigramPosting *posting, int id) {
+    int lo = 0, hi = posting->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (posting->ids[mid] < id) lo = mid + 1; else hi = mid;
+    }
+    return lo < posting->count && posting->ids[lo] == id;
+}
+
+// A verified candidate in the running top-k
+typedef struct {
+    int id;
+    int distance;
+    int length_gap;
+} RankedName;
+
+// Normalized query and its posting lists, shortest first
+typedef struct {
+    char key[NAME_INDEX_KEY_MAX];
+    size_t key_length;
+    int words;
+    int trigram_count;
+    TrigramPosting *lists[TRIGRAM_MAX_PER_NAME];
+} FuzzyQuery;
+
+static bool ranks_before(const RankedName *a, const RankedName *b, const TrigramIndex *index) {
+    if (a->distance != b->distance) return a->distance < b->distance;
+    if (a->length_gap != b->length_gap) return a->length_gap < b->length_gap;
+    return index->entries[a->id].roll_number < index->entries[b->id].roll_number;
+}
+
+/**
+ * One filter-and-verify pass at a fixed distance bound
+ * @param index Index to search
+ * @param query Prepared query
+ * @param bound Largest distance accepted in this pass
+ * @param top Receives up to k ranked matches, best first
+ * @param k Capacity of top
+ * @return Number of matches in top
+ */
+static int search_pass(TrigramIndex *index, const FuzzyQuery *query, int bound,
+                       RankedName *top, int k) {
+    int m = query->trigram_count;
+    TrigramPosting *const *lists = query->lists;
+
+    // A match within 'bound' shares at least m - 4 * bound trigrams, so it
+    // must appear in one of the first m - threshold + 1 lists
+    int threshold = m - TRIGRAM_LOSS_PER_EDIT * bound;
+    if (threshold < 1) threshold = 1;
+    int probe_lists = m - threshold + 1;
+
+    size_t candidate_space = 0;
+    for (int i = 0; i < probe_lists; i++) {
+        candidate_space += (size_t)lists[i]->count;
+    }
+    int *candidates = (int*)safe_malloc((candidate_space > 0 ? candidate_space : 1) * sizeof(int));
+    int candidate_count = 0;
+
+    uint16_t *shared = index->shared_counts;
+    for (int i = 0; i < probe_lists; i++) {
+        for (int p = 0; p < lists[i]->count; p++) {
+            int id = lists[i]->ids[p];
+            if (shared[id]++ == 0) {
+                candidates[candidate_count++] = id;
+            }
+        }
+    }
+
+    // Complete the counts from the long lists: scan a list against the
+    // counters when that is cheaper than a binary search per candidate
+    bool scanned[TRIGRAM_MAX_PER_NAME];
+    for (int i = probe_lists; i < m; i++) {
+        const TrigramPosting *list = lists[i];
+        int log_length = 32 - __builtin_clz((unsigned)list->count | 1u);
+        scanned[i] = (size_t)candidate_count * (size_t)log_length >= (size_t)list->count;
+        if (!scanned[i]) continue;
+
+        for (int p = 0; p < list->count; p++) {
+            int id = list->ids[p];
+            if (shared[id] != 0) shared[id]++;
+        }
+    }
+
+    // Bucket survivors by shared count
+    int *bucket_sizes = (int*)safe_malloc((size_t)(m + 2) * sizeof(int));
+    memset(bucket_sizes, 0, (size_t)(m + 2) * sizeof(int));
+    int survivors = 0;
+    for (int c = 0; c < candidate_count; c++) {
+        int id = candidates[c];
+        int count = shared[id];
+        for (int i = probe_lists; i < m; i++) {
+            if (!scanned[i] && posting_contains(lists[i], id)) count++;
+        }
+        shared[id] = 0;
+
+        if (count >= threshold && index->entries[id].live) {
+            candidates[survivors++] = id;
+            shared[id] = (uint16_t)count;
+            bucket_sizes[count]++;
+        }
+    }
+
+    // Order survivors by shared count, most first
+    int *ordered = (int*)safe_malloc((survivors > 0 ? (size_t)survivors : 1) * sizeof(int));
+    int *bucket_next = (int*)safe_malloc((size_t)(m + 2) * sizeof(int));
+    for (int count = m, position = 0; count >= 0; count--) {
+        bucket_next[count] = position;
+        position += bucket_sizes[count];
+    }
+    for (int c = 0; c < survivors; c++) {
+        int id = candidates[c];
+        ordered[bucket_next[shared[id]]++] = id;
+    }
+
+    // Verify best-first, tightening the bound once k matches are held. The
+    // budget keeps latency flat for very common trigrams; what it drops are
+    // the candidates sharing the fewest trigrams with the query.
+    int top_count = 0;
+    int verified = 0;
+
+    for (int c = 0; c < survivors; c++) {
+        int id = ordered[c];
+        int count = shared[id];
+        shared[id] = 0;
+
+        if (verified >= TRIGRAM_VERIFY_BUDGET) {
+            continue;
+        }
+
+        // Fewer shared trigrams imply a larger minimum distance
+        int floor_distance = (m - count + TRIGRAM_LOSS_PER_EDIT - 1) / TRIGRAM_LOSS_PER_EDIT;
+        if (floor_distance > bound) {
+            continue;
+        }
+
+        const TrigramEntry *entry = &index->entries[id];
+        verified++;
+        int distance = name_distance(query->key, query->key_length, query->words,
+                                     index->text + entry->offset, entry->length, bound);
+        if (distance > bound) continue;
+
+        int gap = (int)entry->length - (int)query->key_length;
+        RankedName ranked = {id, distance, gap < 0 ? -gap : gap};
+        if (top_count == k && !ranks_before(&ranked, &top[k - 1], index)) {
+            continue;
+        }
+
+        int position = (top_count < k) ? top_count++ : k - 1;
+        while (position > 0 && ranks_before(&ranked, &top[position - 1], index)) {
+            top[position] = top[position - 1];
+            position--;
+        }
+        top[position] = ranked;
+
+        if (top_count == k) {
+            bound = top[k - 1].distance;
+        }
+    }
+
+    free(bucket_next);
+    free(ordered);
+    free(bucket_sizes);
+    free(candidates);
+    return top_count;
+}
+
+/**
+ * Find the k names closest to a query. Passes run with growing distance
+ * bounds (stricter bounds probe fewer, shorter posting lists) and stop
+ * once k matches are held. Names sharing no trigram with the query are
+ * never returned.
+ * @param index Index to search
+ * @param query Raw query text (normalized like the names)
+ * @param max_distance Largest edit distance accepted (negative = default
+ *                     for the query length, capped at TRIGRAM_MAX_DISTANCE)
+ * @param results Caller-provided array of k matches, best first
+ * @param k Maximum number of matches
+ * @return Number of matches written
+ */
+int trigram_index_search(TrigramIndex *index, const char *query, int max_distance,
+                         TrigramMatch *results, int k) {
+    if (!index || !query || !results || k <= 0) return 0;
+
+    FuzzyQuery prepared;
+    prepared.key_length = normalize_name_key(query, prepared.key, sizeof(prepared.key));
+    if (prepared.key_length == 0 || prepared.key_length + 1 >= sizeof(prepared.key)) return 0;
+
+    int bound = (max_distance < 0) ? trigram_default_distance(query) : max_distance;
+    if (bound > TRIGRAM_MAX_DISTANCE) bound = TRIGRAM_MAX_DISTANCE;
+
+    compact_if_needed(index);
+
+    prepared.words = 1;
+    for (size_t i = 0; i < prepared.key_length; i++) {
+        if (prepared.key[i] == ' ') prepared.words++;
+    }
+
+    uint32_t trigrams[TRIGRAM_MAX_PER_NAME];
+    static TrigramPosting empty = {NULL, 0, 0};
+    prepared.trigram_count = extract_trigrams(prepared.key, prepared.key_length, trigrams);
+    for (int i = 0; i < prepared.trigram_count; i++) {
+        TrigramPosting *posting = find_posting(index, trigrams[i]);
+        prepared.lists[i] = posting ? posting : &empty;
+    }
+    qsort(prepared.lists, (size_t)prepared.trigram_count, sizeof(TrigramPosting*), compare_posting_sizes);
+
+    RankedName *top = (RankedName*)safe_malloc((size_t)k * sizeof(RankedName));
+    int top_count = 0;
+
+    for (int pass = (bound < 1) ? bound : 1; ; pass++) {
+        // Once the filter admits every list, larger bounds gain nothing cheaper
+        if (prepared.trigram_count - TRIGRAM_LOSS_PER_EDIT * pass < 1) {
+            pass = bound;
+        }
+
+        top_count = search_pass(index, &prepared, pass, top, k);
+        if (top_count == k || pass >= bound) break;
+    }
+
+    for (int i = 0; i < top_count; i++) {
+        results[i].roll_number = index->entries[top[i].id].roll_number;
+        results[i].distance = top[i].distance;
+    }
+
+    free(top);
+    return top_count;
+}